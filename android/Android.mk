@@ -61,6 +61,7 @@ $(shell cp -f $(LOCAL_PATH)/../common/JackPort.cpp                  $(LOCAL_PATH
 $(shell cp -f $(LOCAL_PATH)/../common/JackPortType.cpp              $(LOCAL_PATH)/$(common_libsource_server_dir)/JackPortType.cpp)
 $(shell cp -f $(LOCAL_PATH)/../common/JackAudioPort.cpp             $(LOCAL_PATH)/$(common_libsource_server_dir)/JackAudioPort.cpp)
 $(shell cp -f $(LOCAL_PATH)/../common/JackMidiPort.cpp              $(LOCAL_PATH)/$(common_libsource_server_dir)/JackMidiPort.cpp)
+$(shell cp -f $(LOCAL_PATH)/../common/JackControlPort.cpp           $(LOCAL_PATH)/$(common_libsource_server_dir)/JackControlPort.cpp)
 $(shell cp -f $(LOCAL_PATH)/../common/JackMidiAPI.cpp               $(LOCAL_PATH)/$(common_libsource_server_dir)/JackMidiAPI.cpp)
 $(shell cp -f $(LOCAL_PATH)/../common/JackEngineControl.cpp         $(LOCAL_PATH)/$(common_libsource_server_dir)/JackEngineControl.cpp)
 $(shell cp -f $(LOCAL_PATH)/../common/JackShmMem.cpp                $(LOCAL_PATH)/$(common_libsource_server_dir)/JackShmMem.cpp)
@@ -92,6 +93,7 @@ $(shell cp -f $(LOCAL_PATH)/../common/JackPort.cpp                  $(LOCAL_PATH
 $(shell cp -f $(LOCAL_PATH)/../common/JackPortType.cpp              $(LOCAL_PATH)/$(common_libsource_client_dir)/JackPortType.cpp)
 $(shell cp -f $(LOCAL_PATH)/../common/JackAudioPort.cpp             $(LOCAL_PATH)/$(common_libsource_client_dir)/JackAudioPort.cpp)
 $(shell cp -f $(LOCAL_PATH)/../common/JackMidiPort.cpp              $(LOCAL_PATH)/$(common_libsource_client_dir)/JackMidiPort.cpp)
+$(shell cp -f $(LOCAL_PATH)/../common/JackControlPort.cpp           $(LOCAL_PATH)/$(common_libsource_client_dir)/JackControlPort.cpp)
 $(shell cp -f $(LOCAL_PATH)/../common/JackMidiAPI.cpp               $(LOCAL_PATH)/$(common_libsource_client_dir)/JackMidiAPI.cpp)
 $(shell cp -f $(LOCAL_PATH)/../common/JackEngineControl.cpp         $(LOCAL_PATH)/$(common_libsource_client_dir)/JackEngineControl.cpp)
 $(shell cp -f $(LOCAL_PATH)/../common/JackShmMem.cpp                $(LOCAL_PATH)/$(common_libsource_client_dir)/JackShmMem.cpp)
@@ -124,6 +126,7 @@ common_libsource_server := \
     $(common_libsource_server_dir)/JackPortType.cpp \
     $(common_libsource_server_dir)/JackAudioPort.cpp \
     $(common_libsource_server_dir)/JackMidiPort.cpp \
+    $(common_libsource_server_dir)/JackControlPort.cpp \
     $(common_libsource_server_dir)/JackMidiAPI.cpp \
     $(common_libsource_server_dir)/JackEngineControl.cpp \
     $(common_libsource_server_dir)/JackShmMem.cpp \
@@ -156,6 +159,7 @@ common_libsource_client := \
     $(common_libsource_client_dir)/JackPortType.cpp \
     $(common_libsource_client_dir)/JackAudioPort.cpp \
     $(common_libsource_client_dir)/JackMidiPort.cpp \
+    $(common_libsource_client_dir)/JackControlPort.cpp \
     $(common_libsource_client_dir)/JackMidiAPI.cpp \
     $(common_libsource_client_dir)/JackEngineControl.cpp \
     $(common_libsource_client_dir)/JackShmMem.cpp \
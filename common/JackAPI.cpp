@@ -92,6 +92,9 @@ extern "C"
     LIB_EXPORT int jack_set_buffer_size_callback(jack_client_t *client,
             JackBufferSizeCallback bufsize_callback,
             void *arg);
+    LIB_EXPORT int jack_set_buffer_size_prepare_callback(jack_client_t *client,
+            JackBufferSizeCallback prepare_callback,
+            void *arg);
     LIB_EXPORT int jack_set_sample_rate_callback(jack_client_t *client,
             JackSampleRateCallback srate_callback,
             void *arg);
@@ -117,11 +120,20 @@ extern "C"
 
     LIB_EXPORT int jack_activate(jack_client_t *client);
     LIB_EXPORT int jack_deactivate(jack_client_t *client);
+    LIB_EXPORT int jack_set_pipelined(jack_client_t *client, int onoff);
+LIB_EXPORT int jack_set_block_multiplier(jack_client_t *client, int multiplier);
     LIB_EXPORT jack_port_t * jack_port_register(jack_client_t *client,
             const char* port_name,
             const char* port_type,
             unsigned long flags,
             unsigned long buffer_size);
+    LIB_EXPORT int jack_port_register_many(jack_client_t *client,
+            const char** port_names,
+            const char* port_type,
+            unsigned long flags,
+            unsigned long buffer_size,
+            jack_port_t** ports,
+            unsigned int count);
     LIB_EXPORT int jack_port_unregister(jack_client_t *, jack_port_t *);
     LIB_EXPORT void * jack_port_get_buffer(jack_port_t *, jack_nframes_t);
     LIB_EXPORT jack_uuid_t  jack_port_uuid(const jack_port_t*);
@@ -162,6 +174,11 @@ extern "C"
             const char* port_name, int onoff);
     LIB_EXPORT int jack_port_ensure_monitor(jack_port_t *port, int onoff);
     LIB_EXPORT int jack_port_monitoring_input(jack_port_t *port);
+    LIB_EXPORT int jack_port_set_metering(jack_port_t *port, int onoff);
+    LIB_EXPORT int jack_port_get_meter(jack_port_t *port, jack_default_audio_sample_t* peak, jack_default_audio_sample_t* rms);
+    LIB_EXPORT int jack_connection_set_gain(jack_port_t *source, jack_port_t *destination, float gain);
+    LIB_EXPORT int jack_connection_set_mute(jack_port_t *source, jack_port_t *destination, int onoff);
+    LIB_EXPORT int jack_connection_get_gain(jack_port_t *source, jack_port_t *destination, float* gain, int* mute);
     LIB_EXPORT int jack_connect(jack_client_t *,
                              const char* source_port,
                              const char* destination_port);
@@ -172,6 +189,8 @@ extern "C"
     LIB_EXPORT int jack_port_name_size(void);
     LIB_EXPORT int jack_port_type_size(void);
     LIB_EXPORT size_t jack_port_type_get_buffer_size(jack_client_t *client, const char* port_type);
+    LIB_EXPORT int jack_port_type_register(jack_client_t *client, const char* port_type, size_t buffer_size,
+                                           JackPortTypeInitCallback init, JackPortTypeMixdownCallback mixdown);
     LIB_EXPORT jack_nframes_t jack_get_sample_rate(jack_client_t *);
     LIB_EXPORT jack_nframes_t jack_get_buffer_size(jack_client_t *);
     LIB_EXPORT const char* * jack_get_ports(jack_client_t *,
@@ -201,6 +220,17 @@ extern "C"
     LIB_EXPORT float jack_get_max_delayed_usecs(jack_client_t *client);
     LIB_EXPORT float jack_get_xrun_delayed_usecs(jack_client_t *client);
     LIB_EXPORT void jack_reset_max_delayed_usecs(jack_client_t *client);
+    LIB_EXPORT int jack_get_cycle_histogram(jack_client_t *client,
+            jack_cycle_histogram_t type,
+            const char *client_name,
+            jack_time_t *upper_bounds,
+            uint32_t *counts,
+            int size);
+    LIB_EXPORT float jack_get_cycle_percentile(jack_client_t *client,
+            jack_cycle_histogram_t type,
+            const char *client_name,
+            float percentile);
+    LIB_EXPORT void jack_reset_cycle_histograms(jack_client_t *client);
 
     LIB_EXPORT int jack_release_timebase(jack_client_t *client);
     LIB_EXPORT int jack_set_sync_callback(jack_client_t *client,
@@ -355,7 +385,9 @@ LIB_EXPORT void* jack_port_get_buffer(jack_port_t* port, jack_nframes_t frames)
         return NULL;
     } else {
         JackGraphManager* manager = GetGraphManager();
-        return (manager ? manager->GetBuffer(myport, frames) : NULL);
+        // Only the RT thread of a client, while running its cycle, keeps the resolved buffer for the cycle
+        JackClient* client = (JackClient*)jack_tls_get(JackGlobals::fRealTimeThread);
+        return (manager ? manager->GetBuffer(myport, frames, client && client->IsInCycle()) : NULL);
     }
 }
 
@@ -781,6 +813,96 @@ LIB_EXPORT int jack_port_monitoring_input(jack_port_t* port)
     }
 }
 
+LIB_EXPORT int jack_port_set_metering(jack_port_t* port, int onoff)
+{
+    JackGlobals::CheckContext("jack_port_set_metering");
+
+    uintptr_t port_aux = (uintptr_t)port;
+    jack_port_id_t myport = (jack_port_id_t)port_aux;
+    if (!CheckPort(myport)) {
+        jack_error("jack_port_set_metering called with an incorrect port %ld", myport);
+        return -1;
+    } else {
+        JackGraphManager* manager = GetGraphManager();
+        return (manager ? manager->SetMetering(myport, onoff) : -1);
+    }
+}
+
+LIB_EXPORT int jack_port_get_meter(jack_port_t* port, jack_default_audio_sample_t* peak, jack_default_audio_sample_t* rms)
+{
+    JackGlobals::CheckContext("jack_port_get_meter");
+
+    uintptr_t port_aux = (uintptr_t)port;
+    jack_port_id_t myport = (jack_port_id_t)port_aux;
+    if (!CheckPort(myport)) {
+        jack_error("jack_port_get_meter called with an incorrect port %ld", myport);
+        return -1;
+    } else if (peak == NULL || rms == NULL) {
+        jack_error("jack_port_get_meter called with a NULL pointer");
+        return -1;
+    } else {
+        JackGraphManager* manager = GetGraphManager();
+        return (manager ? manager->GetMeter(myport, peak, rms) : -1);
+    }
+}
+
+LIB_EXPORT int jack_connection_set_gain(jack_port_t* source, jack_port_t* destination, float gain)
+{
+    JackGlobals::CheckContext("jack_connection_set_gain");
+
+    uintptr_t src_aux = (uintptr_t)source;
+    jack_port_id_t src = (jack_port_id_t)src_aux;
+    uintptr_t dst_aux = (uintptr_t)destination;
+    jack_port_id_t dst = (jack_port_id_t)dst_aux;
+    if (!CheckPort(src) || !CheckPort(dst)) {
+        jack_error("jack_connection_set_gain called with an incorrect port %ld %ld", src, dst);
+        return -1;
+    } else if (!(gain >= 0.f)) {
+        jack_error("jack_connection_set_gain called with an incorrect gain %f", gain);
+        return -1;
+    } else {
+        JackGraphManager* manager = GetGraphManager();
+        return (manager ? manager->SetConnectionGain(src, dst, gain, -1) : -1);
+    }
+}
+
+LIB_EXPORT int jack_connection_set_mute(jack_port_t* source, jack_port_t* destination, int onoff)
+{
+    JackGlobals::CheckContext("jack_connection_set_mute");
+
+    uintptr_t src_aux = (uintptr_t)source;
+    jack_port_id_t src = (jack_port_id_t)src_aux;
+    uintptr_t dst_aux = (uintptr_t)destination;
+    jack_port_id_t dst = (jack_port_id_t)dst_aux;
+    if (!CheckPort(src) || !CheckPort(dst)) {
+        jack_error("jack_connection_set_mute called with an incorrect port %ld %ld", src, dst);
+        return -1;
+    } else {
+        JackGraphManager* manager = GetGraphManager();
+        return (manager ? manager->SetConnectionGain(src, dst, -1.f, (onoff) ? 1 : 0) : -1);
+    }
+}
+
+LIB_EXPORT int jack_connection_get_gain(jack_port_t* source, jack_port_t* destination, float* gain, int* mute)
+{
+    JackGlobals::CheckContext("jack_connection_get_gain");
+
+    uintptr_t src_aux = (uintptr_t)source;
+    jack_port_id_t src = (jack_port_id_t)src_aux;
+    uintptr_t dst_aux = (uintptr_t)destination;
+    jack_port_id_t dst = (jack_port_id_t)dst_aux;
+    if (!CheckPort(src) || !CheckPort(dst)) {
+        jack_error("jack_connection_get_gain called with an incorrect port %ld %ld", src, dst);
+        return -1;
+    } else if (gain == NULL || mute == NULL) {
+        jack_error("jack_connection_get_gain called with a NULL pointer");
+        return -1;
+    } else {
+        JackGraphManager* manager = GetGraphManager();
+        return (manager ? manager->GetConnectionGain(src, dst, gain, mute) : -1);
+    }
+}
+
 LIB_EXPORT int jack_is_realtime(jack_client_t* ext_client)
 {
     JackGlobals::CheckContext("jack_is_realtime");
@@ -938,6 +1060,19 @@ LIB_EXPORT int jack_set_buffer_size_callback(jack_client_t* ext_client, JackBuff
     }
 }
 
+LIB_EXPORT int jack_set_buffer_size_prepare_callback(jack_client_t* ext_client, JackBufferSizeCallback prepare_callback, void* arg)
+{
+    JackGlobals::CheckContext("jack_set_buffer_size_prepare_callback");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_set_buffer_size_prepare_callback called with a NULL client");
+        return -1;
+    } else {
+        return client->SetBufferSizePrepareCallback(prepare_callback, arg);
+    }
+}
+
 LIB_EXPORT int jack_set_sample_rate_callback(jack_client_t* ext_client, JackSampleRateCallback srate_callback, void* arg)
 {
     JackGlobals::CheckContext("jack_set_sample_rate_callback");
@@ -1083,6 +1218,32 @@ LIB_EXPORT int jack_deactivate(jack_client_t* ext_client)
     }
 }
 
+LIB_EXPORT int jack_set_pipelined(jack_client_t* ext_client, int onoff)
+{
+    JackGlobals::CheckContext("jack_set_pipelined");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_set_pipelined called with a NULL client");
+        return -1;
+    } else {
+        return client->SetPipelined(onoff);
+    }
+}
+
+LIB_EXPORT int jack_set_block_multiplier(jack_client_t* ext_client, int multiplier)
+{
+    JackGlobals::CheckContext("jack_set_block_multiplier");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_set_block_multiplier called with a NULL client");
+        return -1;
+    } else {
+        return client->SetBlockMultiplier(multiplier);
+    }
+}
+
 LIB_EXPORT jack_port_t* jack_port_register(jack_client_t* ext_client, const char* port_name, const char* port_type, unsigned long flags, unsigned long buffer_size)
 {
     JackGlobals::CheckContext("jack_port_register");
@@ -1099,6 +1260,31 @@ LIB_EXPORT jack_port_t* jack_port_register(jack_client_t* ext_client, const char
     }
 }
 
+LIB_EXPORT int jack_port_register_many(jack_client_t* ext_client, const char** port_names, const char* port_type, unsigned long flags, unsigned long buffer_size, jack_port_t** ports, unsigned int count)
+{
+    JackGlobals::CheckContext("jack_port_register_many");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_port_register_many called with a NULL client");
+        return -1;
+    } else if ((port_names == NULL) || (port_type == NULL) || (ports == NULL)) {
+        jack_error("jack_port_register_many called with NULL port names, a NULL port_type or a NULL ports array");
+        return -1;
+    } else {
+        jack_port_id_t port_indexes[PORT_NUM_FOR_CLIENT];
+        if (count > PORT_NUM_FOR_CLIENT) {
+            jack_error("jack_port_register_many called with too many ports = %u", count);
+            return -1;
+        }
+        int res = client->PortRegisterMany(port_names, count, port_type, flags, buffer_size, port_indexes);
+        for (unsigned int i = 0; i < count; i++) {
+            ports[i] = (res == 0) ? (jack_port_t *)((uintptr_t)port_indexes[i]) : NULL;
+        }
+        return res;
+    }
+}
+
 LIB_EXPORT int jack_port_unregister(jack_client_t* ext_client, jack_port_t* port)
 {
     JackGlobals::CheckContext("jack_port_unregister");
@@ -1193,7 +1379,7 @@ LIB_EXPORT jack_nframes_t jack_port_get_total_latency(jack_client_t* ext_client,
         WaitGraphChange();
         JackGraphManager* manager = GetGraphManager();
         if (manager) {
-            manager->ComputeTotalLatency(myport);
+            // Computed by the server for all ports at each graph change, or by jack_recompute_total_latenc(y|ies)
             return manager->GetPort(myport)->GetTotalLatency();
         } else {
             return 0;
@@ -1497,15 +1683,35 @@ LIB_EXPORT size_t jack_port_type_get_buffer_size(jack_client_t* ext_client, cons
         return 0;
     } else {
         jack_port_type_id_t port_id = GetPortTypeId(port_type);
-        if (port_id == PORT_TYPES_MAX) {
+        if (port_id != PORT_TYPES_MAX) {
+            return GetPortType(port_id)->size();
+        } else if (GetRegisteredPortTypeSize(port_type) > 0) {
+            // Registered, but no port of this type yet
+            return GetRegisteredPortTypeSize(port_type);
+        } else {
             jack_error("jack_port_type_get_buffer_size called with an unknown port type = %s", port_type);
             return 0;
-        } else {
-            return GetPortType(port_id)->size();
         }
     }
 }
 
+LIB_EXPORT int jack_port_type_register(jack_client_t* ext_client, const char* port_type, size_t buffer_size,
+                                       JackPortTypeInitCallback init, JackPortTypeMixdownCallback mixdown)
+{
+    JackGlobals::CheckContext("jack_port_type_register");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_port_type_register called with a NULL client");
+        return -1;
+    } else if (port_type == NULL) {
+        jack_error("jack_port_type_register called with a NULL port type");
+        return -1;
+    } else {
+        return RegisterPortType(port_type, buffer_size, init, mixdown);
+    }
+}
+
 // transport.h
 LIB_EXPORT int jack_release_timebase(jack_client_t* ext_client)
 {
@@ -1698,6 +1904,65 @@ LIB_EXPORT void jack_reset_max_delayed_usecs(jack_client_t* ext_client)
     }
 }
 
+LIB_EXPORT int jack_get_cycle_histogram(jack_client_t* ext_client, jack_cycle_histogram_t type, const char* client_name, jack_time_t* upper_bounds, uint32_t* counts, int size)
+{
+    JackGlobals::CheckContext("jack_get_cycle_histogram");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_get_cycle_histogram called with a NULL client");
+        return -1;
+    }
+    JackEngineControl* control = GetEngineControl();
+    JackTimeHistogram* histogram = (control ? control->GetHistogram(type, client_name) : NULL);
+    if (histogram == NULL) {
+        return -1;
+    }
+    if (size <= 0) {
+        return JACK_HISTOGRAM_BUCKETS;
+    }
+
+    UInt32 buckets[JACK_HISTOGRAM_BUCKETS];
+    jack_time_t max;
+    histogram->Read(buckets, &max);
+    int used = 0;
+    for (int i = 0; i < JACK_HISTOGRAM_BUCKETS && i < size; i++) {
+        upper_bounds[i] = JackTimeHistogram::GetUpperBound(i);
+        counts[i] = buckets[i];
+        if (buckets[i] > 0) {
+            used = i + 1;
+        }
+    }
+    return used;
+}
+
+LIB_EXPORT float jack_get_cycle_percentile(jack_client_t* ext_client, jack_cycle_histogram_t type, const char* client_name, float percentile)
+{
+    JackGlobals::CheckContext("jack_get_cycle_percentile");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_get_cycle_percentile called with a NULL client");
+        return -1.f;
+    }
+    JackEngineControl* control = GetEngineControl();
+    JackTimeHistogram* histogram = (control ? control->GetHistogram(type, client_name) : NULL);
+    return (histogram ? histogram->GetPercentile(percentile) : -1.f);
+}
+
+LIB_EXPORT void jack_reset_cycle_histograms(jack_client_t* ext_client)
+{
+    JackGlobals::CheckContext("jack_reset_cycle_histograms");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_reset_cycle_histograms called with a NULL client");
+    } else {
+        JackEngineControl* control = GetEngineControl();
+        control->ResetHistograms();
+    }
+}
+
 // thread.h
 LIB_EXPORT int jack_client_real_time_priority(jack_client_t* ext_client)
 {
@@ -79,6 +79,16 @@ struct AtomicCounter
 #define CurArrayIndex(e) (CurIndex(e) & 0x0001)
 #define NextArrayIndex(e) ((CurIndex(e) + 1) & 0x0001)
 
+/*!
+\brief Copy of the current state into the next one, a state type can provide a cheaper overload.
+*/
+
+template <class T>
+inline void JackCopyState(T* dst, const T* src)
+{
+    memcpy(dst, src, sizeof(T));
+}
+
 /*!
 \brief A class to handle two states (switching from one to the other) in a lock-free manner
 */
@@ -112,7 +122,7 @@ class JackAtomicState
                 NextIndex(new_val) = CurIndex(new_val); // Invalidate next index
             } while (!CAS(Counter(old_val), Counter(new_val), (UInt32*)&fCounter));
             if (need_copy)
-                memcpy(&fState[next_index], &fState[cur_index], sizeof(T));
+                JackCopyState(&fState[next_index], &fState[cur_index]);
             return next_index;
         }
 
@@ -40,6 +40,15 @@ static void AudioBufferInit(void* buffer, size_t buffer_size, jack_nframes_t)
     memset(buffer, 0, buffer_size);
 }
 
+// Constant, so it lives in read-only memory : a client writing in an unconnected input buffer faults instead of corrupting the others
+static const jack_default_audio_sample_t gSilenceBuffer[BUFFER_SIZE_MAX + 8] = { 0.f };
+
+static const void* AudioBufferSilence()
+{
+    // Aligned like JackPort::GetBuffer
+    return (const jack_default_audio_sample_t*)((uintptr_t)gSilenceBuffer & ~31L) + 8;
+}
+
 static inline void MixAudioBuffer(jack_default_audio_sample_t* mixbuffer, jack_default_audio_sample_t* buffer, jack_nframes_t frames)
 {
 #ifdef __APPLE__
@@ -154,6 +163,173 @@ static void AudioBufferMixdown(void* mixbuffer, void** src_buffers, int src_coun
     }
 }
 
+// Multiplies 'buffer' by a gain going from 'gain' by 'step' per frame, and stores (or adds if 'accumulate') the result in 'mixbuffer'
+static inline void MixAudioBufferGain(jack_default_audio_sample_t* mixbuffer, jack_default_audio_sample_t* buffer,
+                                      jack_default_audio_sample_t gain, jack_default_audio_sample_t step, jack_nframes_t frames, bool accumulate)
+{
+    jack_nframes_t frames_group = frames / 4;
+    frames = frames % 4;
+
+#if defined (__SSE__) && !defined (__sun__)
+    __m128 gain_vec = _mm_setr_ps(gain, gain + step, gain + 2 * step, gain + 3 * step);
+    __m128 step_vec = _mm_set1_ps(4 * step);
+
+    if (accumulate) {
+        while (frames_group > 0) {
+            __m128 vec = _mm_add_ps(_mm_load_ps(mixbuffer), _mm_mul_ps(_mm_load_ps(buffer), gain_vec));
+            _mm_store_ps(mixbuffer, vec);
+            gain_vec = _mm_add_ps(gain_vec, step_vec);
+            mixbuffer += 4;
+            buffer += 4;
+            frames_group--;
+        }
+    } else {
+        while (frames_group > 0) {
+            _mm_store_ps(mixbuffer, _mm_mul_ps(_mm_load_ps(buffer), gain_vec));
+            gain_vec = _mm_add_ps(gain_vec, step_vec);
+            mixbuffer += 4;
+            buffer += 4;
+            frames_group--;
+        }
+    }
+    gain = _mm_cvtss_f32(gain_vec);
+#elif defined (__ARM_NEON__) || defined (__ARM_NEON)
+    const float gain_init[4] = { gain, gain + step, gain + 2 * step, gain + 3 * step };
+    float32x4_t gain_vec = vld1q_f32(gain_init);
+    float32x4_t step_vec = vdupq_n_f32(4 * step);
+
+    if (accumulate) {
+        while (frames_group > 0) {
+            vst1q_f32(mixbuffer, vmlaq_f32(vld1q_f32(mixbuffer), vld1q_f32(buffer), gain_vec));
+            gain_vec = vaddq_f32(gain_vec, step_vec);
+            mixbuffer += 4;
+            buffer += 4;
+            frames_group--;
+        }
+    } else {
+        while (frames_group > 0) {
+            vst1q_f32(mixbuffer, vmulq_f32(vld1q_f32(buffer), gain_vec));
+            gain_vec = vaddq_f32(gain_vec, step_vec);
+            mixbuffer += 4;
+            buffer += 4;
+            frames_group--;
+        }
+    }
+    gain = vgetq_lane_f32(gain_vec, 0);
+#else
+    frames += frames_group * 4;
+#endif
+
+    while (frames > 0) {
+        *mixbuffer = (accumulate) ? (*mixbuffer + *buffer * gain) : (*buffer * gain);
+        gain += step;
+        mixbuffer++;
+        buffer++;
+        frames--;
+    }
+}
+
+static void AudioBufferMixdownGain(void* mixbuffer, void** src_buffers, const jack_default_audio_sample_t* start_gains,
+                                   const jack_default_audio_sample_t* end_gains, int src_count, jack_nframes_t nframes)
+{
+    jack_default_audio_sample_t* target = static_cast<jack_default_audio_sample_t*>(mixbuffer);
+    bool accumulate = false;
+
+    for (int i = 0; i < src_count; ++i) {
+        // Muted connection : nothing to mix
+        if (start_gains[i] == 0.f && end_gains[i] == 0.f) {
+            continue;
+        }
+        jack_default_audio_sample_t step = (end_gains[i] - start_gains[i]) / nframes;
+        MixAudioBufferGain(target, static_cast<jack_default_audio_sample_t*>(src_buffers[i]), start_gains[i], step, nframes, accumulate);
+        accumulate = true;
+    }
+
+    if (!accumulate) {
+        memset(mixbuffer, 0, nframes * sizeof(jack_default_audio_sample_t));
+    }
+}
+
+static void AudioBufferMeter(void* buffer, jack_nframes_t nframes, jack_default_audio_sample_t* peak, jack_default_audio_sample_t* power)
+{
+    jack_default_audio_sample_t* source = static_cast<jack_default_audio_sample_t*>(buffer);
+    jack_default_audio_sample_t max_value = *peak;
+    jack_default_audio_sample_t sum = *power;
+
+#ifdef __APPLE__
+    jack_default_audio_sample_t buffer_max, buffer_sum;
+    vDSP_maxmgv(source, 1, &buffer_max, nframes);
+    vDSP_svesq(source, 1, &buffer_sum, nframes);
+    if (buffer_max > max_value) {
+        max_value = buffer_max;
+    }
+    sum += buffer_sum;
+#else
+    jack_nframes_t frames_group = nframes / 4;
+    jack_nframes_t remaining_frames = nframes % 4;
+
+    #if defined (__SSE__) && !defined (__sun__)
+    const __m128 sign_mask = _mm_set1_ps(-0.f);
+    __m128 max_vec = _mm_setzero_ps();
+    __m128 sum_vec = _mm_setzero_ps();
+
+    while (frames_group > 0) {
+        __m128 vec = _mm_load_ps(source);
+        max_vec = _mm_max_ps(max_vec, _mm_andnot_ps(sign_mask, vec));
+        sum_vec = _mm_add_ps(sum_vec, _mm_mul_ps(vec, vec));
+        source += 4;
+        --frames_group;
+    }
+
+    float max_lanes[4], sum_lanes[4];
+    _mm_storeu_ps(max_lanes, max_vec);
+    _mm_storeu_ps(sum_lanes, sum_vec);
+    for (int i = 0; i < 4; i++) {
+        if (max_lanes[i] > max_value) {
+            max_value = max_lanes[i];
+        }
+        sum += sum_lanes[i];
+    }
+    #elif defined (__ARM_NEON__) || defined (__ARM_NEON)
+    float32x4_t max_vec = vdupq_n_f32(0.f);
+    float32x4_t sum_vec = vdupq_n_f32(0.f);
+
+    while (frames_group > 0) {
+        float32x4_t vec = vld1q_f32(source);
+        max_vec = vmaxq_f32(max_vec, vabsq_f32(vec));
+        sum_vec = vmlaq_f32(sum_vec, vec, vec);
+        source += 4;
+        --frames_group;
+    }
+
+    float max_lanes[4], sum_lanes[4];
+    vst1q_f32(max_lanes, max_vec);
+    vst1q_f32(sum_lanes, sum_vec);
+    for (int i = 0; i < 4; i++) {
+        if (max_lanes[i] > max_value) {
+            max_value = max_lanes[i];
+        }
+        sum += sum_lanes[i];
+    }
+    #else
+    remaining_frames += frames_group * 4;
+    #endif
+
+    while (remaining_frames > 0) {
+        jack_default_audio_sample_t sample = *source++;
+        jack_default_audio_sample_t abs_sample = (sample < 0.f) ? -sample : sample;
+        if (abs_sample > max_value) {
+            max_value = abs_sample;
+        }
+        sum += sample * sample;
+        --remaining_frames;
+    }
+#endif
+
+    *peak = max_value;
+    *power = sum;
+}
+
 static size_t AudioBufferSize()
 {
     return GetEngineControl()->fBufferSize * sizeof(jack_default_audio_sample_t);
@@ -164,7 +340,10 @@ const JackPortType gAudioPortType =
     JACK_DEFAULT_AUDIO_TYPE,
     AudioBufferSize,
     AudioBufferInit,
-    AudioBufferMixdown
+    AudioBufferMixdown,
+    AudioBufferMixdownGain,
+    AudioBufferMeter,
+    AudioBufferSilence
 };
 
 } // namespace Jack
@@ -21,8 +21,12 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #define __JackChannel__
 
 #include "types.h"
+#include "JackConstants.h"
 #include "JackSession.h"
 #include "JackMetadata.h"
+#include "JackError.h"
+#include <stdlib.h>
+#include <string.h>
 
 namespace Jack
 {
@@ -49,6 +53,107 @@ class JackChannelTransactionInterface
         virtual int Read(void* data, int len) = 0;
         virtual int Write(void* data, int len) = 0;
 
+        // Sends what has been written so far, for transactions that buffer their writes
+        virtual int Flush() { return 0; }
+
+};
+
+/*!
+\brief Framed transaction : all fields of a request (or result) are gathered in a single frame, prefixed by its size,
+and moved with a single write on the underlying channel. Receiving starts by the frame size, the fields are then
+read from the channel (which is buffered on sockets and named pipes, so that a whole frame usually costs a single read).
+*/
+
+class JackFramedTransaction : public JackChannelTransactionInterface
+{
+
+    private:
+
+        JackChannelTransactionInterface* fChannel;
+        char fInlineBuffer[JACK_FRAME_INLINE_SIZE];
+        char* fBuffer;
+        int fBufferSize;
+        int fWriteSize;     // Size of the frame being built, header included
+        int fReadLeft;      // Bytes left to read in the frame being received
+
+        int Reserve(int len)
+        {
+            if (fWriteSize + len <= fBufferSize) {
+                return 0;
+            }
+            int size = fBufferSize;
+            while (size < fWriteSize + len) {
+                size *= 2;
+            }
+            char* buffer = (char*)malloc(size);
+            if (!buffer) {
+                jack_error("JackFramedTransaction : cannot allocate frame of %d bytes", size);
+                return -1;
+            }
+            memcpy(buffer, fBuffer, fWriteSize);
+            if (fBuffer != fInlineBuffer) {
+                free(fBuffer);
+            }
+            fBuffer = buffer;
+            fBufferSize = size;
+            return 0;
+        }
+
+    public:
+
+        JackFramedTransaction(JackChannelTransactionInterface* channel)
+            : fChannel(channel), fBuffer(fInlineBuffer), fBufferSize(sizeof(fInlineBuffer)), fWriteSize(sizeof(int)), fReadLeft(0)
+        {}
+        virtual ~JackFramedTransaction()
+        {
+            if (fBuffer != fInlineBuffer) {
+                free(fBuffer);
+            }
+        }
+
+        JackChannelTransactionInterface* GetChannel()
+        {
+            return fChannel;
+        }
+
+        int Read(void* data, int len)
+        {
+            if (fReadLeft == 0) {
+                // A new frame is expected : what has been written so far has to be sent first
+                if (Flush() < 0 || fChannel->Read(&fReadLeft, sizeof(int)) < 0) {
+                    fReadLeft = 0;
+                    return -1;
+                }
+            }
+            if (len > fReadLeft) {
+                jack_error("JackFramedTransaction::Read : read of %d bytes beyond frame end (%d)", len, fReadLeft);
+                return -1;
+            }
+            fReadLeft -= len;
+            return fChannel->Read(data, len);
+        }
+
+        int Write(void* data, int len)
+        {
+            if (Reserve(len) < 0) {
+                return -1;
+            }
+            memcpy(fBuffer + fWriteSize, data, len);
+            fWriteSize += len;
+            return 0;
+        }
+
+        int Flush()
+        {
+            if (fWriteSize == sizeof(int)) {
+                return 0;
+            }
+            int size = fWriteSize - sizeof(int);
+            memcpy(fBuffer, &size, sizeof(int));
+            fWriteSize = sizeof(int);
+            return fChannel->Write(fBuffer, size + sizeof(int));
+        }
+
 };
 
 class JackRequestInterface
@@ -139,6 +244,8 @@ class JackClientChannelInterface
 
         virtual void PortRegister(int refnum, const char* name, const char* type, unsigned int flags, unsigned int buffer_size, jack_port_id_t* port_index, int* result)
         {}
+        virtual void PortRegisterMany(int refnum, const char** names, unsigned int count, const char* type, unsigned int flags, unsigned int buffer_size, jack_port_id_t* port_indexes, int* result)
+        {}
         virtual void PortUnRegister(int refnum, jack_port_id_t port_index, int* result)
         {}
 
@@ -157,7 +264,7 @@ class JackClientChannelInterface
         {}
         virtual void SetFreewheel(int onoff, int* result)
         {}
-        virtual void ComputeTotalLatencies(int* result)
+        virtual void ComputeTotalLatencies(int refnum, int* result)
         {}
 
         virtual void ReleaseTimebase(int refnum, int* result)
@@ -27,10 +27,13 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackTransportEngine.h"
 #include "driver_interface.h"
 #include "JackLibGlobals.h"
+#include "JackTools.h"
+#include "JackPortType.h"
 
 #include <math.h>
 #include <string>
 #include <algorithm>
+#include <vector>
 
 using namespace std;
 
@@ -49,6 +52,7 @@ JackClient::JackClient(JackSynchro* table):fThread(this)
     fInfoShutdown = NULL;
     fInit = NULL;
     fBufferSize = NULL;
+    fBufferSizePrepare = NULL;
     fClientRegistration = NULL;
     fFreewheel = NULL;
     fPortRegistration = NULL;
@@ -68,6 +72,7 @@ JackClient::JackClient(JackSynchro* table):fThread(this)
     fInfoShutdownArg = NULL;
     fInitArg = NULL;
     fBufferSizeArg = NULL;
+    fBufferSizePrepareArg = NULL;
     fFreewheelArg = NULL;
     fClientRegistrationArg = NULL;
     fPortRegistrationArg = NULL;
@@ -81,6 +86,11 @@ JackClient::JackClient(JackSynchro* table):fThread(this)
     fPropertyChangeArg = NULL;
 
     fSessionReply = kPendingSessionReply;
+
+    fInCycle = false;
+    fDeadlineCycles = 0;
+    fDeadlineMaxUsecs = 0;
+    fDeadlinePeriodUsecs = 0;
 }
 
 JackClient::~JackClient()
@@ -213,6 +223,13 @@ int JackClient::ClientNotify(int refnum, const char* name, int notify, int sync,
                 }
                 break;
 
+            case kBufferSizePrepareCallback:
+                jack_log("JackClient::kBufferSizePrepareCallback buffer_size = %ld", value1);
+                if (fBufferSizePrepare) {
+                    res = fBufferSizePrepare(value1, fBufferSizePrepareArg);
+                }
+                break;
+
             case kSampleRateCallback:
                 jack_log("JackClient::kSampleRateCallback sample_rate = %ld", value1);
                 if (fSampleRate) {
@@ -250,6 +267,8 @@ int JackClient::ClientNotify(int refnum, const char* name, int notify, int sync,
                     if (fThread.AcquireRealTime(GetEngineControl()->fClientPriority) < 0) {
                         jack_error("JackClient::AcquireRealTime error");
                     }
+                    // SCHED_DEADLINE budget will be measured again
+                    ResetDeadline();
                 }
                 break;
 
@@ -464,10 +483,46 @@ int JackClient::Activate()
 
     int result = -1;
     GetClientControl()->fCallback[kRealTimeCallback] = IsRealTime();
+
+    // Without latency callback, the default latency propagation is done by the server and there is nothing to notify
+    GetClientControl()->fLatencyDefault = (fLatency == NULL);
+    GetClientControl()->fCallback[kLatencyCallback] = (fLatency != NULL);
+
     fChannel->ClientActivate(GetClientControl()->fRefNum, IsRealTime(), &result);
     return result;
 }
 
+/*!
+\brief Read by the server when the client is activated.
+*/
+int JackClient::SetPipelined(int onoff)
+{
+    if (IsActive()) {
+        jack_error("You cannot change the pipelined mode of an active client");
+        return -1;
+    } else {
+        GetClientControl()->fPipelined = (onoff != 0);
+        return 0;
+    }
+}
+
+/*!
+\brief Read by the server when the client is activated.
+*/
+int JackClient::SetBlockMultiplier(int multiplier)
+{
+    if (IsActive()) {
+        jack_error("You cannot change the block multiplier of an active client");
+        return -1;
+    } else if (multiplier < 1 || multiplier * GetEngineControl()->fBufferSize > BUFFER_SIZE_MAX) {
+        jack_error("Block multiplier = %d is out of range", multiplier);
+        return -1;
+    } else {
+        GetClientControl()->fBlockMultiplier = multiplier;
+        return 0;
+    }
+}
+
 /*!
 \brief Need to stop thread after deactivating in the server.
 */
@@ -555,6 +610,79 @@ void JackClient::SetupRealTime()
     if (fThread.AcquireSelfRealTime(GetEngineControl()->fClientPriority) < 0) {
         jack_error("JackClient::AcquireSelfRealTime error");
     }
+
+    // SCHED_DEADLINE is only requested after the compute time has been measured (see CheckDeadline),
+    // and the kernel refuses it for threads restricted to a subset of the CPUs
+    if (GetEngineControl()->fSchedDeadline) {
+        ResetDeadline();
+        return;
+    }
+
+    // CPU placement: JACK_CLIENT_CPUS takes precedence over the CPU assigned by the server
+    int cpus[JACK_CPU_SET_SIZE];
+    int count = 0;
+    const char* client_cpus = getenv("JACK_CLIENT_CPUS");
+    if (client_cpus) {
+        count = JackTools::ParseCPUList(client_cpus, cpus, JACK_CPU_SET_SIZE);
+    } else if (GetClientControl()->fCPU >= 0) {
+        cpus[0] = GetClientControl()->fCPU;
+        count = 1;
+    }
+
+    if (count > 0) {
+        if (fThread.AcquireSelfAffinity(cpus, count) < 0) {
+            jack_error("JackClient::AcquireSelfAffinity error");
+        } else {
+            jack_log("JackClient::SetupRealTime CPU affinity set, first CPU = %d", cpus[0]);
+        }
+    }
+}
+
+void JackClient::ResetDeadline()
+{
+    fDeadlineCycles = 0;
+    fDeadlineMaxUsecs = 0;
+    fDeadlinePeriodUsecs = GetEngineControl()->fPeriodUsecs;
+    GetClientControl()->fDeadlineRuntime = 0;
+}
+
+/*!
+\brief SCHED_DEADLINE mode: measure the client compute time during JACK_DEADLINE_MEASURE_CYCLES cycles, then request a budget from it.
+*/
+
+inline void JackClient::CheckDeadline()
+{
+    JackClientControl* control = GetClientControl();
+    JackClientTiming* timing = GetGraphManager()->GetClientTiming(control->fRefNum);
+    if (timing->fFinishedAt < timing->fAwakeAt) {
+        return;
+    }
+    jack_time_t compute_usecs = timing->fFinishedAt - timing->fAwakeAt;
+
+    if (fDeadlinePeriodUsecs != GetEngineControl()->fPeriodUsecs) {
+        // Buffer size has changed
+        ResetDeadline();
+    } else if (control->fDeadlineRuntime > 0) {
+        // Budget in use: overruns allow the server to attribute xruns
+        if (compute_usecs > control->fDeadlineRuntime) {
+            control->fDeadlineOverruns++;
+        }
+    } else if (fDeadlineCycles < JACK_DEADLINE_MEASURE_CYCLES) {
+        fDeadlineMaxUsecs = std::max(fDeadlineMaxUsecs, compute_usecs);
+        fDeadlineCycles++;
+    } else if (fDeadlineCycles == JACK_DEADLINE_MEASURE_CYCLES) {
+        fDeadlineCycles++; // Only one try
+        jack_time_t period_usecs = fDeadlinePeriodUsecs;
+        jack_time_t runtime_usecs = std::max(fDeadlineMaxUsecs * 2, jack_time_t(JACK_DEADLINE_MIN_RUNTIME));
+        runtime_usecs = std::min(runtime_usecs, (period_usecs * 9) / 10);
+        if (fThread.AcquireSelfDeadline(runtime_usecs * 1000, period_usecs * 1000, period_usecs * 1000) == 0) {
+            control->fDeadlineRuntime = runtime_usecs;
+            jack_info("Client '%s' uses SCHED_DEADLINE runtime = %lld usec period = %lld usec (measured max = %lld usec)",
+                      control->fName, (long long)runtime_usecs, (long long)period_usecs, (long long)fDeadlineMaxUsecs);
+        } else {
+            jack_error("Client '%s' keeps SCHED_FIFO scheduling", control->fName);
+        }
+    }
 }
 
 int JackClient::StartThread()
@@ -593,8 +721,8 @@ void JackClient::DummyCycle()
 inline void JackClient::ExecuteThread()
 {
     while (true) {
-        CycleWaitAux();
-        CycleSignalAux(CallProcessCallback());
+        jack_nframes_t frames = CycleWaitAux();
+        CycleSignalAux(CallProcessCallback(frames));
     }
 }
 
@@ -603,8 +731,10 @@ inline jack_nframes_t JackClient::CycleWaitAux()
     if (!WaitSync()) {
         Error();   // Terminates the thread
     }
+    fInCycle = true;
     CallSyncCallbackAux();
-    return GetEngineControl()->fBufferSize;
+    // A multi-rate client is only resumed when its block is complete
+    return GetGraphManager()->GetCycleFrames(GetClientControl()->fRefNum, GetEngineControl()->fBufferSize);
 }
 
 inline void JackClient::CycleSignalAux(int status)
@@ -612,7 +742,11 @@ inline void JackClient::CycleSignalAux(int status)
     if (status == 0) {
         CallTimebaseCallbackAux();
     }
+    fInCycle = false;
     SignalSync();
+    if (GetEngineControl()->fSchedDeadline) {
+        CheckDeadline();
+    }
     if (status != 0) {
         End();     // Terminates the thread
     }
@@ -628,9 +762,9 @@ void JackClient::CycleSignal(int status)
     CycleSignalAux(status);
 }
 
-inline int JackClient::CallProcessCallback()
+inline int JackClient::CallProcessCallback(jack_nframes_t frames)
 {
-    return (fProcess != NULL) ? fProcess(GetEngineControl()->fBufferSize, fProcessArg) : 0;
+    return (fProcess != NULL) ? fProcess(frames, fProcessArg) : 0;
 }
 
 inline bool JackClient::WaitSync()
@@ -699,6 +833,17 @@ int JackClient::PortRegister(const char* port_name, const char* port_type, unsig
         return 0; // Means failure here...
     }
 
+    // Init and mixdown functions of a custom type only exist in the processes which registered it
+    if (!IsUsablePortType(port_type)) {
+        jack_error("Port type = %s has not been registered with jack_port_type_register", port_type);
+        return 0; // Means failure here...
+    }
+
+    // Type registered with jack_port_type_register : the server learns its buffer size with the first port
+    if (buffer_size == 0) {
+        buffer_size = GetRegisteredPortTypeSize(port_type);
+    }
+
     int result = -1;
     jack_port_id_t port_index = NO_PORT;
     fChannel->PortRegister(GetClientControl()->fRefNum, port_full_name_str.c_str(), port_type, flags, buffer_size, &port_index, &result);
@@ -712,6 +857,58 @@ int JackClient::PortRegister(const char* port_name, const char* port_type, unsig
     }
 }
 
+int JackClient::PortRegisterMany(const char** port_names, unsigned int count, const char* port_type, unsigned long flags, unsigned long buffer_size, jack_port_id_t* port_indexes)
+{
+    if (count > PORT_NUM_FOR_CLIENT) {
+        jack_error("Cannot register %u ports, a client has at most %d ports", count, PORT_NUM_FOR_CLIENT);
+        return -1;
+    }
+
+    // Same checks as PortRegister, for each port
+    vector<string> port_full_names(count);
+    vector<const char*> names(count);
+    for (unsigned int i = 0; i < count; i++) {
+        if (port_names[i] == NULL || port_names[i][0] == 0) {
+            jack_error("port_name is empty");
+            return -1;
+        }
+        port_full_names[i] = string(GetClientControl()->fName) + string(":") + string(port_names[i]);
+        if (port_full_names[i].size() >= REAL_JACK_PORT_NAME_SIZE) {
+            jack_error("\"%s:%s\" is too long to be used as a JACK port name.\n"
+                       "Please use %lu characters or less",
+                       GetClientControl()->fName,
+                       port_names[i],
+                       JACK_PORT_NAME_SIZE - 1);
+            return -1;
+        }
+        names[i] = port_full_names[i].c_str();
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    if (!IsUsablePortType(port_type)) {
+        jack_error("Port type = %s has not been registered with jack_port_type_register", port_type);
+        return -1;
+    }
+
+    if (buffer_size == 0) {
+        buffer_size = GetRegisteredPortTypeSize(port_type);
+    }
+
+    int result = -1;
+    fChannel->PortRegisterMany(GetClientControl()->fRefNum, &names[0], count, port_type, flags, buffer_size, port_indexes, &result);
+
+    if (result == 0) {
+        jack_log("JackClient::PortRegisterMany ref = %ld count = %ld type = %s", GetClientControl()->fRefNum, count, port_type);
+        fPortList.insert(fPortList.end(), port_indexes, port_indexes + count);
+        return 0;
+    } else {
+        return -1;
+    }
+}
+
 int JackClient::PortUnRegister(jack_port_id_t port_index)
 {
     jack_log("JackClient::PortUnRegister port_index = %ld", port_index);
@@ -802,7 +999,7 @@ int JackClient::SetFreeWheel(int onoff)
 int JackClient::ComputeTotalLatencies()
 {
     int result = -1;
-    fChannel->ComputeTotalLatencies(&result);
+    fChannel->ComputeTotalLatencies(GetClientControl()->fRefNum, &result);
     return result;
 }
 
@@ -1073,6 +1270,19 @@ int JackClient::SetBufferSizeCallback(JackBufferSizeCallback callback, void *arg
     }
 }
 
+int JackClient::SetBufferSizePrepareCallback(JackBufferSizeCallback callback, void *arg)
+{
+    if (IsActive()) {
+        jack_error("You cannot set callbacks on an active client");
+        return -1;
+    } else {
+        GetClientControl()->fCallback[kBufferSizePrepareCallback] = (callback != NULL);
+        fBufferSizePrepareArg = arg;
+        fBufferSizePrepare = callback;
+        return 0;
+    }
+}
+
 int JackClient::SetSampleRateCallback(JackSampleRateCallback callback, void *arg)
 {
     if (IsActive()) {
@@ -1192,7 +1402,7 @@ int JackClient::SetLatencyCallback(JackLatencyCallback callback, void *arg)
         jack_error("You cannot set callbacks on an active client");
         return -1;
     } else {
-        // fCallback[kLatencyCallback] must always be 'true'
+        // fCallback[kLatencyCallback] is set in Activate
         fLatencyArg = arg;
         fLatency = callback;
         return 0;
@@ -58,6 +58,7 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
         JackInfoShutdownCallback fInfoShutdown;
         JackThreadInitCallback fInit;
         JackBufferSizeCallback fBufferSize;
+        JackBufferSizeCallback fBufferSizePrepare;
         JackSampleRateCallback fSampleRate;
         JackClientRegistrationCallback fClientRegistration;
         JackFreewheelCallback fFreewheel;
@@ -78,6 +79,7 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
         void* fInfoShutdownArg;
         void* fInitArg;
         void* fBufferSizeArg;
+        void* fBufferSizePrepareArg;
         void* fSampleRateArg;
         void* fClientRegistrationArg;
         void* fFreewheelArg;
@@ -100,6 +102,13 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
 
         JackSessionReply fSessionReply;
 
+        bool fInCycle;  // Set by the RT thread between the wait for its cycle and the graph resume
+
+        // SCHED_DEADLINE mode
+        int fDeadlineCycles;
+        jack_time_t fDeadlineMaxUsecs;
+        jack_time_t fDeadlinePeriodUsecs;
+
         int StartThread();
         void SetupDriverSync(bool freewheel);
         bool IsActive();
@@ -113,7 +122,7 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
         inline void ExecuteThread();
         inline bool WaitSync();
         inline void SignalSync();
-        inline int CallProcessCallback();
+        inline int CallProcessCallback(jack_nframes_t frames);
         inline void End();
         inline void Error();
         inline jack_nframes_t CycleWaitAux();
@@ -123,6 +132,8 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
         inline int ActivateAux();
         inline void InitAux();
         inline void SetupRealTime();
+        inline void CheckDeadline();
+        void ResetDeadline();
 
         int HandleLatencyCallback(int status);
 
@@ -144,6 +155,8 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
 
         virtual int Activate();
         virtual int Deactivate();
+        virtual int SetPipelined(int onoff);
+        virtual int SetBlockMultiplier(int multiplier);
 
         // Context
         virtual int SetBufferSize(jack_nframes_t buffer_size);
@@ -154,6 +167,7 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
 
         // Port management
         virtual int PortRegister(const char* port_name, const char* port_type, unsigned long flags, unsigned long buffer_size);
+        virtual int PortRegisterMany(const char** port_names, unsigned int count, const char* port_type, unsigned long flags, unsigned long buffer_size, jack_port_id_t* port_indexes);
         virtual int PortUnRegister(jack_port_id_t port);
 
         virtual int PortConnect(const char* src, const char* dst);
@@ -183,6 +197,7 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
         virtual int SetInitCallback(JackThreadInitCallback callback, void* arg);
         virtual int SetGraphOrderCallback(JackGraphOrderCallback callback, void* arg);
         virtual int SetBufferSizeCallback(JackBufferSizeCallback callback, void* arg);
+        virtual int SetBufferSizePrepareCallback(JackBufferSizeCallback callback, void* arg);
         virtual int SetSampleRateCallback(JackBufferSizeCallback callback, void* arg);
         virtual int SetClientRegistrationCallback(JackClientRegistrationCallback callback, void* arg);
         virtual int SetFreewheelCallback(JackFreewheelCallback callback, void* arg);
@@ -203,6 +218,10 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
         jack_nframes_t CycleWait();
         void CycleSignal(int status);
         virtual int SetProcessThread(JackThreadCallback fun, void *arg);
+        bool IsInCycle()
+        {
+            return fInCycle;
+        }
 
         // Session API
         virtual jack_session_command_t* SessionNotify(const char* target, jack_session_event_type_t type, const char* path);
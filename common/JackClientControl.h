@@ -45,6 +45,12 @@ struct JackClientControl : public JackShmMemAble
     int fRefNum;
     int fPID;
     bool fActive;
+    bool fLatencyDefault;   /* No latency callback : the server propagates the client latencies like the library default action */
+    bool fPipelined;        /* Runs one cycle behind the other clients, set by the client before activation */
+    int fBlockMultiplier;   /* Runs every fBlockMultiplier cycles on that many buffers, set by the client before activation */
+    int fCPU;       /* CPU assigned by the server to the client RT thread, -1 if none */
+    jack_time_t fDeadlineRuntime;           /* SCHED_DEADLINE budget in usec, 0 if not used */
+    volatile UInt32 fDeadlineOverruns;      /* Cycles where the measured compute time exceeded the budget */
 
     jack_uuid_t fSessionID;
     char fSessionCommand[JACK_SESSION_COMMAND_SIZE];
@@ -85,6 +91,12 @@ struct JackClientControl : public JackShmMemAble
         fTransportSync = false;
         fTransportTimebase = false;
         fActive = false;
+        fLatencyDefault = false;
+        fPipelined = false;
+        fBlockMultiplier = 1;
+        fCPU = -1;
+        fDeadlineRuntime = 0;
+        fDeadlineOverruns = 0;
 
         fSessionID = uuid;
     }
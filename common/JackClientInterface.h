@@ -46,6 +46,12 @@ class SERVER_EXPORT JackClientInterface
 
         virtual int ClientNotify(int refnum, const char* name, int notify, int sync, const char* message, int value1, int value2) = 0;
 
+        // Asynchronous notifications between these calls may be delivered together
+        virtual void NotifyBatchStart()
+        {}
+        virtual void NotifyBatchStop()
+        {}
+
         virtual JackClientControl* GetClientControl() const = 0;
 };
 
@@ -207,14 +207,34 @@ const jack_int_t* JackConnectionManager::GetOutputPorts(int refnum)
 }
 
 /*!
-\brief Init the refnum.
+\brief Copy of the whole state, the connection tables are mostly empty and only their used part is copied.
 */
+void JackConnectionManager::CopyState(const JackConnectionManager& src)
+{
+    for (int i = 0; i < PORT_NUM_MAX; i++) {
+        fConnection[i].CopyFrom(src.fConnection[i]);
+    }
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        fInputPort[i].CopyFrom(src.fInputPort[i]);
+        fOutputPort[i].CopyFrom(src.fOutputPort[i]);
+    }
+    memcpy(&fConnectionRef, &src.fConnectionRef, sizeof(fConnectionRef));
+    memcpy(fInputCounter, src.fInputCounter, sizeof(fInputCounter));
+    memcpy(&fLoopFeedback, &src.fLoopFeedback, sizeof(fLoopFeedback));
+    memcpy(fPipelined, src.fPipelined, sizeof(fPipelined));
+    memcpy(fBlockMultiplier, src.fBlockMultiplier, sizeof(fBlockMultiplier));
+    memcpy(fBlockOffset, src.fBlockOffset, sizeof(fBlockOffset));
+}
+
 void JackConnectionManager::InitRefNum(int refnum)
 {
     fInputPort[refnum].Init();
     fOutputPort[refnum].Init();
     fConnectionRef.Init(refnum);
     fInputCounter[refnum].SetValue(0);
+    fPipelined[refnum] = false;
+    fBlockMultiplier[refnum] = 1;
+    fBlockOffset[refnum] = 0;
 }
 
 /*!
@@ -406,6 +426,37 @@ int JackConnectionManager::GetOutputRefNum(jack_port_id_t port_index) const
     return -1;
 }
 
+/*!
+\brief Test if a connection between 2 refnum does not activate : one of them is a pipelined client and the other one is not a driver,
+or one of them is a multi-rate client.
+*/
+bool JackConnectionManager::IsPipelinedConnection(int ref1, int ref2) const
+{
+    int driver_num = GetEngineControl()->fDriverNum;
+    return (fBlockMultiplier[ref1] > 1 || fBlockMultiplier[ref2] > 1)
+        || (ref1 >= driver_num && ref2 >= driver_num && (fPipelined[ref1] || fPipelined[ref2]));
+}
+
+/*!
+\brief Number of cycles added by a connection : one when the data crosses a cycle, the block processing of a multi-rate source,
+plus the block accumulation of a multi-rate destination.
+*/
+int JackConnectionManager::GetConnectionCycles(int src_ref, int dst_ref) const
+{
+    int driver_num = GetEngineControl()->fDriverNum;
+    int cycles;
+
+    if (fBlockMultiplier[src_ref] > 1) {
+        // Outputs of a multi-rate client are played from the block it has processed during the previous 'multiplier' cycles
+        cycles = fBlockMultiplier[src_ref];
+    } else {
+        // Outputs of other clients are mixed at the next cycle start, driver ones in the cycle
+        cycles = (IsPipelinedConnection(src_ref, dst_ref) && src_ref >= driver_num) ? 1 : 0;
+    }
+    // Inputs of a multi-rate client wait for the end of the block
+    return cycles + fBlockMultiplier[dst_ref] - 1;
+}
+
 /*!
 \brief Test is a connection path exists between port_src and port_dst.
 */
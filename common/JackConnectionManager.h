@@ -117,6 +117,14 @@ class JackFixedArray
             return fCounter;
         }
 
+        // Items are kept packed at the start of the table followed by EMPTY: only the used part is copied
+        void CopyFrom(const JackFixedArray& src)
+        {
+            uint32_t count = (fCounter > src.fCounter) ? fCounter : src.fCounter;
+            memcpy(fTable, src.fTable, count * sizeof(jack_int_t));
+            fCounter = src.fCounter;
+        }
+
 } POST_PACKED_STRUCTURE;
 
 /*!
@@ -154,6 +162,12 @@ class JackFixedArray1 : public JackFixedArray<SIZE>
             }
         }
 
+        void CopyFrom(const JackFixedArray1& src)
+        {
+            JackFixedArray<SIZE>::CopyFrom(src);
+            fUsed = src.fUsed;
+        }
+
 } POST_PACKED_STRUCTURE;
 
 /*!
@@ -404,6 +418,8 @@ struct JackClientTiming
 <LI>The <B>fOutputPort</B> array contains the list (array line) of output connected  ports for a given client.
 <LI>The <B>fConnectionRef</B> array contains the number of ports connected between two clients.
 <LI>The <B>fInputCounter</B> array contains the number of input clients connected to a given for activation purpose.
+<LI>The <B>fPipelined</B> array tells which clients run one cycle behind the graph : their connections with other clients do not activate them.
+<LI>The <B>fBlockMultiplier</B> and <B>fBlockOffset</B> arrays give the block size (in buffers) and schedule of multi-rate clients, which are also pipelined and none of their connections activate them.
 </UL>
 */
 
@@ -419,6 +435,9 @@ class SERVER_EXPORT JackConnectionManager
         JackFixedMatrix<CLIENT_NUM> fConnectionRef;						/*! Table of port connections by (refnum , refnum) */
         JackActivationCount fInputCounter[CLIENT_NUM];					/*! Activation counter per refnum */
         JackLoopFeedback<CONNECTION_NUM_FOR_PORT> fLoopFeedback;		/*! Loop feedback connections */
+        bool fPipelined[CLIENT_NUM];									/*! Pipelined clients */
+        int fBlockMultiplier[CLIENT_NUM];								/*! Block size of multi-rate clients, 1 for the others */
+        int fBlockOffset[CLIENT_NUM];									/*! Spreads the multi-rate clients with the same block size over the cycles */
 
         bool IsLoopPathAux(int ref1, int ref2) const;
 
@@ -427,6 +446,9 @@ class SERVER_EXPORT JackConnectionManager
         JackConnectionManager();
         ~JackConnectionManager();
 
+        // Copy used by the graph manager before a new state is written
+        void CopyState(const JackConnectionManager& src);
+
         // Connections management
         int Connect(jack_port_id_t port_src, jack_port_id_t port_dst);
         int Disconnect(jack_port_id_t port_src, jack_port_id_t port_dst);
@@ -471,6 +493,34 @@ class SERVER_EXPORT JackConnectionManager
         int GetInputRefNum(jack_port_id_t port_index) const;
         int GetOutputRefNum(jack_port_id_t port_index) const;
 
+        // Pipelined clients
+        void SetPipelined(int refnum, bool onoff)
+        {
+            fPipelined[refnum] = onoff;
+        }
+        bool IsPipelined(int refnum) const
+        {
+            return fPipelined[refnum];
+        }
+        bool IsPipelinedConnection(int ref1, int ref2) const;
+
+        // Multi-rate clients
+        void SetBlockMultiplier(int refnum, int multiplier, int offset)
+        {
+            fBlockMultiplier[refnum] = multiplier;
+            fBlockOffset[refnum] = offset;
+        }
+        int GetBlockMultiplier(int refnum) const
+        {
+            return fBlockMultiplier[refnum];
+        }
+        // Buffer of the block filled (inputs) or played (outputs) in the given cycle, the client runs on the last one
+        int GetBlockPhase(int refnum, UInt32 cycle) const
+        {
+            return (cycle + fBlockOffset[refnum]) % fBlockMultiplier[refnum];
+        }
+        int GetConnectionCycles(int src_ref, int dst_ref) const;
+
         // Connect/Disconnect 2 refnum "directly"
         bool IsDirectConnection(int ref1, int ref2) const;
         void DirectConnect(int ref1, int ref2);
@@ -489,6 +539,11 @@ class SERVER_EXPORT JackConnectionManager
 
 } POST_PACKED_STRUCTURE;
 
+inline void JackCopyState(JackConnectionManager* dst, const JackConnectionManager* src)
+{
+    dst->CopyState(*src);
+}
+
 } // end of namespace
 
 #endif
@@ -61,10 +61,20 @@
 
 #define CONNECTION_NUM_FOR_PORT PORT_NUM_FOR_CLIENT
 
+#define CONNECTION_GAIN_NUM_FOR_PORT 16     // Max number of connections with a gain or mute setting for an input port
+
+#define CUSTOM_PORT_TYPE_NUM 16             // Max number of port types registered by clients (see JackPortType.cpp)
+
 #ifndef CLIENT_NUM
 #define CLIENT_NUM 64
 #endif
 
+#define JACK_CPU_SET_SIZE 256                   // Max number of CPUs in the RT client CPU set
+
+#define JACK_DEADLINE_MEASURE_CYCLES 64         // Cycles used to measure client compute time before switching to SCHED_DEADLINE
+#define JACK_DEADLINE_MIN_RUNTIME 100           // in usec
+#define JACK_DEADLINE_DRIVER_RATIO 50           // Driver thread runtime in percent of the period
+
 #define AUDIO_DRIVER_REFNUM   0                 // Audio driver is initialized first, it will get the refnum 0
 #define FREEWHEEL_DRIVER_REFNUM   1             // Freewheel driver is initialized second, it will get the refnum 1
 
@@ -72,9 +82,13 @@
 
 #define ALL_CLIENTS -1 // for notification
 
-#define JACK_PROTOCOL_VERSION 8
+#define JACK_PROTOCOL_VERSION 25
+
+#define JACK_FRAME_INLINE_SIZE 2048     // Requests and results up to this size are built without memory allocation
+#define JACK_SOCKET_BUFFER_SIZE 4096    // Receive buffer of a client/server socket or named pipe
 
 #define SOCKET_TIME_OUT 2               // in sec
+#define NOTIFY_BATCH_SIZE 32768         // in bytes
 #define DRIVER_OPEN_TIMEOUT 5           // in sec
 #define FREEWHEEL_DRIVER_TIMEOUT 10     // in sec
 #define DRIVER_TIMEOUT_FACTOR    10
@@ -32,6 +32,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include <signal.h>
+#include <chrono>
 
 #include "jslist.h"
 #include "driver_interface.h"
@@ -41,6 +42,7 @@
 #include "JackTools.h"
 #include "JackControlAPI.h"
 #include "JackLockedEngine.h"
+#include "JackEngineControl.h"
 #include "JackConstants.h"
 #include "JackDriverLoader.h"
 #include "JackServerGlobals.h"
@@ -66,6 +68,10 @@ struct jackctl_server
 
     class JackServer * engine;
 
+    /* startup durations, reported in verbose mode */
+    long load_usecs;
+    long open_usecs;
+
     /* string, server name */
     union jackctl_parameter_value name;
     union jackctl_parameter_value default_name;
@@ -109,6 +115,22 @@ struct jackctl_server
     /* char enum, self connect mode mode */
     union jackctl_parameter_value self_connect_mode;
     union jackctl_parameter_value default_self_connect_mode;
+
+    /* int32_t, CPU the driver thread is pinned to, -1 for none */
+    union jackctl_parameter_value driver_cpu;
+    union jackctl_parameter_value default_driver_cpu;
+
+    /* string, CPU list used for client RT threads, empty for none */
+    union jackctl_parameter_value client_cpus;
+    union jackctl_parameter_value default_client_cpus;
+
+    /* bool, use SCHED_DEADLINE instead of SCHED_FIFO in realtime mode */
+    union jackctl_parameter_value sched_deadline;
+    union jackctl_parameter_value default_sched_deadline;
+
+    /* bool, process slave drivers in parallel */
+    union jackctl_parameter_value parallel_slaves;
+    union jackctl_parameter_value default_parallel_slaves;
 };
 
 struct jackctl_driver
@@ -379,6 +401,14 @@ destroy:
     return false;
 }
 
+/* The server clock is only set up when the server is opened */
+static long
+jackctl_get_usecs()
+{
+    return (long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 static int
 jackctl_drivers_load(
     struct jackctl_server * server_ptr)
@@ -928,10 +958,69 @@ SERVER_EXPORT jackctl_server_t * jackctl_server_create2(
         goto fail_free_parameters;
     }
 
+    value.i = -1;
+    if (jackctl_add_parameter(
+            &server_ptr->parameters,
+            "driver-cpu",
+            "CPU the driver thread is pinned to (-1 for none).",
+            "",
+            JackParamInt,
+            &server_ptr->driver_cpu,
+            &server_ptr->default_driver_cpu,
+            value) == NULL)
+    {
+        goto fail_free_parameters;
+    }
+
+    value.str[0] = 0;
+    if (jackctl_add_parameter(
+            &server_ptr->parameters,
+            "client-cpus",
+            "CPU list for client realtime threads, like 2,4-7 (empty for none).",
+            "Each client realtime thread is pinned to one CPU of the list, CPUs sharing the driver CPU last level cache being used first.",
+            JackParamString,
+            &server_ptr->client_cpus,
+            &server_ptr->default_client_cpus,
+            value) == NULL)
+    {
+        goto fail_free_parameters;
+    }
+
+    value.b = false;
+    if (jackctl_add_parameter(
+            &server_ptr->parameters,
+            "sched-deadline",
+            "Use SCHED_DEADLINE scheduling in realtime mode (Linux only).",
+            "The driver thread and client realtime threads get a runtime budget per period instead of a SCHED_FIFO priority. Client budgets are computed from their measured compute time, the kernel admission control may refuse them.",
+            JackParamBool,
+            &server_ptr->sched_deadline,
+            &server_ptr->default_sched_deadline,
+            value) == NULL)
+    {
+        goto fail_free_parameters;
+    }
+
+    value.b = false;
+    if (jackctl_add_parameter(
+            &server_ptr->parameters,
+            "parallel-slaves",
+            "Process slave drivers in parallel.",
+            "The read and write parts of each slave driver cycle run concurrently in one realtime helper thread per slave, instead of one after the other in the master driver thread.",
+            JackParamBool,
+            &server_ptr->parallel_slaves,
+            &server_ptr->default_parallel_slaves,
+            value) == NULL)
+    {
+        goto fail_free_parameters;
+    }
+
     JackServerGlobals::on_device_acquire = on_device_acquire;
     JackServerGlobals::on_device_release = on_device_release;
     JackServerGlobals::on_device_reservation_loop = on_device_reservation_loop;
 
+    server_ptr->load_usecs = jackctl_get_usecs();
+    server_ptr->open_usecs = 0;
+
     if (!jackctl_drivers_load(server_ptr))
     {
         goto fail_free_parameters;
@@ -940,6 +1029,8 @@ SERVER_EXPORT jackctl_server_t * jackctl_server_create2(
     /* Allowed to fail */
     jackctl_internals_load(server_ptr);
 
+    server_ptr->load_usecs = jackctl_get_usecs() - server_ptr->load_usecs;
+
     return server_ptr;
 
 fail_free_parameters:
@@ -1021,6 +1112,8 @@ jackctl_server_open(
             return false;
         }
 
+        server_ptr->open_usecs = jackctl_get_usecs();
+
         int rc = jack_register_server(server_ptr->name.str, server_ptr->replace_registry.b);
         switch (rc)
         {
@@ -1063,7 +1156,11 @@ jackctl_server_open(
             server_ptr->verbose.b,
             (jack_timer_type_t)server_ptr->clock_source.ui,
             server_ptr->self_connect_mode.c,
-            server_ptr->name.str);
+            server_ptr->name.str,
+            server_ptr->driver_cpu.i,
+            server_ptr->client_cpus.str,
+            server_ptr->sched_deadline.b,
+            server_ptr->parallel_slaves.b);
         if (server_ptr->engine == NULL)
         {
             jack_error("Failed to create new JackServer object");
@@ -1079,6 +1176,7 @@ jackctl_server_open(
             goto fail_delete;
         }
 
+        server_ptr->open_usecs = jackctl_get_usecs() - server_ptr->open_usecs;
         return true;
 
     } catch (std::exception&) {
@@ -1114,11 +1212,15 @@ jackctl_server_start(
     if (!server_ptr) {
         return false;
     } else {
+        long start_usecs = jackctl_get_usecs();
         int rc = server_ptr->engine->Start();
         bool result = rc >= 0;
         if (! result)
         {
             jack_error("JackServer::Start() failed with %d", rc);
+        } else {
+            jack_log("Server startup: modules listed in %ld usecs, opened in %ld usecs, started in %ld usecs",
+                     server_ptr->load_usecs, server_ptr->open_usecs, jackctl_get_usecs() - start_usecs);
         }
         return result;
     }
@@ -1444,3 +1546,29 @@ SERVER_EXPORT bool jackctl_server_switch_master(jackctl_server * server_ptr, jac
         return false;
     }
 }
+
+SERVER_EXPORT int jackctl_server_get_client_cpu(jackctl_server * server_ptr, const char * client_name)
+{
+    if (server_ptr && server_ptr->engine && client_name) {
+        return server_ptr->engine->GetEngine()->GetClientCPU(client_name);
+    } else {
+        return -1;
+    }
+}
+
+SERVER_EXPORT float jackctl_server_get_cycle_percentile(jackctl_server * server_ptr, jack_cycle_histogram_t type, const char * client_name, float percentile)
+{
+    if (server_ptr && server_ptr->engine) {
+        JackTimeHistogram* histogram = server_ptr->engine->GetEngineControl()->GetHistogram(type, client_name);
+        return (histogram ? histogram->GetPercentile(percentile) : -1.f);
+    } else {
+        return -1.f;
+    }
+}
+
+SERVER_EXPORT void jackctl_server_reset_cycle_histograms(jackctl_server * server_ptr)
+{
+    if (server_ptr && server_ptr->engine) {
+        server_ptr->engine->GetEngineControl()->ResetHistograms();
+    }
+}
@@ -23,6 +23,7 @@
 #define __JackControlAPI__
 
 #include "jslist.h"
+#include "statistics.h"
 #include "JackCompilerDeps.h"
 
 /** Parameter types, intentionally similar to jack_driver_param_type_t */
@@ -256,6 +257,19 @@ SERVER_EXPORT bool
 jackctl_server_switch_master(jackctl_server_t * server,
                             jackctl_driver_t * driver);
 
+SERVER_EXPORT int
+jackctl_server_get_client_cpu(jackctl_server_t * server,
+                            const char * client_name);
+
+SERVER_EXPORT float
+jackctl_server_get_cycle_percentile(jackctl_server_t * server,
+                            jack_cycle_histogram_t type,
+                            const char * client_name,
+                            float percentile);
+
+SERVER_EXPORT void
+jackctl_server_reset_cycle_histograms(jackctl_server_t * server);
+
 SERVER_EXPORT int
 jackctl_parse_driver_params(jackctl_driver * driver_ptr, int argc, char* argv[]);
 
@@ -0,0 +1,79 @@
+/*
+Copyright (C) 2026
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackPortType.h"
+
+namespace Jack
+{
+
+/*
+A control port carries one value per cycle, whatever the buffer size : only this value is cleared, copied or mixed.
+Several connections are either averaged, or the last connected one wins.
+*/
+
+static void ControlBufferInit(void* buffer, size_t, jack_nframes_t)
+{
+    *static_cast<jack_default_audio_sample_t*>(buffer) = 0.f;
+}
+
+static void ControlBufferMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t)
+{
+    jack_default_audio_sample_t value = 0.f;
+
+    for (int i = 0; i < src_count; i++) {
+        value += *static_cast<jack_default_audio_sample_t*>(src_buffers[i]);
+    }
+
+    *static_cast<jack_default_audio_sample_t*>(mixbuffer) = value / src_count;
+}
+
+static void LastControlBufferMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t)
+{
+    // Connections are kept in the order they were made
+    *static_cast<jack_default_audio_sample_t*>(mixbuffer) = *static_cast<jack_default_audio_sample_t*>(src_buffers[src_count - 1]);
+}
+
+static size_t ControlBufferSize()
+{
+    return sizeof(jack_default_audio_sample_t);
+}
+
+const JackPortType gControlPortType =
+{
+    JACK_DEFAULT_CONTROL_TYPE,
+    ControlBufferSize,
+    ControlBufferInit,
+    ControlBufferMixdown,
+    NULL,
+    NULL,
+    NULL
+};
+
+const JackPortType gLastControlPortType =
+{
+    JACK_LAST_CONTROL_TYPE,
+    ControlBufferSize,
+    ControlBufferInit,
+    LastControlBufferMixdown,
+    NULL,
+    NULL,
+    NULL
+};
+
+} // namespace Jack
@@ -209,6 +209,30 @@ int JackDebugClient::PortRegister(const char* port_name, const char* port_type,
     return res;
 }
 
+int JackDebugClient::PortRegisterMany(const char** port_names, unsigned int count, const char* port_type, unsigned long flags, unsigned long buffer_size, jack_port_id_t* port_indexes)
+{
+    CheckClient("PortRegisterMany");
+    int res = fClient->PortRegisterMany(port_names, count, port_type, flags, buffer_size, port_indexes);
+    if (res < 0) {
+        *fStream << "Client '" << fClientName << "' try to register " << count << " ports and server return error  " << res << " ." << endl;
+    } else {
+        for (unsigned int i = 0; i < count; i++) {
+            if (fTotalPortNumber < MAX_PORT_HISTORY) {
+                fPortList[fTotalPortNumber].idport = port_indexes[i];
+                strcpy(fPortList[fTotalPortNumber].name, port_names[i]);
+                fPortList[fTotalPortNumber].IsConnected = 0;
+                fPortList[fTotalPortNumber].IsUnregistered = 0;
+            } else {
+                *fStream << "!!! WARNING !!! History is full : no more port history will be recorded." << endl;
+            }
+            fTotalPortNumber++;
+            fOpenPortNumber++;
+            *fStream << "Client '" << fClientName << "' port register with portname '" << port_names[i] << " port " << port_indexes[i] << "' ." << endl;
+        }
+    }
+    return res;
+}
+
 int JackDebugClient::PortUnRegister(jack_port_id_t port_index)
 {
     CheckClient("PortUnRegister");
@@ -507,6 +531,12 @@ int JackDebugClient::SetBufferSizeCallback(JackBufferSizeCallback callback, void
     return fClient->SetBufferSizeCallback(callback, arg);
 }
 
+int JackDebugClient::SetBufferSizePrepareCallback(JackBufferSizeCallback callback, void *arg)
+{
+    CheckClient("SetBufferSizePrepareCallback");
+    return fClient->SetBufferSizePrepareCallback(callback, arg);
+}
+
 int JackDebugClient::SetClientRegistrationCallback(JackClientRegistrationCallback callback, void* arg)
 {
     CheckClient("SetClientRegistrationCallback");
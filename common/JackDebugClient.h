@@ -89,6 +89,7 @@ class JackDebugClient : public JackClient
 
         // Port management
         int PortRegister(const char* port_name, const char* port_type, unsigned long flags, unsigned long buffer_size);
+        int PortRegisterMany(const char** port_names, unsigned int count, const char* port_type, unsigned long flags, unsigned long buffer_size, jack_port_id_t* port_indexes);
         int PortUnRegister(jack_port_id_t port);
 
         int PortConnect(const char* src, const char* dst);
@@ -118,6 +119,7 @@ class JackDebugClient : public JackClient
         int SetInitCallback(JackThreadInitCallback callback, void* arg);
         int SetGraphOrderCallback(JackGraphOrderCallback callback, void* arg);
         int SetBufferSizeCallback(JackBufferSizeCallback callback, void* arg);
+        int SetBufferSizePrepareCallback(JackBufferSizeCallback callback, void* arg);
         int SetClientRegistrationCallback(JackClientRegistrationCallback callback, void* arg);
         int SetFreewheelCallback(JackFreewheelCallback callback, void* arg);
         int SetPortRegistrationCallback(JackPortRegistrationCallback callback, void* arg);
@@ -37,6 +37,94 @@ using namespace std;
 namespace Jack
 {
 
+JackSlaveRunner::JackSlaveRunner(JackDriverInterface* slave, unsigned int index)
+    :fSlave(slave), fIndex(index), fThread(this), fCommand(kIdle), fResult(0), fBegin(0), fEnd(0)
+{}
+
+JackSlaveRunner::~JackSlaveRunner()
+{}
+
+int JackSlaveRunner::Start(const char* name, const char* server_name)
+{
+    char sync_name[SYNC_MAX_NAME_SIZE];
+
+    snprintf(sync_name, sizeof(sync_name), "%s_slave%u_start", name, fIndex);
+    if (!fStart.Allocate(sync_name, server_name, 0)) {
+        return -1;
+    }
+    snprintf(sync_name, sizeof(sync_name), "%s_slave%u_done", name, fIndex);
+    if (!fDone.Allocate(sync_name, server_name, 0)) {
+        fStart.Destroy();
+        return -1;
+    }
+    if (fThread.StartSync() < 0) {
+        fStart.Destroy();
+        fDone.Destroy();
+        return -1;
+    }
+    return 0;
+}
+
+int JackSlaveRunner::Stop()
+{
+    Post(kQuit);
+    int res = fThread.Stop();
+    fStart.Destroy();
+    fDone.Destroy();
+    return res;
+}
+
+void JackSlaveRunner::Post(int command)
+{
+    fCommand = command;
+    fStart.Signal();
+}
+
+int JackSlaveRunner::Join()
+{
+    return (fDone.Wait()) ? fResult : -1;
+}
+
+bool JackSlaveRunner::Init()
+{
+    if (GetEngineControl()->fRealTime) {
+        if (fThread.AcquireSelfRealTime(GetEngineControl()->fServerPriority) < 0) {
+            jack_error("JackSlaveRunner: AcquireSelfRealTime error");
+        }
+    }
+    return true;
+}
+
+bool JackSlaveRunner::Execute()
+{
+    if (!fStart.Wait()) {
+        jack_error("JackSlaveRunner::Execute wait error");
+        return false;
+    }
+
+    int command = fCommand;
+    if (command == kQuit) {
+        return false;
+    }
+
+    int res = 0;
+    fBegin = fEnd = 0;
+    if (fSlave->IsRunning()) {
+    #ifdef JACK_MONITOR
+        fBegin = GetMicroSeconds();
+    #endif
+        res = (command == kRead) ? fSlave->ProcessRead() : fSlave->ProcessWrite();
+    #ifdef JACK_MONITOR
+        fEnd = GetMicroSeconds();
+    #endif
+    }
+
+    fResult = res;
+    fCommand = kIdle;
+    fDone.Signal();
+    return true;
+}
+
 JackDriver::JackDriver(const char* name, const char* alias, JackLockedEngine* engine, JackSynchro* table)
     :fCaptureChannels(0),
     fPlaybackChannels(0),
@@ -53,6 +141,8 @@ JackDriver::JackDriver(const char* name, const char* alias, JackLockedEngine* en
     fDelayedUsecs = 0.f;
     fIsMaster = true;
     fIsRunning = false;
+    // Latencies of the driver ports are set by the driver itself
+    fClientControl.fCallback[kLatencyCallback] = false;
 }
 
 JackDriver::~JackDriver()
@@ -241,43 +331,112 @@ bool JackDriver::GetMaster()
     return fIsMaster;
 }
 
+/*
+Slaves are only added or removed when the driver cycle is not running, runner threads
+are then rebuilt so that they always match the slave list.
+*/
+
 void JackDriver::AddSlave(JackDriverInterface* slave)
 {
+    StopSlaveRunners();
     fSlaveList.push_back(slave);
+    if (fIsRunning) {
+        StartSlaveRunners();
+    }
 }
 
 void JackDriver::RemoveSlave(JackDriverInterface* slave)
 {
+    StopSlaveRunners();
     fSlaveList.remove(slave);
+    if (fIsRunning) {
+        StartSlaveRunners();
+    }
 }
 
+/*
+In "parallel-slaves" mode, all slaves but the first one (the freewheel driver when running in a server)
+have a runner thread. The runners are posted first, the slaves without runner are processed in the calling thread,
+then all runners are joined: slaves I/O is done concurrently but always completed when returning.
+Runners are either all started or none, so slave at index i > 0 has the runner at index i - 1.
+Profiling is only written by the calling thread, once the runners are joined.
+*/
+
 int JackDriver::ProcessReadSlaves()
 {
     int res = 0;
+    unsigned int index = 0;
+    list<JackSlaveRunner*>::const_iterator runner;
+    for (runner = fSlaveRunnerList.begin(); runner != fSlaveRunnerList.end(); runner++) {
+        (*runner)->Read();
+    }
     list<JackDriverInterface*>::const_iterator it;
-    for (it = fSlaveList.begin(); it != fSlaveList.end(); it++) {
+    for (it = fSlaveList.begin(); it != fSlaveList.end(); it++, index++) {
         JackDriverInterface* slave = *it;
+        if (index > 0 && index <= fSlaveRunnerList.size()) {
+            continue;
+        }
         if (slave->IsRunning()) {
+        #ifdef JACK_MONITOR
+            jack_time_t begin = GetMicroSeconds();
+        #endif
             if (slave->ProcessRead() < 0) {
                 res = -1;
             }
+        #ifdef JACK_MONITOR
+            fEngineControl->fProfiler.ProfileSlaveRead(index, begin, GetMicroSeconds());
+        #endif
         }
     }
+    for (runner = fSlaveRunnerList.begin(); runner != fSlaveRunnerList.end(); runner++) {
+        if ((*runner)->Join() < 0) {
+            res = -1;
+        }
+    #ifdef JACK_MONITOR
+        if ((*runner)->GetEnd() > 0) {
+            fEngineControl->fProfiler.ProfileSlaveRead((*runner)->GetIndex(), (*runner)->GetBegin(), (*runner)->GetEnd());
+        }
+    #endif
+    }
     return res;
 }
 
 int JackDriver::ProcessWriteSlaves()
 {
     int res = 0;
+    unsigned int index = 0;
+    list<JackSlaveRunner*>::const_iterator runner;
+    for (runner = fSlaveRunnerList.begin(); runner != fSlaveRunnerList.end(); runner++) {
+        (*runner)->Write();
+    }
     list<JackDriverInterface*>::const_iterator it;
-    for (it = fSlaveList.begin(); it != fSlaveList.end(); it++) {
+    for (it = fSlaveList.begin(); it != fSlaveList.end(); it++, index++) {
         JackDriverInterface* slave = *it;
+        if (index > 0 && index <= fSlaveRunnerList.size()) {
+            continue;
+        }
         if (slave->IsRunning()) {
+        #ifdef JACK_MONITOR
+            jack_time_t begin = GetMicroSeconds();
+        #endif
             if (slave->ProcessWrite() < 0) {
                 res = -1;
             }
+        #ifdef JACK_MONITOR
+            fEngineControl->fProfiler.ProfileSlaveWrite(index, begin, GetMicroSeconds());
+        #endif
         }
     }
+    for (runner = fSlaveRunnerList.begin(); runner != fSlaveRunnerList.end(); runner++) {
+        if ((*runner)->Join() < 0) {
+            res = -1;
+        }
+    #ifdef JACK_MONITOR
+        if ((*runner)->GetEnd() > 0) {
+            fEngineControl->fProfiler.ProfileSlaveWrite((*runner)->GetIndex(), (*runner)->GetBegin(), (*runner)->GetEnd());
+        }
+    #endif
+    }
     return res;
 }
 
@@ -364,12 +523,48 @@ int JackDriver::StartSlaves()
             break;
         }
     }
+
+    if (res == 0) {
+        StartSlaveRunners();
+    }
     return res;
 }
 
+void JackDriver::StartSlaveRunners()
+{
+    // First slave stays in the driver thread
+    if (fEngineControl->fParallelSlaves && fSlaveList.size() > 1) {
+        unsigned int index = 1;
+        list<JackDriverInterface*>::const_iterator it;
+        for (it = ++fSlaveList.begin(); it != fSlaveList.end(); it++, index++) {
+            JackSlaveRunner* runner = new JackSlaveRunner(*it, index);
+            if (runner->Start(fClientControl.fName, fEngineControl->fServerName) < 0) {
+                jack_error("Cannot start slave driver thread, slaves will be processed in the driver thread");
+                delete runner;
+                StopSlaveRunners();
+                break;
+            }
+            fSlaveRunnerList.push_back(runner);
+        }
+        jack_log("JackDriver::StartSlaveRunners %ld slave driver thread(s)", fSlaveRunnerList.size());
+    }
+}
+
+void JackDriver::StopSlaveRunners()
+{
+    list<JackSlaveRunner*>::const_iterator it;
+    for (it = fSlaveRunnerList.begin(); it != fSlaveRunnerList.end(); it++) {
+        JackSlaveRunner* runner = *it;
+        runner->Stop();
+        delete runner;
+    }
+    fSlaveRunnerList.clear();
+}
+
 int JackDriver::StopSlaves()
 {
     int res = 0;
+    StopSlaveRunners();
     list<JackDriverInterface*>::const_iterator it;
     for (it = fSlaveList.begin(); it != fSlaveList.end(); it++) {
         JackDriverInterface* slave = *it;
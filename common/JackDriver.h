@@ -124,6 +124,53 @@ class SERVER_EXPORT JackDriverClientInterface : public JackDriverInterface, publ
 
 typedef std::list<std::pair<std::string, std::pair<std::string, std::string> > > driver_connections_list_t; // [type : (src, dst)]
 
+/*!
+ \brief Helper thread running the read and write parts of a slave driver cycle, used in "parallel-slaves" mode.
+ */
+
+class SERVER_EXPORT JackSlaveRunner : public JackRunnableInterface
+{
+
+    private:
+
+        enum { kIdle, kRead, kWrite, kQuit };
+
+        JackDriverInterface* fSlave;
+        unsigned int fIndex;
+        JackThread fThread;
+        JackSynchro fStart;     // posted by the driver thread
+        JackSynchro fDone;      // posted by the runner thread
+        volatile int fCommand;
+        int fResult;
+        jack_time_t fBegin;
+        jack_time_t fEnd;
+
+        void Post(int command);
+
+    public:
+
+        JackSlaveRunner(JackDriverInterface* slave, unsigned int index);
+        virtual ~JackSlaveRunner();
+
+        int Start(const char* name, const char* server_name);
+        int Stop();
+
+        // Non blocking, to be completed with Join
+        void Read() { Post(kRead); }
+        void Write() { Post(kWrite); }
+        int Join();
+
+        unsigned int GetIndex() { return fIndex; }
+        // Duration of the last completed command, only read by the driver thread after Join
+        jack_time_t GetBegin() { return fBegin; }
+        jack_time_t GetEnd() { return fEnd; }
+
+        // JackRunnableInterface interface
+        bool Init();
+        bool Execute();
+
+};
+
 class SERVER_EXPORT JackDriver : public JackDriverClientInterface
 {
 
@@ -151,6 +198,7 @@ class SERVER_EXPORT JackDriver : public JackDriverClientInterface
         JackClientControl fClientControl;
 
         std::list<JackDriverInterface*> fSlaveList;
+        std::list<JackSlaveRunner*> fSlaveRunnerList;
 
         bool fIsMaster;
         bool fIsRunning;
@@ -181,6 +229,8 @@ class SERVER_EXPORT JackDriver : public JackDriverClientInterface
 
         virtual int StartSlaves();
         virtual int StopSlaves();
+        void StartSlaveRunners();
+        void StopSlaveRunners();
 
         virtual int ResumeRefNum();
         virtual int SuspendRefNum();
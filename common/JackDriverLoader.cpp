@@ -30,6 +30,10 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 
 #ifndef WIN32
 #include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
 #endif
 
 #ifdef WIN32
@@ -418,6 +422,8 @@ jack_driver_desc_t* jack_find_driver_descriptor (JSList * drivers, const char* n
     return desc;
 }
 
+#ifdef WIN32
+
 static void* check_symbol(const file_char_t* sofile, const char* symbol, const file_char_t* driver_dir, void** res_dllhandle = NULL)
 {
     void* dlhandle;
@@ -498,8 +504,6 @@ error:
     return descriptor;
 }
 
-#ifdef WIN32
-
 JSList * jack_drivers_load(JSList * drivers)
 {
     //char dll_filename[512];
@@ -559,12 +563,447 @@ error:
 
 #else
 
+/*
+Module descriptor cache: the kind and descriptor of each module of the driver directory are kept
+in a file of the user cache directory, keyed by module name, modification time and size. Unchanged
+modules are not loaded when listing drivers and internals, only the selected one is opened later on
+by JackDriverInfo::Open. Descriptors are read again when a module changes. Descriptors with a
+non strict enumeration constraint are never cached: such values are hints listed when the descriptor
+is built (like the ALSA cards), so the module is loaded again each time to follow hot-plugged devices.
+Setting JACK_NO_DRIVER_CACHE disables the cache.
+*/
+
+#define JACK_MODULE_CACHE_MAGIC "JACKMODC"
+#define JACK_MODULE_CACHE_VERSION 2
+
+enum JackModuleKind {
+    kModuleOther = 0,   // Neither a driver nor an internal client
+    kModuleDriver,
+    kModuleInternal,
+    kModuleNotLoaded    // Could not be loaded, never cached
+};
+
+static void jack_free_descriptor(jack_driver_desc_t* desc)
+{
+    if (desc) {
+        for (uint32_t i = 0; i < desc->nparams; i++) {
+            jack_constraint_free(desc->params[i].constraint);
+        }
+        free(desc->params);
+        free(desc);
+    }
+}
+
+static jack_driver_desc_t* jack_copy_descriptor(const jack_driver_desc_t* desc)
+{
+    jack_driver_desc_t* copy = (jack_driver_desc_t*)malloc(sizeof(jack_driver_desc_t));
+    if (!copy) {
+        return NULL;
+    }
+    *copy = *desc;
+    copy->params = NULL;
+
+    if (desc->nparams > 0) {
+        if (!(copy->params = (jack_driver_param_desc_t*)calloc(desc->nparams, sizeof(jack_driver_param_desc_t)))) {
+            free(copy);
+            return NULL;
+        }
+        for (uint32_t i = 0; i < desc->nparams; i++) {
+            const jack_driver_param_constraint_desc_t* constraint = desc->params[i].constraint;
+            copy->params[i] = desc->params[i];
+            copy->params[i].constraint = NULL;
+            if (!constraint) {
+                continue;
+            }
+            jack_driver_param_constraint_desc_t* constraint_copy = (jack_driver_param_constraint_desc_t*)malloc(sizeof(jack_driver_param_constraint_desc_t));
+            if (!constraint_copy) {
+                jack_free_descriptor(copy);
+                return NULL;
+            }
+            *constraint_copy = *constraint;
+            if ((constraint->flags & JACK_CONSTRAINT_FLAG_RANGE) == 0) {
+                size_t size = constraint->constraint.enumeration.count * sizeof(jack_driver_param_value_enum_t);
+                constraint_copy->constraint.enumeration.possible_values_array = (jack_driver_param_value_enum_t*)malloc(size + 1);
+                if (!constraint_copy->constraint.enumeration.possible_values_array) {
+                    free(constraint_copy);
+                    jack_free_descriptor(copy);
+                    return NULL;
+                }
+                memcpy(constraint_copy->constraint.enumeration.possible_values_array, constraint->constraint.enumeration.possible_values_array, size);
+            }
+            copy->params[i].constraint = constraint_copy;
+        }
+    }
+
+    return copy;
+}
+
+/* Values of non strict enumerations are found at runtime, like the devices present */
+static bool jack_descriptor_is_enumerated(const jack_driver_desc_t* desc)
+{
+    for (uint32_t i = 0; i < desc->nparams; i++) {
+        const jack_driver_param_constraint_desc_t* constraint = desc->params[i].constraint;
+        if (constraint && (constraint->flags & (JACK_CONSTRAINT_FLAG_RANGE | JACK_CONSTRAINT_FLAG_STRICT)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Loads the module once to find its kind and descriptor */
+static jack_driver_desc_t* jack_read_descriptor(const char* sofile, const char* driver_dir, int* kind)
+{
+    char filename[1024];
+    void* dlhandle;
+    JackDriverDescFunction so_get_descriptor;
+    jack_driver_desc_t* descriptor = NULL;
+
+    *kind = kModuleNotLoaded;
+    snprintf(filename, 1022, "%s/%s", driver_dir, sofile);
+
+    if ((dlhandle = LoadDriverModule(filename)) == NULL) {
+        jack_error ("Could not open component .so '%s': %s", filename, dlerror());
+        return NULL;
+    }
+
+    if (GetDriverProc(dlhandle, "jack_internal_initialize") != NULL) {
+        *kind = kModuleInternal;
+        so_get_descriptor = (JackDriverDescFunction)GetDriverProc(dlhandle, "jack_get_descriptor");
+    } else {
+        *kind = kModuleDriver;
+        so_get_descriptor = (JackDriverDescFunction)GetDriverProc(dlhandle, "driver_get_descriptor");
+    }
+
+    if (so_get_descriptor == NULL) {
+        *kind = kModuleOther;
+    } else if ((descriptor = so_get_descriptor()) == NULL) {
+        jack_error("Driver from '%s' returned NULL descriptor", filename);
+    } else {
+        strncpy(descriptor->file, filename, JACK_PATH_MAX);
+    }
+
+    UnloadDriverModule(dlhandle);
+    return descriptor;
+}
+
+struct JackModuleCacheEntry
+{
+    std::string fName;
+    int64_t fTime;
+    int64_t fSize;
+    int32_t fKind;
+    jack_driver_desc_t* fDesc;
+};
+
+class JackModuleCache
+{
+    private:
+
+        std::string fDriverDir;
+        std::string fPath;
+        std::vector<JackModuleCacheEntry> fEntries;
+        bool fDirty;
+        int fLoaded;
+
+        bool Read(FILE* file, void* data, size_t size)
+        {
+            return fread(data, size, 1, file) == 1;
+        }
+
+        bool Write(FILE* file, const void* data, size_t size)
+        {
+            return fwrite(data, size, 1, file) == 1;
+        }
+
+        void Clear()
+        {
+            for (size_t i = 0; i < fEntries.size(); i++) {
+                jack_free_descriptor(fEntries[i].fDesc);
+            }
+            fEntries.clear();
+        }
+
+        bool ReadDescriptor(FILE* file, jack_driver_desc_t** res)
+        {
+            jack_driver_desc_t* desc = (jack_driver_desc_t*)calloc(1, sizeof(jack_driver_desc_t));
+            *res = desc;
+            if (!desc || !Read(file, desc, sizeof(jack_driver_desc_t))) {
+                return false;
+            }
+            desc->params = NULL;
+            // Kept in the cache as read from the module
+            uint32_t nparams = desc->nparams;
+            desc->nparams = 0;
+            if (nparams > 0) {
+                if (nparams > 1024 || !(desc->params = (jack_driver_param_desc_t*)calloc(nparams, sizeof(jack_driver_param_desc_t)))) {
+                    return false;
+                }
+                if (!Read(file, desc->params, nparams * sizeof(jack_driver_param_desc_t))) {
+                    return false;
+                }
+                for (uint32_t i = 0; i < nparams; i++) {
+                    bool has_constraint = (desc->params[i].constraint != NULL);
+                    desc->params[i].constraint = NULL;
+                    desc->nparams++;
+                    if (!has_constraint) {
+                        continue;
+                    }
+                    jack_driver_param_constraint_desc_t* constraint = (jack_driver_param_constraint_desc_t*)calloc(1, sizeof(jack_driver_param_constraint_desc_t));
+                    if (!constraint || !Read(file, constraint, sizeof(jack_driver_param_constraint_desc_t))) {
+                        free(constraint);
+                        return false;
+                    }
+                    if ((constraint->flags & JACK_CONSTRAINT_FLAG_RANGE) == 0) {
+                        uint32_t count = constraint->constraint.enumeration.count;
+                        constraint->constraint.enumeration.possible_values_array = (jack_driver_param_value_enum_t*)malloc(count * sizeof(jack_driver_param_value_enum_t) + 1);
+                        if (!constraint->constraint.enumeration.possible_values_array
+                            || (count > 0 && !Read(file, constraint->constraint.enumeration.possible_values_array, count * sizeof(jack_driver_param_value_enum_t)))) {
+                            constraint->constraint.enumeration.count = 0;
+                            jack_constraint_free(constraint);
+                            return false;
+                        }
+                    }
+                    desc->params[i].constraint = constraint;
+                }
+            }
+            return true;
+        }
+
+        bool WriteDescriptor(FILE* file, const jack_driver_desc_t* desc)
+        {
+            if (!Write(file, desc, sizeof(jack_driver_desc_t))
+                || (desc->nparams > 0 && !Write(file, desc->params, desc->nparams * sizeof(jack_driver_param_desc_t)))) {
+                return false;
+            }
+            for (uint32_t i = 0; i < desc->nparams; i++) {
+                const jack_driver_param_constraint_desc_t* constraint = desc->params[i].constraint;
+                if (!constraint) {
+                    continue;
+                }
+                if (!Write(file, constraint, sizeof(jack_driver_param_constraint_desc_t))) {
+                    return false;
+                }
+                if ((constraint->flags & JACK_CONSTRAINT_FLAG_RANGE) == 0 && constraint->constraint.enumeration.count > 0
+                    && !Write(file, constraint->constraint.enumeration.possible_values_array, constraint->constraint.enumeration.count * sizeof(jack_driver_param_value_enum_t))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void Load()
+        {
+            FILE* file = fopen(fPath.c_str(), "rb");
+            if (!file) {
+                return;
+            }
+
+            char magic[8];
+            uint32_t header[6];
+            uint32_t expected[6] = { JACK_MODULE_CACHE_VERSION,
+                                     sizeof(jack_driver_desc_t),
+                                     sizeof(jack_driver_param_desc_t),
+                                     sizeof(jack_driver_param_constraint_desc_t),
+                                     sizeof(jack_driver_param_value_enum_t),
+                                     0 };
+            if (!Read(file, magic, sizeof(magic)) || memcmp(magic, JACK_MODULE_CACHE_MAGIC, sizeof(magic)) != 0
+                || !Read(file, header, sizeof(header)) || memcmp(header, expected, 5 * sizeof(uint32_t)) != 0) {
+                jack_log("JackModuleCache: ignoring %s", fPath.c_str());
+                fclose(file);
+                return;
+            }
+
+            for (uint32_t i = 0; i < header[5]; i++) {
+                JackModuleCacheEntry entry;
+                uint32_t name_len;
+                char name[PATH_MAX];
+                entry.fDesc = NULL;
+                if (!Read(file, &name_len, sizeof(name_len)) || name_len >= sizeof(name)
+                    || !Read(file, name, name_len)
+                    || !Read(file, &entry.fTime, sizeof(entry.fTime))
+                    || !Read(file, &entry.fSize, sizeof(entry.fSize))
+                    || !Read(file, &entry.fKind, sizeof(entry.fKind))
+                    || (entry.fKind != kModuleOther && !ReadDescriptor(file, &entry.fDesc))) {
+                    jack_log("JackModuleCache: %s is corrupted", fPath.c_str());
+                    jack_free_descriptor(entry.fDesc);
+                    Clear();
+                    break;
+                }
+                entry.fName.assign(name, name_len);
+                fEntries.push_back(entry);
+            }
+
+            fclose(file);
+        }
+
+    public:
+
+        JackModuleCache(const char* driver_dir):fDriverDir(driver_dir), fDirty(false), fLoaded(0)
+        {
+            const char* cache_dir = getenv("XDG_CACHE_HOME");
+            const char* home = getenv("HOME");
+
+            if (getenv("JACK_NO_DRIVER_CACHE")) {
+                return;
+            }
+            if (cache_dir && cache_dir[0]) {
+                fPath = cache_dir;
+            } else if (home && home[0]) {
+                fPath = std::string(home) + "/.cache";
+            } else {
+                return;
+            }
+            fPath += "/jack";
+
+            // One file per driver directory
+            uint32_t hash = 2166136261u;
+            for (const char* c = driver_dir; *c; c++) {
+                hash = (hash ^ (unsigned char)*c) * 16777619u;
+            }
+            char name[32];
+            snprintf(name, sizeof(name), "/modules-%08x", hash);
+            fPath += name;
+            Load();
+        }
+
+        ~JackModuleCache()
+        {
+            Clear();
+        }
+
+        // Returns a descriptor owned by the caller, or NULL
+        jack_driver_desc_t* Get(const char* sofile, int* kind)
+        {
+            struct stat info;
+            std::string path = fDriverDir + "/" + sofile;
+            jack_driver_desc_t* desc;
+
+            if (stat(path.c_str(), &info) == 0) {
+                for (size_t i = 0; i < fEntries.size(); i++) {
+                    JackModuleCacheEntry& entry = fEntries[i];
+                    if (entry.fName == sofile) {
+                        if (entry.fTime == int64_t(info.st_mtime) && entry.fSize == int64_t(info.st_size)) {
+                            *kind = entry.fKind;
+                            return (entry.fDesc) ? jack_copy_descriptor(entry.fDesc) : NULL;
+                        }
+                        jack_free_descriptor(entry.fDesc);
+                        fEntries.erase(fEntries.begin() + i);
+                        break;
+                    }
+                }
+            }
+
+            desc = jack_read_descriptor(sofile, fDriverDir.c_str(), kind);
+            fLoaded++;
+
+            // Modules that could not be loaded (a library they use may be installed later), or that
+            // enumerate values, are loaded again next time
+            if (fPath.size() > 0 && (desc || *kind == kModuleOther) && !(desc && jack_descriptor_is_enumerated(desc))
+                && stat(path.c_str(), &info) == 0) {
+                JackModuleCacheEntry entry;
+                entry.fName = sofile;
+                entry.fTime = info.st_mtime;
+                entry.fSize = info.st_size;
+                entry.fKind = (desc) ? *kind : kModuleOther;
+                entry.fDesc = (desc) ? jack_copy_descriptor(desc) : NULL;
+                fEntries.push_back(entry);
+                fDirty = true;
+            }
+            return desc;
+        }
+
+        void Save()
+        {
+            jack_log("JackModuleCache: %d module(s) loaded in %s", fLoaded, fDriverDir.c_str());
+
+            if (!fDirty || fPath.size() == 0) {
+                return;
+            }
+
+            // Cache directory, created as needed
+            std::string dir = fPath.substr(0, fPath.rfind('/'));
+            for (size_t pos = 1; pos != std::string::npos; ) {
+                pos = dir.find('/', pos + 1);
+                mkdir(dir.substr(0, pos).c_str(), 0755);
+            }
+
+            // Written aside and renamed, so that concurrent readers see a complete file
+            char suffix[32];
+            snprintf(suffix, sizeof(suffix), ".%d", int(getpid()));
+            std::string tmp_path = fPath + suffix;
+            FILE* file = fopen(tmp_path.c_str(), "wb");
+            if (!file) {
+                jack_log("JackModuleCache: cannot write %s: %s", tmp_path.c_str(), strerror(errno));
+                return;
+            }
+
+            bool res = true;
+            size_t count = 0;
+            for (size_t i = 0; i < fEntries.size(); i++) {
+                struct stat info;
+                // Forget removed modules
+                if (stat((fDriverDir + "/" + fEntries[i].fName).c_str(), &info) == 0) {
+                    count++;
+                } else {
+                    jack_free_descriptor(fEntries[i].fDesc);
+                    fEntries.erase(fEntries.begin() + i--);
+                }
+            }
+
+            uint32_t header[6] = { JACK_MODULE_CACHE_VERSION,
+                                   sizeof(jack_driver_desc_t),
+                                   sizeof(jack_driver_param_desc_t),
+                                   sizeof(jack_driver_param_constraint_desc_t),
+                                   sizeof(jack_driver_param_value_enum_t),
+                                   uint32_t(count) };
+            res &= Write(file, JACK_MODULE_CACHE_MAGIC, 8);
+            res &= Write(file, header, sizeof(header));
+            for (size_t i = 0; i < fEntries.size() && res; i++) {
+                const JackModuleCacheEntry& entry = fEntries[i];
+                uint32_t name_len = entry.fName.size();
+                res &= Write(file, &name_len, sizeof(name_len));
+                res &= Write(file, entry.fName.c_str(), name_len);
+                res &= Write(file, &entry.fTime, sizeof(entry.fTime));
+                res &= Write(file, &entry.fSize, sizeof(entry.fSize));
+                res &= Write(file, &entry.fKind, sizeof(entry.fKind));
+                if (entry.fKind != kModuleOther) {
+                    res &= WriteDescriptor(file, entry.fDesc);
+                }
+            }
+
+            if (fclose(file) != 0 || !res || rename(tmp_path.c_str(), fPath.c_str()) != 0) {
+                jack_log("JackModuleCache: cannot write %s", fPath.c_str());
+                unlink(tmp_path.c_str());
+            } else {
+                fDirty = false;
+            }
+        }
+};
+
+static bool jack_check_duplicate(JSList* drivers, JSList* driver_list, jack_driver_desc_t* descriptor)
+{
+    JSList* lists[2] = { drivers, driver_list };
+
+    for (int i = 0; i < 2; i++) {
+        for (JSList* node = lists[i]; node; node = jack_slist_next (node)) {
+            jack_driver_desc_t* other_descriptor = (jack_driver_desc_t*) node->data;
+            if (strcmp(descriptor->name, other_descriptor->name) == 0) {
+                jack_error("The drivers in '%s' and '%s' both have the name '%s'; using the first",
+                           other_descriptor->file, descriptor->file, other_descriptor->name);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 JSList* jack_drivers_load (JSList * drivers)
 {
     struct dirent * dir_entry;
     DIR * dir_stream;
     const char* ptr;
     int err;
+    int kind;
     JSList* driver_list = NULL;
     jack_driver_desc_t* desc = NULL;
 
@@ -582,6 +1021,8 @@ JSList* jack_drivers_load (JSList * drivers)
         return NULL;
     }
 
+    JackModuleCache cache(driver_dir);
+
     while ((dir_entry = readdir(dir_stream))) {
 
         /* check the filename is of the right format */
@@ -598,19 +1039,25 @@ JSList* jack_drivers_load (JSList * drivers)
             continue;
         }
 
+        desc = cache.Get(dir_entry->d_name, &kind);
+
         /* check if dll is an internal client */
-        if (check_symbol(dir_entry->d_name, "jack_internal_initialize", driver_dir) != NULL) {
+        if (kind == kModuleInternal) {
+            jack_free_descriptor(desc);
             continue;
         }
 
-        desc = jack_get_descriptor (drivers, dir_entry->d_name, "driver_get_descriptor", driver_dir);
-        if (desc) {
+        if (desc && jack_check_duplicate(drivers, driver_list, desc)) {
+            jack_free_descriptor(desc);
+        } else if (desc) {
             driver_list = jack_slist_append (driver_list, desc);
         } else {
             jack_error ("jack_get_descriptor returns null for \'%s\'", dir_entry->d_name);
         }
     }
 
+    cache.Save();
+
     err = closedir (dir_stream);
     if (err) {
         jack_error ("Error closing driver directory %s: %s",
@@ -690,6 +1137,7 @@ JSList* jack_internals_load(JSList * internals)
     DIR * dir_stream;
     const char* ptr;
     int err;
+    int kind;
     JSList* driver_list = NULL;
     jack_driver_desc_t* desc;
 
@@ -707,6 +1155,8 @@ JSList* jack_internals_load(JSList * internals)
         return NULL;
     }
 
+    JackModuleCache cache(driver_dir);
+
     while ((dir_entry = readdir(dir_stream))) {
 
         ptr = strrchr (dir_entry->d_name, '.');
@@ -719,19 +1169,25 @@ JSList* jack_internals_load(JSList * internals)
             continue;
         }
 
+        desc = cache.Get(dir_entry->d_name, &kind);
+
         /* check if dll is an internal client */
-        if (check_symbol(dir_entry->d_name, "jack_internal_initialize", driver_dir) == NULL) {
+        if (kind != kModuleInternal) {
+            jack_free_descriptor(desc);
             continue;
         }
 
-        desc = jack_get_descriptor (internals, dir_entry->d_name, "jack_get_descriptor", driver_dir);
-        if (desc) {
+        if (desc && jack_check_duplicate(internals, driver_list, desc)) {
+            jack_free_descriptor(desc);
+        } else if (desc) {
             driver_list = jack_slist_append (driver_list, desc);
         } else {
             jack_error ("jack_get_descriptor returns null for \'%s\'", dir_entry->d_name);
         }
     }
 
+    cache.Save();
+
     err = closedir (dir_stream);
     if (err) {
         jack_error ("Error closing internal directory %s: %s\n",
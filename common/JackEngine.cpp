@@ -20,6 +20,8 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #include <iostream>
 #include <fstream>
 #include <set>
+#include <string>
+#include <algorithm>
 #include <assert.h>
 #include <ctype.h>
 
@@ -33,6 +35,7 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #include "JackGlobals.h"
 #include "JackChannel.h"
 #include "JackError.h"
+#include "JackPortType.h"
 
 extern const char* JACK_METADATA_HARDWARE;
 extern const char* JACK_METADATA_PRETTY_NAME;
@@ -54,6 +57,7 @@ JackEngine::JackEngine(JackGraphManager* manager,
     fSelfConnectMode = self_connect_mode;
     for (int i = 0; i < CLIENT_NUM; i++) {
         fClientTable[i] = NULL;
+        fLatencyChanged[i] = false;
     }
     fLastSwitchUsecs = 0;
     fSessionPendingReplies = 0;
@@ -172,6 +176,9 @@ bool JackEngine::Process(jack_time_t cur_cycle_begin, jack_time_t prev_cycle_end
     // Graph
     if (fGraphManager->IsFinishedGraph()) {
         ProcessNext(cur_cycle_begin);
+        // Pipelined clients get what the finished cycle produced, in the state of the new cycle : not after a late cycle,
+        // where clients may still be running
+        fGraphManager->CopyPipelinedBuffers(fEngineControl->fBufferSize, fSynchroTable);
         res = true;
     } else {
         jack_log("Process: graph not finished!");
@@ -216,13 +223,18 @@ void JackEngine::CheckXRun(jack_time_t callback_usecs)  // REVOIR les conditions
 {
     for (int i = fEngineControl->fDriverNum; i < CLIENT_NUM; i++) {
         JackClientInterface* client = fClientTable[i];
-        if (client && client->GetClientControl()->fActive) {
+        // Multi-rate clients run out of the graph, over several cycles
+        if (client && client->GetClientControl()->fActive && client->GetClientControl()->fBlockMultiplier == 1) {
             JackClientTiming* timing = fGraphManager->GetClientTiming(i);
             jack_client_state_t status = timing->fStatus;
             jack_time_t finished_date = timing->fFinishedAt;
 
             if (status != NotTriggered && status != Finished) {
                 jack_error("JackEngine::XRun: client = %s was not finished, state = %s", client->GetClientControl()->fName, State2String(status));
+                if (client->GetClientControl()->fDeadlineRuntime > 0) {
+                    jack_error("JackEngine::XRun: client = %s SCHED_DEADLINE budget = %lld usec, budget overruns = %u",
+                               client->GetClientControl()->fName, (long long)client->GetClientControl()->fDeadlineRuntime, client->GetClientControl()->fDeadlineOverruns);
+                }
                 fChannel.Notify(ALL_CLIENTS, kXRunCallback, 0);  // Notify all clients
             }
 
@@ -234,28 +246,72 @@ void JackEngine::CheckXRun(jack_time_t callback_usecs)  // REVOIR les conditions
     }
 }
 
-int JackEngine::ComputeTotalLatencies()
+/*
+Ranges are propagated client by client in graph order (capture) then in reverse graph order (playback), so that each
+port range is computed once. Clients without latency callback are handled here, the others are notified only when the
+ranges they get from their connections change, or when their latency or ports changed since the previous computation.
+*/
+
+void JackEngine::ComputeLatencies(int refnum, jack_latency_callback_mode_t mode)
+{
+    JackClientInterface* client = fClientTable[refnum];
+    if (!client) {
+        return;
+    }
+
+    JackClientControl* control = client->GetClientControl();
+    if (control->fLatencyDefault) {
+        fGraphManager->RecalculateLatencies(refnum, mode, true);
+        fGraphManager->PropagateLatencies(refnum, mode);
+    } else if (control->fCallback[kLatencyCallback]
+               && (fLatencyChanged[refnum] || fGraphManager->RecalculateLatencies(refnum, mode, false))) {
+        ClientNotify(client, refnum, control->fName, kLatencyCallback, true, "", (mode == JackCaptureLatency) ? 0 : 1, 0);
+    }
+}
+
+int JackEngine::ComputeTotalLatencies(int refnum)
 {
     std::vector<jack_int_t> sorted;
     std::vector<jack_int_t>::iterator it;
     std::vector<jack_int_t>::reverse_iterator rit;
 
-    fGraphManager->TopologicalSort(sorted);
+    if (refnum != ALL_CLIENTS) {
+        fLatencyChanged[refnum] = true;
+    }
 
-    /* iterate over all clients in graph order, and emit
-     * capture latency callback.
-     */
+    // Total latencies of all ports, for jack_port_get_total_latency
+    fGraphManager->ComputeTotalLatencies();
 
-    for (it = sorted.begin(); it != sorted.end(); it++) {
-        NotifyClient(*it, kLatencyCallback, true, "", 0, 0);
-    }
+    fGraphManager->TopologicalSort(sorted);
 
-    /* now issue playback latency callbacks in reverse graph order.
-     */
-    for (rit = sorted.rbegin(); rit != sorted.rend(); rit++) {
-        NotifyClient(*rit, kLatencyCallback, true, "", 1, 0);
+    // Connections of pipelined (and multi-rate) clients are not part of the graph order : ranges going through them
+    // are complete after one more pass per pipelined client
+    int passes = 1;
+    for (int i = fEngineControl->fDriverNum; i < CLIENT_NUM; i++) {
+        JackClientInterface* client = fClientTable[i];
+        if (client && client->GetClientControl()->fActive
+            && (client->GetClientControl()->fPipelined || client->GetClientControl()->fBlockMultiplier > 1)) {
+            passes++;
+            // Multi-rate clients run out of the graph, thus are not in its order
+            if (std::find(sorted.begin(), sorted.end(), i) == sorted.end()) {
+                sorted.push_back(i);
+            }
+        }
     }
 
+    for (int pass = 0; pass < passes; pass++) {
+        for (it = sorted.begin(); it != sorted.end(); it++) {
+            ComputeLatencies(*it, JackCaptureLatency);
+        }
+
+        for (rit = sorted.rbegin(); rit != sorted.rend(); rit++) {
+            ComputeLatencies(*rit, JackPlaybackLatency);
+        }
+
+        for (int i = 0; i < CLIENT_NUM; i++) {
+            fLatencyChanged[i] = false;
+        }
+    }
     return 0;
 }
 
@@ -378,7 +434,7 @@ void JackEngine::NotifyClientXRun(int refnum)
 
 void JackEngine::NotifyGraphReorder()
 {
-    ComputeTotalLatencies();
+    ComputeTotalLatencies(ALL_CLIENTS);
     NotifyClients(kGraphOrderCallback, false, "", 0, 0);
 }
 
@@ -387,6 +443,11 @@ void JackEngine::NotifyBufferSize(jack_nframes_t buffer_size)
     NotifyClients(kBufferSizeCallback, true, "", buffer_size, 0);
 }
 
+void JackEngine::NotifyBufferSizePrepare(jack_nframes_t buffer_size)
+{
+    NotifyClients(kBufferSizePrepareCallback, true, "", buffer_size, 0);
+}
+
 void JackEngine::NotifySampleRate(jack_nframes_t sample_rate)
 {
     NotifyClients(kSampleRateCallback, true, "", sample_rate, 0);
@@ -416,6 +477,35 @@ void JackEngine::NotifyPortRegistation(jack_port_id_t port_index, bool onoff)
     NotifyClients((onoff ? kPortRegistrationOnCallback : kPortRegistrationOffCallback), false, "", port_index, 0);
 }
 
+// Several ports, terminated by EMPTY (or PORT_NUM_FOR_CLIENT long) : sent as a single batch to each client
+void JackEngine::NotifyPortRegistation(const jack_int_t* ports, bool onoff)
+{
+    for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (ports[i] != EMPTY); i++) {
+        NotifyPortRegistation(ports[i], onoff);
+    }
+}
+
+// Asynchronous notifications sent between NotifyBatchStart and NotifyBatchStop are gathered and delivered at once
+void JackEngine::NotifyBatchStart()
+{
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        JackClientInterface* client = fClientTable[i];
+        if (client) {
+            client->NotifyBatchStart();
+        }
+    }
+}
+
+void JackEngine::NotifyBatchStop()
+{
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        JackClientInterface* client = fClientTable[i];
+        if (client) {
+            client->NotifyBatchStop();
+        }
+    }
+}
+
 void JackEngine::NotifyPortRename(jack_port_id_t port, const char* old_name)
 {
     NotifyClients(kPortRenameCallback, false, old_name, port, 0);
@@ -606,8 +696,51 @@ int JackEngine::GetClientRefNum(const char* name)
     return -1;
 }
 
+int JackEngine::GetClientCPU(const char* name)
+{
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        JackClientInterface* client = fClientTable[i];
+        if (client && (strcmp(client->GetClientControl()->fName, name) == 0)) {
+            return client->GetClientControl()->fCPU;
+        }
+    }
+
+    return -1;
+}
+
+/*
+The client set is ordered by cache domain (see JackEngineControl::InitCPUSet):
+taking the least used CPU in that order keeps clients close to the driver until its cache domain is full.
+*/
+int JackEngine::AllocateCPU()
+{
+    if (fEngineControl->fClientCPUCount == 0) {
+        return -1;
+    }
+
+    int best_cpu = -1;
+    int best_count = CLIENT_NUM + 1;
+
+    for (int i = 0; i < fEngineControl->fClientCPUCount; i++) {
+        int cpu = fEngineControl->fClientCPUs[i];
+        int count = 0;
+        for (int j = 0; j < CLIENT_NUM; j++) {
+            JackClientInterface* client = fClientTable[j];
+            if (client && client->GetClientControl()->fCPU == cpu) {
+                count++;
+            }
+        }
+        if (count < best_count) {
+            best_count = count;
+            best_cpu = cpu;
+        }
+    }
+
+    return best_cpu;
+}
+
 // Used for external clients
-int JackEngine::ClientExternalOpen(const char* name, int pid, jack_uuid_t uuid, int* ref, int* shared_engine, int* shared_client, int* shared_graph_manager)
+int JackEngine::ClientExternalOpen(const char* name, const char* notify_name, int pid, jack_uuid_t uuid, int* ref, int* shared_engine, int* shared_client, int* shared_graph_manager)
 {
     char real_name[JACK_CLIENT_NAME_SIZE + 1];
 
@@ -640,13 +773,14 @@ int JackEngine::ClientExternalOpen(const char* name, int pid, jack_uuid_t uuid,
         goto error;
     }
 
-    if (client->Open(real_name, pid, refnum, uuid, shared_client) < 0) {
+    if (client->Open(real_name, notify_name, pid, refnum, uuid, shared_client) < 0) {
         jack_error("Cannot open client");
         goto error;
     }
 
-    if (!fSignal.LockedTimedWait(DRIVER_OPEN_TIMEOUT * 1000000)) {
-        // Failure if RT thread is not running (problem with the driver...)
+    // Failure if RT thread is not running (problem with the driver...), a cycle that has just switched the graph is proof enough
+    if (GetMicroSeconds() > fLastSwitchUsecs + fEngineControl->fTimeOutUsecs
+        && !fSignal.LockedTimedWait(DRIVER_OPEN_TIMEOUT * 1000000)) {
         jack_error("Driver is not running");
         goto error;
     }
@@ -658,7 +792,13 @@ int JackEngine::ClientExternalOpen(const char* name, int pid, jack_uuid_t uuid,
         goto error;
     }
 
+    client->GetClientControl()->fCPU = AllocateCPU();
+    if (client->GetClientControl()->fCPU >= 0) {
+        jack_info("Client '%s' RT thread placed on CPU %d", real_name, client->GetClientControl()->fCPU);
+    }
+
     fGraphManager->InitRefNum(refnum);
+    fEngineControl->InitClientHistogram(refnum, real_name);
     fEngineControl->ResetRollingUsecs();
     *shared_engine = fEngineControl->GetShmIndex();
     *shared_graph_manager = fGraphManager->GetShmIndex();
@@ -703,7 +843,16 @@ int JackEngine::ClientInternalOpen(const char* name, int* ref, JackEngineControl
         goto error;
     }
 
+    // Drivers (opened without wait) use the server driver CPU
+    if (wait) {
+        client->GetClientControl()->fCPU = AllocateCPU();
+        if (client->GetClientControl()->fCPU >= 0) {
+            jack_info("Client '%s' RT thread placed on CPU %d", name, client->GetClientControl()->fCPU);
+        }
+    }
+
     fGraphManager->InitRefNum(refnum);
+    fEngineControl->InitClientHistogram(refnum, name);
     fEngineControl->ResetRollingUsecs();
     *shared_engine = fEngineControl;
     *shared_manager = fGraphManager;
@@ -742,6 +891,7 @@ int JackEngine::ClientCloseAux(int refnum, bool wait)
 
     JackClientInterface* client = fClientTable[refnum];
     fEngineControl->fTransport.ResetTimebase(refnum);
+    fEngineControl->InitClientHistogram(refnum, "");
 
     jack_uuid_t uuid = JACK_UUID_EMPTY_INITIALIZER;
     jack_uuid_copy (&uuid, client->GetClientControl()->fSessionID);
@@ -795,8 +945,23 @@ int JackEngine::ClientActivate(int refnum, bool is_real_time)
     jack_log("JackEngine::ClientActivate ref = %ld name = %s", refnum, client->GetClientControl()->fName);
 
     if (is_real_time) {
+        JackClientControl* control = client->GetClientControl();
+        int multiplier = control->fBlockMultiplier;
+        // Blocks are sliced in buffers, which must stay aligned for the mix code
+        if (multiplier > 1 && (fEngineControl->fBufferSize * multiplier > BUFFER_SIZE_MAX || fEngineControl->fBufferSize % 8 != 0)) {
+            jack_error("JackEngine::ClientActivate block multiplier = %d cannot be used with buffer size = %ld name = %s",
+                       multiplier, fEngineControl->fBufferSize, control->fName);
+            return -1;
+        }
+        // Ports of a pipelined client get their copies before the client enters the graph
+        if ((control->fPipelined || multiplier > 1)
+            && fGraphManager->SetPipelined(refnum, true, multiplier, fEngineControl->fBufferSize) < 0) {
+            jack_error("JackEngine::ClientActivate cannot pipeline ref = %ld name = %s", refnum, control->fName);
+            return -1;
+        }
         fGraphManager->Activate(refnum);
     }
+    fLatencyChanged[refnum] = true;
 
     // Wait for graph state change to be effective
     if (!fSignal.LockedTimedWait(fEngineControl->fTimeOutUsecs * 10)) {
@@ -812,12 +977,10 @@ int JackEngine::ClientActivate(int refnum, bool is_real_time)
         NotifyActivate(refnum);
 
         // Then issue port registration notification
-        for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (input_ports[i] != EMPTY); i++) {
-            NotifyPortRegistation(input_ports[i], true);
-        }
-        for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (output_ports[i] != EMPTY); i++) {
-            NotifyPortRegistation(output_ports[i], true);
-        }
+        NotifyBatchStart();
+        NotifyPortRegistation(input_ports, true);
+        NotifyPortRegistation(output_ports, true);
+        NotifyBatchStop();
 
         return 0;
     }
@@ -834,6 +997,8 @@ int JackEngine::ClientDeactivate(int refnum)
     fGraphManager->GetInputPorts(refnum, input_ports);
     fGraphManager->GetOutputPorts(refnum, output_ports);
 
+    NotifyBatchStart();
+
     // First disconnect all ports
     for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (input_ports[i] != EMPTY); i++) {
         PortDisconnect(-1, input_ports[i], ALL_PORTS);
@@ -843,14 +1008,12 @@ int JackEngine::ClientDeactivate(int refnum)
     }
 
     // Then issue port registration notification
-    for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (input_ports[i] != EMPTY); i++) {
-        NotifyPortRegistation(input_ports[i], false);
-    }
-    for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (output_ports[i] != EMPTY); i++) {
-        NotifyPortRegistation(output_ports[i], false);
-    }
+    NotifyPortRegistation(input_ports, false);
+    NotifyPortRegistation(output_ports, false);
+    NotifyBatchStop();
 
     fGraphManager->Deactivate(refnum);
+    fGraphManager->SetPipelined(refnum, false, 1, 0);
     fLastSwitchUsecs = 0; // Force switch to occur next cycle, even when called with "dead" clients
 
     // Wait for graph state change to be effective
@@ -888,9 +1051,14 @@ int JackEngine::PortRegister(int refnum, const char* name, const char *type, uns
         return -1;
     }
 
-    // buffer_size is actually ignored...
+    // buffer_size is only used by the first port of a type registered by a client
+    if (GetPortTypeId(type) == PORT_TYPES_MAX && fGraphManager->RegisterPortType(type, buffer_size) < 0) {
+        return -1;
+    }
+
     *port_index = fGraphManager->AllocatePort(refnum, name, type, (JackPortFlags)flags, fEngineControl->fBufferSize);
     if (*port_index != NO_PORT) {
+        fLatencyChanged[refnum] = true;
         if (client->GetClientControl()->fActive) {
             NotifyPortRegistation(*port_index, true);
         }
@@ -900,6 +1068,48 @@ int JackEngine::PortRegister(int refnum, const char* name, const char *type, uns
     }
 }
 
+int JackEngine::PortRegisterMany(int refnum, const char** names, unsigned int count, const char *type, unsigned int flags, unsigned int buffer_size, jack_port_id_t* port_indexes)
+{
+    jack_log("JackEngine::PortRegisterMany ref = %ld count = %ld type = %s flags = %d buffer_size = %d", refnum, count, type, flags, buffer_size);
+    JackClientInterface* client = fClientTable[refnum];
+
+    if (count > PORT_NUM_FOR_CLIENT) {
+        jack_error("JackEngine::PortRegisterMany too many ports = %ld", count);
+        return -1;
+    }
+
+    // Check if port names are given twice, or already exist
+    std::set<std::string> name_set(names, names + count);
+    if (name_set.size() != count) {
+        jack_error("port names are not all different");
+        return -1;
+    }
+    jack_port_id_t port_index = fGraphManager->GetPort(names, count);
+    if (port_index != NO_PORT) {
+        jack_error("port_name \"%s\" already exists", fGraphManager->GetPort(port_index)->GetName());
+        return -1;
+    }
+
+    // buffer_size is only used by the first port of a type registered by a client
+    if (GetPortTypeId(type) == PORT_TYPES_MAX && fGraphManager->RegisterPortType(type, buffer_size) < 0) {
+        return -1;
+    }
+
+    if (fGraphManager->AllocatePorts(refnum, names, count, type, (JackPortFlags)flags, fEngineControl->fBufferSize, port_indexes) < 0) {
+        return -1;
+    }
+
+    fLatencyChanged[refnum] = true;
+    if (client->GetClientControl()->fActive) {
+        NotifyBatchStart();
+        for (unsigned int i = 0; i < count; i++) {
+            NotifyPortRegistation(port_indexes[i], true);
+        }
+        NotifyBatchStop();
+    }
+    return 0;
+}
+
 int JackEngine::PortUnRegister(int refnum, jack_port_id_t port_index)
 {
     jack_log("JackEngine::PortUnRegister ref = %ld port_index = %ld", refnum, port_index);
@@ -910,6 +1120,7 @@ int JackEngine::PortUnRegister(int refnum, jack_port_id_t port_index)
     PortDisconnect(-1, port_index, ALL_PORTS);
 
     if (fGraphManager->ReleasePort(refnum, port_index) == 0) {
+        fLatencyChanged[refnum] = true;
         const jack_uuid_t uuid = jack_port_uuid_generate(port_index);
         if (!jack_uuid_empty(uuid))
         {
@@ -1170,7 +1381,9 @@ void JackEngine::SessionNotify(int refnum, const char *target, jack_session_even
         if (result == NULL) delete fSessionResult;
         fSessionResult = NULL;
     } else {
-        fSessionTransaction = socket;
+        // The request frame only lives during the call : the result will be sent later in its own frame
+        detail::JackFramedTransaction* frame = dynamic_cast<detail::JackFramedTransaction*>(socket);
+        fSessionTransaction = (frame) ? frame->GetChannel() : socket;
     }
 }
 
@@ -1187,7 +1400,13 @@ int JackEngine::SessionReply(int refnum)
     fSessionPendingReplies -= 1;
 
     if (fSessionPendingReplies == 0) {
-        fSessionResult->Write(fSessionTransaction);
+        if (fSessionTransaction != NULL) {
+            detail::JackFramedTransaction frame(fSessionTransaction);
+            fSessionResult->Write(&frame);
+            frame.Flush();
+        } else {
+            fSessionResult->Write(NULL);
+        }
         if (fSessionTransaction != NULL) {
             delete fSessionResult;
         }
@@ -55,6 +55,7 @@ class SERVER_EXPORT JackEngine : public JackLockAble
         JackServerNotifyChannel fChannel;              /*! To communicate between the RT thread and server */
         JackProcessSync fSignal;
         jack_time_t fLastSwitchUsecs;
+        bool fLatencyChanged[CLIENT_NUM];              /*! Clients to be notified at next latencies computation */
         JackMetadata fMetadata;
 
         int fSessionPendingReplies;
@@ -63,6 +64,7 @@ class SERVER_EXPORT JackEngine : public JackLockAble
         std::map<int,std::string> fReservationMap;
 
         int ClientCloseAux(int refnum, bool wait);
+        void ComputeLatencies(int refnum, jack_latency_callback_mode_t mode);
         void CheckXRun(jack_time_t callback_usecs);
 
         int NotifyAddClient(JackClientInterface* new_client, const char* new_name, int refnum);
@@ -77,12 +79,17 @@ class SERVER_EXPORT JackEngine : public JackLockAble
         int AllocateRefnum();
         void ReleaseRefnum(int refnum);
 
+        int AllocateCPU();
+
         int ClientNotify(JackClientInterface* client, int refnum, const char* name, int notify, int sync, const char* message, int value1, int value2);
 
         void NotifyClient(int refnum, int event, int sync, const char*  message, int value1, int value2);
         void NotifyClients(int event, int sync, const char*  message,  int value1, int value2);
 
         void NotifyPortRegistation(jack_port_id_t port_index, bool onoff);
+        void NotifyPortRegistation(const jack_int_t* ports, bool onoff);
+        void NotifyBatchStart();
+        void NotifyBatchStop();
         void NotifyPortConnect(jack_port_id_t src, jack_port_id_t dst, bool onoff);
         void NotifyPortRename(jack_port_id_t src, const char* old_name);
         void NotifyActivate(int refnum);
@@ -107,7 +114,7 @@ class SERVER_EXPORT JackEngine : public JackLockAble
         // Client management
         int ClientCheck(const char* name, jack_uuid_t uuid, char* name_res, int protocol, int options, int* status);
 
-        int ClientExternalOpen(const char* name, int pid, jack_uuid_t uuid, int* ref, int* shared_engine, int* shared_client, int* shared_graph_manager);
+        int ClientExternalOpen(const char* name, const char* notify_name, int pid, jack_uuid_t uuid, int* ref, int* shared_engine, int* shared_client, int* shared_graph_manager);
         int ClientInternalOpen(const char* name, int* ref, JackEngineControl** shared_engine, JackGraphManager** shared_manager, JackClientInterface* client, bool wait);
 
         int ClientExternalClose(int refnum);
@@ -120,6 +127,7 @@ class SERVER_EXPORT JackEngine : public JackLockAble
 
         int GetClientPID(const char* name);
         int GetClientRefNum(const char* name);
+        int GetClientCPU(const char* name);
 
         // Internal client management
         int GetInternalClientName(int int_ref, char* name_res);
@@ -128,6 +136,7 @@ class SERVER_EXPORT JackEngine : public JackLockAble
 
         // Port management
         int PortRegister(int refnum, const char* name, const char *type, unsigned int flags, unsigned int buffer_size, jack_port_id_t* port);
+        int PortRegisterMany(int refnum, const char** names, unsigned int count, const char *type, unsigned int flags, unsigned int buffer_size, jack_port_id_t* ports);
         int PortUnRegister(int refnum, jack_port_id_t port);
 
         int PortConnect(int refnum, const char* src, const char* dst);
@@ -140,7 +149,7 @@ class SERVER_EXPORT JackEngine : public JackLockAble
 
         int PortSetDefaultMetadata(jack_port_id_t port, const char* pretty_name);
 
-        int ComputeTotalLatencies();
+        int ComputeTotalLatencies(int refnum);
 
         int PropertyChangeNotify(jack_uuid_t subject, const char* key,jack_property_change_t change);
 
@@ -153,6 +162,7 @@ class SERVER_EXPORT JackEngine : public JackLockAble
         void NotifyFailure(int code, const char* reason);
         void NotifyGraphReorder();
         void NotifyBufferSize(jack_nframes_t buffer_size);
+        void NotifyBufferSizePrepare(jack_nframes_t buffer_size);
         void NotifySampleRate(jack_nframes_t sample_rate);
         void NotifyFreewheel(bool onoff);
         void NotifyQuit();
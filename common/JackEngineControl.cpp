@@ -22,6 +22,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackEngineControl.h"
 #include "JackGraphManager.h"
 #include "JackClientControl.h"
+#include "JackTools.h"
 #include <algorithm>
 #include <math.h>
 
@@ -42,12 +43,19 @@ void JackEngineControl::CalcCPULoad(JackClientInterface** table,
     fCurCycleTime = cur_cycle_begin;
     jack_time_t last_cycle_end = prev_cycle_end;
 
-    // In Asynchronous mode, last cycle end is the max of client end dates
-    if (!fSyncMode) {
-        for (int i = fDriverNum; i < CLIENT_NUM; i++) {
-            JackClientInterface* client = table[i];
-            JackClientTiming* timing = manager->GetClientTiming(i);
-            if (client && client->GetClientControl()->fActive && timing->fStatus == Finished) {
+    if (fPrevCycleTime > 0) {
+        jack_time_t expected = fPrevCycleTime + fPeriodUsecs;
+        fWakeupHistogram.Add((fCurCycleTime > expected) ? fCurCycleTime - expected : 0);
+    }
+
+    for (int i = fDriverNum; i < CLIENT_NUM; i++) {
+        JackClientInterface* client = table[i];
+        JackClientTiming* timing = manager->GetClientTiming(i);
+        // Clients that finished during the previous cycle (and not before, if the graph did not switch)
+        if (client && client->GetClientControl()->fActive && timing->fStatus == Finished && timing->fFinishedAt > fPrevCycleTime) {
+            fClientHistogram[i].fHistogram.Add(timing->fFinishedAt - timing->fAwakeAt);
+            // In Asynchronous mode, last cycle end is the max of client end dates
+            if (!fSyncMode) {
                 last_cycle_end = JACK_MAX(last_cycle_end, timing->fFinishedAt);
             }
         }
@@ -56,6 +64,7 @@ void JackEngineControl::CalcCPULoad(JackClientInterface** table,
     // Store the execution time for later averaging
     if (last_cycle_end > 0) {
         fRollingClientUsecs[fRollingClientUsecsIndex++] = last_cycle_end - fPrevCycleTime;
+        fCycleHistogram.Add(last_cycle_end - fPrevCycleTime);
     }
     if (fRollingClientUsecsIndex >= JACK_ENGINE_ROLLING_COUNT) {
         fRollingClientUsecsIndex = 0;
@@ -97,6 +106,84 @@ void JackEngineControl::ResetRollingUsecs()
     fRollingInterval = int(floor((JACK_ENGINE_ROLLING_INTERVAL * 1000.f) / fPeriodUsecs));
 }
 
+JackTimeHistogram* JackEngineControl::GetHistogram(jack_cycle_histogram_t type, const char* client_name)
+{
+    switch (type) {
+        case JackCycleDuration:
+            return &fCycleHistogram;
+        case JackWakeupLateness:
+            return &fWakeupHistogram;
+        case JackClientCompute:
+            for (int i = fDriverNum; i < CLIENT_NUM && client_name && client_name[0]; i++) {
+                if (strcmp(fClientHistogram[i].fName, client_name) == 0) {
+                    return &fClientHistogram[i].fHistogram;
+                }
+            }
+            return NULL;
+        default:
+            return NULL;
+    }
+}
+
+void JackEngineControl::ResetHistograms()
+{
+    fCycleHistogram.Reset();
+    fWakeupHistogram.Reset();
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        fClientHistogram[i].fHistogram.Reset();
+    }
+}
+
+void JackEngineControl::InitCPUSet(int driver_cpu, const char* client_cpus)
+{
+    fDriverCPU = driver_cpu;
+    fClientCPUCount = 0;
+
+    // SCHED_DEADLINE threads cannot be restricted to a subset of the CPUs : no CPU is assigned (nor reported) to clients
+    if (fSchedDeadline && client_cpus && client_cpus[0] != '\0') {
+        jack_info("Client CPU set '%s' not used with SCHED_DEADLINE scheduling", client_cpus);
+    } else if (client_cpus && client_cpus[0] != '\0') {
+        int cpus[JACK_CPU_SET_SIZE];
+        int domains[JACK_CPU_SET_SIZE];
+        int count = JackTools::ParseCPUList(client_cpus, cpus, JACK_CPU_SET_SIZE);
+        if (count <= 0) {
+            jack_error("Client CPU set '%s' ignored", client_cpus);
+            return;
+        }
+
+        for (int i = 0; i < count; i++) {
+            domains[i] = JackTools::GetCPUCacheDomain(cpus[i]);
+        }
+
+        // Group CPUs by shared cache, starting with the driver one, so that successively placed clients share the driver L3
+        int driver_domain = (driver_cpu >= 0) ? JackTools::GetCPUCacheDomain(driver_cpu) : -1;
+        bool used[JACK_CPU_SET_SIZE] = { false };
+        int domain = driver_domain;
+        while (fClientCPUCount < count) {
+            bool found = false;
+            for (int i = 0; i < count; i++) {
+                if (!used[i] && domains[i] == domain) {
+                    fClientCPUs[fClientCPUCount++] = cpus[i];
+                    used[i] = found = true;
+                }
+            }
+            if (!found) {
+                // Next domain is the one of the first CPU not placed yet
+                for (int i = 0; i < count; i++) {
+                    if (!used[i]) {
+                        domain = domains[i];
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (int i = 0; i < fClientCPUCount; i++) {
+            jack_log("JackEngineControl::InitCPUSet client CPU = %d", fClientCPUs[i]);
+        }
+    }
+}
+
 void JackEngineControl::NotifyXRun(jack_time_t callback_usecs, float delayed_usecs)
 {
     ResetFrameTime(callback_usecs);  
@@ -25,7 +25,9 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackFrameTimer.h"
 #include "JackTransportEngine.h"
 #include "JackConstants.h"
+#include "JackTimeHistogram.h"
 #include "types.h"
+#include "statistics.h"
 #include <stdio.h>
 
 #ifdef JACK_MONITOR
@@ -69,6 +71,20 @@ struct SERVER_EXPORT JackEngineControl : public JackShmMem
     int fDriverNum;
     bool fVerbose;
 
+    // Set when the server releases the segment, clients that keep it mapped between opens then attach again
+    volatile bool fClosed;
+
+    // CPU placement
+    int fDriverCPU;                         // -1 when the driver thread is not pinned
+    int fClientCPUs[JACK_CPU_SET_SIZE];     // Ordered by cache domain, the driver one first
+    int fClientCPUCount;
+
+    // SCHED_DEADLINE mode
+    bool fSchedDeadline;
+
+    // Slave drivers processed in their own threads
+    bool fParallelSlaves;
+
     // CPU Load
     jack_time_t fPrevCycleTime;
     jack_time_t fCurCycleTime;
@@ -80,6 +96,11 @@ struct SERVER_EXPORT JackEngineControl : public JackShmMem
     int	fRollingInterval;
     float fCPULoad;
 
+    // Timing distributions
+    JackTimeHistogram fCycleHistogram;
+    JackTimeHistogram fWakeupHistogram;
+    JackClientHistogram fClientHistogram[CLIENT_NUM];
+
     // For OSX thread
     UInt64 fPeriod;
     UInt64 fComputation;
@@ -92,7 +113,7 @@ struct SERVER_EXPORT JackEngineControl : public JackShmMem
     JackEngineProfiling fProfiler;
 #endif
 
-    JackEngineControl(bool sync, bool temporary, long timeout, bool rt, long priority, bool verbose, jack_timer_type_t clock, const char* server_name)
+    JackEngineControl(bool sync, bool temporary, long timeout, bool rt, long priority, bool verbose, jack_timer_type_t clock, const char* server_name, int driver_cpu, const char* client_cpus, bool sched_deadline, bool parallel_slaves)
     {
         fBufferSize = 512;
         fSampleRate = 48000;
@@ -117,6 +138,11 @@ struct SERVER_EXPORT JackEngineControl : public JackShmMem
         fSpareUsecs = 0;
         fMaxUsecs = 0;
         ResetRollingUsecs();
+        fCycleHistogram.Init();
+        fWakeupHistogram.Init();
+        for (int i = 0; i < CLIENT_NUM; i++) {
+            InitClientHistogram(i, "");
+        }
         strncpy(fServerName, server_name, sizeof(fServerName));
         fServerName[sizeof(fServerName) - 1] = 0;
         fCPULoad = 0.f;
@@ -127,10 +153,16 @@ struct SERVER_EXPORT JackEngineControl : public JackShmMem
         fXrunDelayedUsecs = 0.f;
         fClockSource = clock;
         fDriverNum = 0;
+        fSchedDeadline = rt && sched_deadline;
+        InitCPUSet(driver_cpu, client_cpus);
+        fParallelSlaves = parallel_slaves;
+        fClosed = false;
     }
 
     ~JackEngineControl()
-    {}
+    {
+        fClosed = true;
+    }
 
     void UpdateTimeOut()
     {
@@ -184,6 +216,19 @@ struct SERVER_EXPORT JackEngineControl : public JackShmMem
         fMaxDelayedUsecs = 0.f;
     }
 
+    // CPU placement
+    void InitCPUSet(int driver_cpu, const char* client_cpus);
+
+    // Timing distributions
+    void InitClientHistogram(int refnum, const char* name)
+    {
+        strncpy(fClientHistogram[refnum].fName, name, JACK_CLIENT_NAME_SIZE);
+        fClientHistogram[refnum].fName[JACK_CLIENT_NAME_SIZE] = 0;
+        fClientHistogram[refnum].fHistogram.Init();
+    }
+    JackTimeHistogram* GetHistogram(jack_cycle_histogram_t type, const char* client_name);
+    void ResetHistograms();
+
     // Private
     void CalcCPULoad(JackClientInterface** table, JackGraphManager* manager, jack_time_t cur_cycle_begin, jack_time_t prev_cycle_end);
     void ResetRollingUsecs();
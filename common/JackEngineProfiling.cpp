@@ -31,7 +31,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 namespace Jack
 {
 
-JackEngineProfiling::JackEngineProfiling():fAudioCycle(0),fMeasuredClient(0)
+JackEngineProfiling::JackEngineProfiling():fAudioCycle(0),fMeasuredClient(0),fMeasuredSlave(0)
 {
     jack_info("Engine profiling activated, beware %ld MBytes are needed to record profiling points...", sizeof(fProfileTable) / (1024 * 1024));
 
@@ -86,6 +86,13 @@ JackEngineProfiling::~JackEngineProfiling()
                 }
             }
 
+            // For each measured slave driver: read and write durations
+            for (unsigned int j = 0; j < fMeasuredSlave; j++) {
+                JackTimingMeasureSlave* slave = &fProfileTable[i].fSlaveTable[j];
+                fStream << long(slave->fReadEnd - slave->fReadBegin) << "\t";
+                fStream << long(slave->fWriteEnd - slave->fWriteBegin) << "\t";
+            }
+
             // Terminate line
             fStream << std::endl;
         }
@@ -353,6 +360,9 @@ void JackEngineProfiling::Profile(JackClientInterface** table,
     fProfileTable[fAudioCycle].fCurCycleBegin = cur_cycle_begin;
     fProfileTable[fAudioCycle].fPrevCycleEnd = prev_cycle_end;
     fProfileTable[fAudioCycle].fAudioCycle = fAudioCycle;
+    for (int i = 0; i < MEASURED_SLAVES; i++) {
+        fProfileTable[fAudioCycle].fSlaveTable[i] = JackTimingMeasureSlave();
+    }
 
     for (int i = GetEngineControl()->fDriverNum; i < CLIENT_NUM; i++) {
         JackClientInterface* client = table[i];
@@ -376,6 +386,24 @@ void JackEngineProfiling::Profile(JackClientInterface** table,
     }
 }
 
+void JackEngineProfiling::ProfileSlaveRead(unsigned int index, jack_time_t begin, jack_time_t end)
+{
+    if (index < MEASURED_SLAVES) {
+        fProfileTable[fAudioCycle].fSlaveTable[index].fReadBegin = begin;
+        fProfileTable[fAudioCycle].fSlaveTable[index].fReadEnd = end;
+        fMeasuredSlave = (index + 1 > fMeasuredSlave) ? index + 1 : fMeasuredSlave;
+    }
+}
+
+void JackEngineProfiling::ProfileSlaveWrite(unsigned int index, jack_time_t begin, jack_time_t end)
+{
+    if (index < MEASURED_SLAVES) {
+        fProfileTable[fAudioCycle].fSlaveTable[index].fWriteBegin = begin;
+        fProfileTable[fAudioCycle].fSlaveTable[index].fWriteEnd = end;
+        fMeasuredSlave = (index + 1 > fMeasuredSlave) ? index + 1 : fMeasuredSlave;
+    }
+}
+
 JackTimingMeasure* JackEngineProfiling::GetCurMeasure()
 {
     return &fProfileTable[fAudioCycle];
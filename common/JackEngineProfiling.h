@@ -32,6 +32,7 @@ namespace Jack
 #define FAILURE_TIME_POINTS 10000
 #define FAILURE_WINDOW 10
 #define MEASURED_CLIENTS 32
+#define MEASURED_SLAVES 8
 
 /*!
 \brief Timing structure for a client.
@@ -56,6 +57,27 @@ struct JackTimingMeasureClient
 
 } POST_PACKED_STRUCTURE;
 
+/*!
+\brief Timing structure for a slave driver.
+*/
+
+PRE_PACKED_STRUCTURE
+struct JackTimingMeasureSlave
+{
+    jack_time_t fReadBegin;
+    jack_time_t fReadEnd;
+    jack_time_t fWriteBegin;
+    jack_time_t fWriteEnd;
+
+    JackTimingMeasureSlave()
+        :fReadBegin(0),
+        fReadEnd(0),
+        fWriteBegin(0),
+        fWriteEnd(0)
+    {}
+
+} POST_PACKED_STRUCTURE;
+
 /*!
 \brief Timing interval in the global table for a given client
 */
@@ -88,6 +110,7 @@ struct JackTimingMeasure
     jack_time_t fCurCycleBegin;
     jack_time_t fPrevCycleEnd;
     JackTimingMeasureClient fClientTable[CLIENT_NUM];
+    JackTimingMeasureSlave fSlaveTable[MEASURED_SLAVES];
 
     JackTimingMeasure()
         :fAudioCycle(0), 
@@ -116,6 +139,7 @@ class SERVER_EXPORT JackEngineProfiling
 
         unsigned int fAudioCycle;
         unsigned int fMeasuredClient;
+        unsigned int fMeasuredSlave;
 
         bool CheckClient(const char* name, int cur_point);
 
@@ -129,7 +153,11 @@ class SERVER_EXPORT JackEngineProfiling
                     jack_time_t period_usecs,
                     jack_time_t cur_cycle_begin, 
                     jack_time_t prev_cycle_end);
-                    
+
+        // Called from the master driver thread after the engine cycle has begun
+        void ProfileSlaveRead(unsigned int index, jack_time_t begin, jack_time_t end);
+        void ProfileSlaveWrite(unsigned int index, jack_time_t begin, jack_time_t end);
+
         JackTimingMeasure* GetCurMeasure();
 
 } POST_PACKED_STRUCTURE;
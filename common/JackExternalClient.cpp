@@ -41,11 +41,11 @@ int JackExternalClient::ClientNotify(int refnum, const char* name, int notify, i
     return result;
 }
 
-int JackExternalClient::Open(const char* name, int pid, int refnum, jack_uuid_t uuid, int* shared_client)
+int JackExternalClient::Open(const char* name, const char* notify_name, int pid, int refnum, jack_uuid_t uuid, int* shared_client)
 {
     try {
 
-        if (fChannel.Open(name) < 0) {
+        if (fChannel.Open(notify_name) < 0) {
             jack_error("Cannot connect to client name = %s\n", name);
             return -1;
         }
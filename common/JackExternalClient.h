@@ -46,11 +46,20 @@ class JackExternalClient : public JackClientInterface
         JackExternalClient();
         virtual ~JackExternalClient();
 
-        int Open(const char* name, int pid, int refnum, jack_uuid_t uuid, int* shared_client);
+        int Open(const char* name, const char* notify_name, int pid, int refnum, jack_uuid_t uuid, int* shared_client);
         int Close();
 
         int ClientNotify(int refnum, const char* name, int notify, int sync, const char* message, int value1, int value2);
 
+        void NotifyBatchStart()
+        {
+            fChannel.BatchStart();
+        }
+        void NotifyBatchStop()
+        {
+            fChannel.BatchStop();
+        }
+
         JackClientControl* GetClientControl() const;
 };
 
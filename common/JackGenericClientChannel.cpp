@@ -59,13 +59,16 @@ void JackGenericClientChannel::ServerSyncCall(JackRequest* req, JackResult* res,
         return;
     }
     
-    if (req->Write(fRequest) < 0) {
+    // The request is sent as a single frame when the result is read
+    detail::JackFramedTransaction frame(fRequest);
+
+    if (req->Write(&frame) < 0) {
         jack_error("Could not write request type = %ld", req->fType);
         *result = -1;
         return;
     }
 
-    if (res->Read(fRequest) < 0) {
+    if (res->Read(&frame) < 0) {
         jack_error("Could not read result type = %ld", req->fType);
         *result = -1;
         return;
@@ -89,7 +92,9 @@ void JackGenericClientChannel::ServerAsyncCall(JackRequest* req, JackResult* res
         return;
     }
     
-    if (req->Write(fRequest) < 0) {
+    detail::JackFramedTransaction frame(fRequest);
+
+    if (req->Write(&frame) < 0 || frame.Flush() < 0) {
         jack_error("Could not write request type = %ld", req->fType);
         *result = -1;
     } else {
@@ -116,6 +121,19 @@ void JackGenericClientChannel::ClientOpen(const char* name, int pid, jack_uuid_t
     *shared_graph = res.fSharedGraph;
 }
 
+void JackGenericClientChannel::ClientCheckOpen(const char* name, const char* notify_name, int pid, jack_uuid_t uuid, char* name_res, int protocol, int options, int* status,
+                                               int* shared_engine, int* shared_client, int* shared_graph, int* result)
+{
+    JackClientCheckOpenRequest req(name, notify_name, protocol, options, pid, uuid);
+    JackClientCheckOpenResult res;
+    ServerSyncCall(&req, &res, result);
+    *status |= res.fStatus;
+    strcpy(name_res, res.fName);
+    *shared_engine = res.fSharedEngine;
+    *shared_client = res.fSharedClient;
+    *shared_graph = res.fSharedGraph;
+}
+
 void JackGenericClientChannel::ClientClose(int refnum, int* result)
 {
     JackClientCloseRequest req(refnum);
@@ -145,6 +163,20 @@ void JackGenericClientChannel::PortRegister(int refnum, const char* name, const
     *port_index = res.fPortIndex;
 }
 
+void JackGenericClientChannel::PortRegisterMany(int refnum, const char** names, unsigned int count, const char* type, unsigned int flags, unsigned int buffer_size, jack_port_id_t* port_indexes, int* result)
+{
+    JackPortRegisterManyRequest req(refnum, names, count, type, flags, buffer_size);
+    JackPortRegisterManyResult res;
+    ServerSyncCall(&req, &res, result);
+    if (*result == 0 && res.fPortIndexes.size() != count) {
+        jack_error("JackGenericClientChannel::PortRegisterMany : %d ports expected, %d received", count, res.fPortIndexes.size());
+        *result = -1;
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        port_indexes[i] = (*result == 0) ? res.fPortIndexes[i] : NO_PORT;
+    }
+}
+
 void JackGenericClientChannel::PortUnRegister(int refnum, jack_port_id_t port_index, int* result)
 {
     JackPortUnRegisterRequest req(refnum, port_index);
@@ -201,9 +233,9 @@ void JackGenericClientChannel::SetFreewheel(int onoff, int* result)
     ServerSyncCall(&req, &res, result);
 }
 
-void JackGenericClientChannel::ComputeTotalLatencies(int* result)
+void JackGenericClientChannel::ComputeTotalLatencies(int refnum, int* result)
 {
-    JackComputeTotalLatenciesRequest req;
+    JackComputeTotalLatenciesRequest req(refnum);
     JackResult res;
     ServerSyncCall(&req, &res, result);
 }
@@ -57,12 +57,15 @@ class JackGenericClientChannel : public detail::JackClientChannelInterface
 
         void ClientCheck(const char* name, jack_uuid_t uuid, char* name_res, int protocol, int options, int* status, int* result, int open);
         void ClientOpen(const char* name, int pid, jack_uuid_t uuid, int* shared_engine, int* shared_client, int* shared_graph, int* result);
+        void ClientCheckOpen(const char* name, const char* notify_name, int pid, jack_uuid_t uuid, char* name_res, int protocol, int options, int* status,
+                             int* shared_engine, int* shared_client, int* shared_graph, int* result);
         void ClientClose(int refnum, int* result);
 
         void ClientActivate(int refnum, int is_real_time, int* result);
         void ClientDeactivate(int refnum, int* result);
 
         void PortRegister(int refnum, const char* name, const char* type, unsigned int flags, unsigned int buffer_size, jack_port_id_t* port_index, int* result);
+        void PortRegisterMany(int refnum, const char** names, unsigned int count, const char* type, unsigned int flags, unsigned int buffer_size, jack_port_id_t* port_indexes, int* result);
         void PortUnRegister(int refnum, jack_port_id_t port_index, int* result);
 
         void PortConnect(int refnum, const char* src, const char* dst, int* result);
@@ -76,7 +79,7 @@ class JackGenericClientChannel : public detail::JackClientChannelInterface
         void SetBufferSize(jack_nframes_t buffer_size, int* result);
         void SetFreewheel(int onoff, int* result);
 
-        void ComputeTotalLatencies(int* result);
+        void ComputeTotalLatencies(int refnum, int* result);
 
         void ReleaseTimebase(int refnum, int* result);
         void SetTimebaseCallback(int refnum, int conditional, int* result);
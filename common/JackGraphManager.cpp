@@ -19,11 +19,19 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 */
 
 #include "JackGraphManager.h"
+#include "JackClientControl.h"
 #include "JackConstants.h"
+#include "JackEngineControl.h"
+#include "JackGlobals.h"
 #include "JackError.h"
+#include "JackPortType.h"
 #include <assert.h>
 #include <stdlib.h>
+#include <math.h>
 #include <algorithm>
+#include <vector>
+#include <set>
+#include <string>
 #ifdef HAVE_TRE_REGEX_H
 #include <tre/regex.h>
 #else
@@ -72,6 +80,12 @@ JackGraphManager::JackGraphManager(int port_max)
     }
 
     fPortMax = port_max;
+    fCycle = 0;
+    fBlockCycle = 0;
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        fBlockRunning[i] = false;
+    }
+    memset(fPortTypeInfo, 0, sizeof(fPortTypeInfo));
 }
 
 JackPort* JackGraphManager::GetPort(jack_port_id_t port_index)
@@ -85,6 +99,46 @@ jack_default_audio_sample_t* JackGraphManager::GetBuffer(jack_port_id_t port_ind
     return fPortArray[port_index].GetBuffer();
 }
 
+// Server : a type keeps its slot, thus its id, until the server is closed
+int JackGraphManager::RegisterPortType(const char* port_type, size_t buffer_size)
+{
+    int slot = FindPortType(port_type);
+
+    if (slot >= 0) {
+        if (buffer_size != 0 && buffer_size != fPortTypeInfo[slot].fSize) {
+            jack_error("JackGraphManager::RegisterPortType port type = %s already uses buffer size = %ld", port_type, fPortTypeInfo[slot].fSize);
+            return -1;
+        }
+        return slot;
+    }
+
+    if (buffer_size == 0 || buffer_size > BUFFER_SIZE_MAX * sizeof(jack_default_audio_sample_t) || strlen(port_type) > JACK_PORT_TYPE_SIZE) {
+        jack_error("JackGraphManager::RegisterPortType incorrect port type = %s buffer size = %ld", port_type, buffer_size);
+        return -1;
+    }
+
+    for (slot = 0; slot < CUSTOM_PORT_TYPE_NUM; slot++) {
+        if (fPortTypeInfo[slot].fName[0] == 0) {
+            fPortTypeInfo[slot].fSize = buffer_size;
+            strcpy(fPortTypeInfo[slot].fName, port_type);
+            return slot;
+        }
+    }
+
+    jack_error("JackGraphManager::RegisterPortType no more slot for port type = %s", port_type);
+    return -1;
+}
+
+int JackGraphManager::FindPortType(const char* port_type)
+{
+    for (int slot = 0; slot < CUSTOM_PORT_TYPE_NUM && fPortTypeInfo[slot].fName[0] != 0; slot++) {
+        if (strcmp(fPortTypeInfo[slot].fName, port_type) == 0) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
 // Server
 void JackGraphManager::InitRefNum(int refnum)
 {
@@ -98,6 +152,7 @@ void JackGraphManager::RunCurrentGraph()
 {
     JackConnectionManager* manager = ReadCurrentState();
     manager->ResetGraph(fClientTiming);
+    fCycle++;
 }
 
 // RT
@@ -106,6 +161,7 @@ bool JackGraphManager::RunNextGraph()
     bool res;
     JackConnectionManager* manager = TrySwitchState(&res);
     manager->ResetGraph(fClientTiming);
+    fCycle++;
     return res;
 }
 
@@ -120,7 +176,11 @@ bool JackGraphManager::IsFinishedGraph()
 int JackGraphManager::ResumeRefNum(JackClientControl* control, JackSynchro* table)
 {
     JackConnectionManager* manager = ReadCurrentState();
-    return manager->ResumeRefNum(control, table, fClientTiming);
+    // A multi-rate client has finished its block (see CopyPipelinedBuffers)
+    fBlockRunning[control->fRefNum] = false;
+    int res = manager->ResumeRefNum(control, table, fClientTiming);
+    UpdateOutputMeters(manager, control->fRefNum);
+    return res;
 }
 
 // RT
@@ -168,13 +228,21 @@ bool JackGraphManager::IsDirectConnection(int ref1, int ref2)
     return manager->IsDirectConnection(ref1, ref2);
 }
 
+/*
+Input buffers are resolved once per cycle : the mix (or the zero-copy source) is kept in the port with the cycle, graph state
+and buffer size it was computed for, so that clients calling jack_port_get_buffer several times per cycle get the same buffer
+for free (and connection gains are ramped once). The resolved buffer is kept as an offset in the graph manager, which is
+the same in all processes, except for the silence buffer which is local to each process. Only the thread running the cycle
+of the client ('in_cycle') keeps what it resolves : another thread may run before the upstream clients have produced the
+cycle data.
+*/
+
 // RT
-void* JackGraphManager::GetBuffer(jack_port_id_t port_index, jack_nframes_t buffer_size)
+void* JackGraphManager::GetBuffer(jack_port_id_t port_index, jack_nframes_t buffer_size, bool in_cycle)
 {
     AssertPort(port_index);
     AssertBufferSize(buffer_size);
 
-    JackConnectionManager* manager = ReadCurrentState();
     JackPort* port = GetPort(port_index);
 
     // This happens when a port has just been unregistered and is still used by the RT code
@@ -183,17 +251,98 @@ void* JackGraphManager::GetBuffer(jack_port_id_t port_index, jack_nframes_t buff
         return GetBuffer(0); // port_index 0 is not used
     }
 
-    jack_int_t len = manager->Connections(port_index);
-
     // Output port
     if (port->fFlags & JackPortIsOutput) {
-        return (port->fTied != NO_PORT) ? GetBuffer(port->fTied, buffer_size) : GetBuffer(port_index);
+        return (port->fTied != NO_PORT) ? GetBuffer(port->fTied, buffer_size, in_cycle) : GetBuffer(port_index);
+    }
+
+    UInt32 cycle = fCycle;
+    UInt16 state = GetCurrentIndex();
+
+    if (port->fBufferFrames == buffer_size && port->fBufferCycle == cycle && port->fBufferState == state) {
+        return (port->fBufferOffset == 0) ? const_cast<void*>(GetPortType(port->fTypeId)->silence()) : (char*)this + port->fBufferOffset;
     }
 
-    // No connections : return a zero-filled buffer
+    void* buffer = GetBufferAux(ReadCurrentState(), port_index, buffer_size);
+    if (!in_cycle) {
+        return buffer;
+    }
+
+    // The state index is read first : if the state switches meanwhile, the next call sees a new index and resolves again
+    port->fBufferOffset = (buffer >= (void*)this && buffer < (void*)&fPortArray[fPortMax]) ? UInt32((char*)buffer - (char*)this) : 0;
+    port->fBufferCycle = cycle;
+    port->fBufferState = state;
+    port->fBufferFrames = buffer_size;
+    return buffer;
+}
+
+// RT
+void* JackGraphManager::GetBufferAux(JackConnectionManager* manager, jack_port_id_t port_index, jack_nframes_t buffer_size)
+{
+    JackPort* port = GetPort(port_index);
+
+    // Connected input port of a pipelined client : mixed by the server before the cycle (see CopyPipelinedBuffers),
+    // in the copy slot accumulating the block for a multi-rate client
+    if (manager->IsPipelined(port->fRefNum) && manager->Connections(port_index) > 0) {
+        return (port->fCopy != NO_PORT) ? GetBuffer(port->fCopy) : port->GetBuffer();
+    } else {
+        return MixBufferAux(manager, port_index, buffer_size);
+    }
+}
+
+// RT : an output port of a pipelined client is seen by the other clients through the copy of its previous cycle,
+// the one of a multi-rate client is seen by all ports through the current buffer of the copy of its last block,
+// starting with the exchange where the block was handed over (see CopyPipelinedBuffers)
+void* JackGraphManager::GetSourceBuffer(JackConnectionManager* manager, JackPort* port, jack_port_id_t src_index, jack_nframes_t buffer_size)
+{
+    JackPort* src_port = GetPort(src_index);
+    jack_port_id_t copy_index = src_port->fCopy;
+    int src_ref = src_port->fRefNum;
+
+    if (copy_index != NO_PORT && manager->GetBlockMultiplier(src_ref) > 1) {
+        return GetBuffer(copy_index) + manager->GetBlockPhase(src_ref, fBlockCycle + 1) * buffer_size;
+    } else if (copy_index != NO_PORT && manager->IsPipelinedConnection(src_ref, port->fRefNum)) {
+        return GetBuffer(copy_index);
+    } else {
+        return GetBuffer(src_index, buffer_size);
+    }
+}
+
+// RT
+void* JackGraphManager::MixBufferAux(JackConnectionManager* manager, jack_port_id_t port_index, jack_nframes_t buffer_size)
+{
+    JackPort* port = GetPort(port_index);
+    jack_int_t len = manager->Connections(port_index);
+    void* buffer;
+
+    // No connections : return the shared read-only silence buffer, or a zero-filled buffer
     if (len == 0) {
-        port->ClearBuffer(buffer_size);
-        return port->GetBuffer();
+        const JackPortType* type = GetPortType(port->fTypeId);
+        if (type->silence) {
+            buffer = const_cast<void*>(type->silence());
+        } else {
+            port->ClearBuffer(buffer_size);
+            buffer = port->GetBuffer();
+        }
+
+    // Some connections have a gain or mute setting : mix all buffers with their gain
+    } else if (*port->GetGainCount() > 0) {
+
+        const jack_int_t* connections = manager->GetConnections(port_index);
+        void* buffers[CONNECTION_NUM_FOR_PORT];
+        jack_port_id_t src_ports[CONNECTION_NUM_FOR_PORT];
+        jack_default_audio_sample_t start_gains[CONNECTION_NUM_FOR_PORT];
+        jack_default_audio_sample_t end_gains[CONNECTION_NUM_FOR_PORT];
+        int i;
+
+        for (i = 0; (i < CONNECTION_NUM_FOR_PORT) && ((src_ports[i] = connections[i]) != EMPTY); i++) {
+            AssertPort(src_ports[i]);
+            buffers[i] = GetSourceBuffer(manager, port, src_ports[i], buffer_size);
+        }
+
+        port->GetGains(src_ports, i, start_gains, end_gains, true);
+        port->MixBuffers(buffers, start_gains, end_gains, i, buffer_size);
+        buffer = port->GetBuffer();
 
     // One connection
     } else if (len == 1) {
@@ -202,12 +351,12 @@ void* JackGraphManager::GetBuffer(jack_port_id_t port_index, jack_nframes_t buff
         // Ports in same client : copy the buffer
         if (GetPort(src_index)->GetRefNum() == port->GetRefNum()) {
             void* buffers[1];
-            buffers[0] = GetBuffer(src_index, buffer_size);
+            buffers[0] = GetSourceBuffer(manager, port, src_index, buffer_size);
             port->MixBuffers(buffers, 1, buffer_size);
-            return port->GetBuffer();
+            buffer = port->GetBuffer();
         // Otherwise, use zero-copy mode, just pass the buffer of the connected (output) port.
         } else {
-            return GetBuffer(src_index, buffer_size);
+            buffer = GetSourceBuffer(manager, port, src_index, buffer_size);
         }
 
     // Multiple connections : mix all buffers
@@ -220,11 +369,153 @@ void* JackGraphManager::GetBuffer(jack_port_id_t port_index, jack_nframes_t buff
 
         for (i = 0; (i < CONNECTION_NUM_FOR_PORT) && ((src_index = connections[i]) != EMPTY); i++) {
             AssertPort(src_index);
-            buffers[i] = GetBuffer(src_index, buffer_size);
+            buffers[i] = GetSourceBuffer(manager, port, src_index, buffer_size);
         }
 
         port->MixBuffers(buffers, i, buffer_size);
-        return port->GetBuffer();
+        buffer = port->GetBuffer();
+    }
+
+    // Input port metering is a by-product of the mix
+    if (fPortMeter[port_index].fEnabled) {
+        UpdateMeter(port_index, buffer, buffer_size);
+    }
+    return buffer;
+}
+
+// Client
+int JackGraphManager::SetMetering(jack_port_id_t port_index, bool onoff)
+{
+    AssertPort(port_index);
+    JackPortMeter* meter = &fPortMeter[port_index];
+
+    if (onoff) {
+        const JackPortType* type = GetPortType(GetPort(port_index)->fTypeId);
+        if (!type || !type->meter) {
+            jack_error("Port type of port %ld does not support metering", port_index);
+            return -1;
+        }
+        meter->fPeak = meter->fRMS = meter->fHeldPeak = meter->fHoldPeak = 0.f;
+        meter->fHoldFrames = 0;
+    }
+    meter->fEnabled = onoff;
+    return 0;
+}
+
+// Client
+int JackGraphManager::GetMeter(jack_port_id_t port_index, jack_default_audio_sample_t* peak, jack_default_audio_sample_t* rms)
+{
+    AssertPort(port_index);
+    JackPortMeter* meter = &fPortMeter[port_index];
+
+    if (!meter->fEnabled) {
+        return -1;
+    }
+
+    // Read only : the meter is shared by all readers, the peak is held by the process metering the port
+    *peak = meter->fPeak;
+    *rms = meter->fRMS;
+    return 0;
+}
+
+// Client : lock-free, the setting is read by the RT mix of the destination port
+int JackGraphManager::SetConnectionGain(jack_port_id_t port_src, jack_port_id_t port_dst, jack_default_audio_sample_t gain, int mute)
+{
+    AssertPort(port_src);
+    AssertPort(port_dst);
+    JackPort* dst = GetPort(port_dst);
+
+    if (!IsConnected(port_src, port_dst)) {
+        jack_error("JackGraphManager::SetConnectionGain ports are not connected port_src = %ld port_dst = %ld", port_src, port_dst);
+        return -1;
+    }
+
+    const JackPortType* type = GetPortType(dst->fTypeId);
+    if (!type || !type->mixdown_gain) {
+        jack_error("Port type of port %s does not support connection gain", dst->fName);
+        return -1;
+    }
+
+    JackConnectionGain* connection_gain = dst->AllocateGain(port_src);
+    if (!connection_gain) {
+        // Reclaim slots left by connections that have been removed, then retry
+        for (int i = 0; i < CONNECTION_GAIN_NUM_FOR_PORT; i++) {
+            jack_port_id_t src = dst->GetGain(i)->fSource;
+            if (src != NO_PORT && !IsConnected(src, port_dst)) {
+                dst->ReleaseGain(src);
+            }
+        }
+        if (!(connection_gain = dst->AllocateGain(port_src))) {
+            jack_error("JackGraphManager::SetConnectionGain no more gain slot for port %s", dst->fName);
+            return -1;
+        }
+    }
+
+    // A negative value leaves the corresponding setting unchanged
+    if (gain >= 0.f) {
+        connection_gain->fGain = gain;
+    }
+    if (mute >= 0) {
+        connection_gain->fMute = mute;
+    }
+    return 0;
+}
+
+// Client
+int JackGraphManager::GetConnectionGain(jack_port_id_t port_src, jack_port_id_t port_dst, jack_default_audio_sample_t* gain, int* mute)
+{
+    AssertPort(port_src);
+    AssertPort(port_dst);
+
+    if (!IsConnected(port_src, port_dst)) {
+        return -1;
+    }
+
+    JackConnectionGain* connection_gain = GetPort(port_dst)->FindGain(port_src);
+    *gain = (connection_gain) ? connection_gain->fGain : 1.f;
+    *mute = (connection_gain) ? connection_gain->fMute : 0;
+    return 0;
+}
+
+// RT : levels of a buffer of the port in the cycle, the mix of an input port or what the client of an output port has produced
+void JackGraphManager::UpdateMeter(jack_port_id_t port_index, void* buffer, jack_nframes_t frames)
+{
+    JackPortMeter* meter = &fPortMeter[port_index];
+    jack_default_audio_sample_t peak = 0.f;
+    jack_default_audio_sample_t power = 0.f;
+
+    if (frames == 0) {
+        return;
+    }
+
+    GetPortType(GetPort(port_index)->fTypeId)->meter(buffer, frames, &peak, &power);
+
+    // A new hold period starts : the peak of the one just ended stays published during it
+    if (meter->fHoldFrames >= GetEngineControl()->fSampleRate / METER_PEAK_HOLD_RATE) {
+        meter->fHeldPeak = meter->fHoldPeak;
+        meter->fHoldPeak = 0.f;
+        meter->fHoldFrames = 0;
+    }
+    if (peak > meter->fHoldPeak) {
+        meter->fHoldPeak = peak;
+    }
+    meter->fHoldFrames += frames;
+
+    meter->fPeak = (meter->fHeldPeak > meter->fHoldPeak) ? meter->fHeldPeak : meter->fHoldPeak;
+    meter->fRMS = sqrtf(power / frames);
+}
+
+// RT : output ports are metered by their client (or driver) when it has produced them, after resuming the graph
+void JackGraphManager::UpdateOutputMeters(JackConnectionManager* manager, int refnum)
+{
+    const jack_int_t* output_ports = manager->GetOutputPorts(refnum);
+    jack_nframes_t frames = GetEngineControl()->fBufferSize * manager->GetBlockMultiplier(refnum);
+
+    for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (output_ports[i] != EMPTY); i++) {
+        if (fPortMeter[output_ports[i]].fEnabled) {
+            JackPort* port = GetPort(output_ports[i]);
+            UpdateMeter(output_ports[i], GetBuffer((port->fTied != NO_PORT) ? port->fTied : output_ports[i]), frames);
+        }
     }
 }
 
@@ -257,28 +548,167 @@ int JackGraphManager::RequestMonitor(jack_port_id_t port_index, bool onoff) // C
     return 0;
 }
 
-// Client
-jack_nframes_t JackGraphManager::ComputeTotalLatencyAux(jack_port_id_t port_index, jack_port_id_t src_port_index, JackConnectionManager* manager, int hop_count)
+/*
+Total latency of a port : its own latency plus the maximum of the sums of latencies along every connection path
+from the port to a terminal port, downstream for an output port and upstream for an input port. Inside a client,
+all ports are assumed to depend on each other (like the default latency callback does), so a path entering a client
+continues from all its ports of the other direction. Ports and clients are the nodes of a graph, visited once by a
+depth first search : the whole graph is computed in linear time. A feedback loop (a strongly connected component of
+this graph, found by Tarjan's algorithm while searching) gets a value which does not depend on where the search
+enters it : each of its nodes gets its own latency plus the longest path leaving the loop, the connections inside
+the loop are not counted.
+*/
+
+struct JackLatencyEdge
 {
-    const jack_int_t* connections = ReadCurrentState()->GetConnections(port_index);
-    jack_nframes_t max_latency = 0;
-    jack_port_id_t dst_index;
+    int fNode;                  // Port index or client node, -1 when the path ends on a terminal port
+    jack_nframes_t fLatency;
+};
+
+struct JackTotalLatencyContext
+{
+    bool fDownstream;
+    int fClientNode;                    // Node of the client of refnum 0, the port nodes come first
+    std::vector<jack_nframes_t> fLatency;
+    std::vector<int> fIndex;            // Visit order, -1 when not visited yet
+    std::vector<int> fLowLink;
+    std::vector<char> fOnStack;
+    std::vector<int> fStack;
+    std::vector<JackLatencyEdge> fEdges;    // Edges of the nodes being searched, used as a stack
+    int fVisited;
+
+    JackTotalLatencyContext(unsigned int port_max, bool downstream)
+        : fDownstream(downstream), fClientNode(port_max),
+        fLatency(port_max + CLIENT_NUM, 0), fIndex(port_max + CLIENT_NUM, -1), fLowLink(port_max + CLIENT_NUM, 0),
+        fOnStack(port_max + CLIENT_NUM, false), fVisited(0)
+    {}
+};
+
+// Client : own latency of a node, the latencies of the connections leaving it are added to the edges stack
+jack_nframes_t JackGraphManager::GetLatencyEdges(JackTotalLatencyContext* context, int node, JackConnectionManager* manager)
+{
+    std::vector<JackLatencyEdge>* edges = &context->fEdges;
+
+    // A client leads to all its ports of the search direction
+    if (node >= context->fClientNode) {
+        int refnum = node - context->fClientNode;
+        const jack_int_t* ports = (context->fDownstream) ? manager->GetOutputPorts(refnum) : manager->GetInputPorts(refnum);
+        for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (ports[i] != EMPTY); i++) {
+            JackLatencyEdge edge = { int(ports[i]), 0 };
+            edges->push_back(edge);
+        }
+        return 0;
+    }
 
-    if (hop_count > 8)
-        return GetPort(port_index)->GetLatency();
+    // A port leads to the clients owning the connected ports
+    JackPort* port = GetPort(node);
+    const jack_int_t* connections = manager->GetConnections(node);
+    jack_port_id_t other_index;
+
+    for (int i = 0; (i < CONNECTION_NUM_FOR_PORT) && ((other_index = connections[i]) != EMPTY); i++) {
+        AssertPort(other_index);
+        JackPort* other_port = GetPort(other_index);
+        JackLatencyEdge edge = { -1, other_port->GetLatency() };
+
+        // Data crosses cycles
+        edge.fLatency += GetEngineControl()->fBufferSize * ((context->fDownstream)
+            ? manager->GetConnectionCycles(port->fRefNum, other_port->fRefNum)
+            : manager->GetConnectionCycles(other_port->fRefNum, port->fRefNum));
+
+        // The path continues through the client owning the connected port
+        int refnum = other_port->fRefNum;
+        if (!(other_port->fFlags & JackPortIsTerminal) && refnum >= 0 && refnum < CLIENT_NUM) {
+            edge.fNode = context->fClientNode + refnum;
+        }
+        edges->push_back(edge);
+    }
+    return port->GetLatency();
+}
 
-    for (int i = 0; (i < CONNECTION_NUM_FOR_PORT) && ((dst_index = connections[i]) != EMPTY); i++) {
-        if (src_port_index != dst_index) {
-            AssertPort(dst_index);
-            JackPort* dst_port = GetPort(dst_index);
-            jack_nframes_t this_latency = (dst_port->fFlags & JackPortIsTerminal)
-                                          ? dst_port->GetLatency()
-                                          : ComputeTotalLatencyAux(dst_index, port_index, manager, hop_count + 1);
-            max_latency = ((max_latency > this_latency) ? max_latency : this_latency);
+// Client : longest path of the connections in [begin, end) of the edges stack, the ones to nodes of the loop being
+// computed (still stacked) are not counted
+static jack_nframes_t GetExitLatency(JackTotalLatencyContext* context, size_t begin, size_t end)
+{
+    jack_nframes_t exit_latency = 0;
+    for (size_t i = begin; i < end; i++) {
+        const JackLatencyEdge& edge = context->fEdges[i];
+        if (edge.fNode < 0) {
+            exit_latency = std::max(exit_latency, edge.fLatency);
+        } else if (!context->fOnStack[edge.fNode]) {
+            exit_latency = std::max(exit_latency, edge.fLatency + context->fLatency[edge.fNode]);
         }
     }
+    return exit_latency;
+}
 
-    return max_latency + GetPort(port_index)->GetLatency();
+// Client
+void JackGraphManager::ComputeLatencyNode(JackTotalLatencyContext* context, int node, JackConnectionManager* manager)
+{
+    std::vector<JackLatencyEdge>& edges = context->fEdges;
+    size_t begin = edges.size();
+    context->fIndex[node] = context->fLowLink[node] = context->fVisited++;
+    context->fStack.push_back(node);
+    context->fOnStack[node] = true;
+
+    jack_nframes_t own_latency = GetLatencyEdges(context, node, manager);
+    size_t end = edges.size();
+    for (size_t i = begin; i < end; i++) {
+        int next = edges[i].fNode;
+        if (next < 0) {
+            continue;
+        } else if (context->fIndex[next] < 0) {
+            ComputeLatencyNode(context, next, manager);
+            context->fLowLink[node] = std::min(context->fLowLink[node], context->fLowLink[next]);
+        } else if (context->fOnStack[next]) {
+            context->fLowLink[node] = std::min(context->fLowLink[node], context->fIndex[next]);
+        }
+    }
+
+    // Not the first node of its loop : the loop is computed when the search is back to it
+    if (context->fLowLink[node] != context->fIndex[node]) {
+        edges.resize(begin);
+        return;
+    }
+
+    // Not in a loop : all the nodes it leads to are known
+    if (context->fStack.back() == node) {
+        context->fOnStack[node] = false;
+        context->fLatency[node] = own_latency + GetExitLatency(context, begin, end);
+        context->fStack.pop_back();
+        edges.resize(begin);
+        return;
+    }
+    edges.resize(begin);
+
+    // The nodes of the loop are the ones stacked from this node, nodes still stacked below belong to other loops
+    size_t first = context->fStack.size() - 1;
+    while (context->fStack[first] != node) {
+        first--;
+    }
+
+    jack_nframes_t exit_latency = 0;
+    for (size_t i = first; i < context->fStack.size(); i++) {
+        GetLatencyEdges(context, context->fStack[i], manager);
+        exit_latency = std::max(exit_latency, GetExitLatency(context, begin, edges.size()));
+        edges.resize(begin);
+    }
+
+    for (size_t i = first; i < context->fStack.size(); i++) {
+        int loop_node = context->fStack[i];
+        context->fLatency[loop_node] = GetLatencyEdges(context, loop_node, manager) + exit_latency;
+        context->fOnStack[loop_node] = false;
+        edges.resize(begin);
+    }
+    context->fStack.resize(first);
+}
+
+// Client
+jack_nframes_t JackGraphManager::ComputeTotalLatencyAux(JackTotalLatencyContext* context, jack_port_id_t port_index, JackConnectionManager* manager)
+{
+    if (context->fIndex[port_index] < 0) {
+        ComputeLatencyNode(context, port_index, manager);
+    }
+    return context->fLatency[port_index];
 }
 
 // Client
@@ -291,7 +721,8 @@ int JackGraphManager::ComputeTotalLatency(jack_port_id_t port_index)
 
     do {
         cur_index = GetCurrentIndex();
-        port->fTotalLatency = ComputeTotalLatencyAux(port_index, port_index, ReadCurrentState(), 0);
+        JackTotalLatencyContext context(fPortMax, (port->fFlags & JackPortIsOutput) != 0);
+        port->fTotalLatency = ComputeTotalLatencyAux(&context, port_index, ReadCurrentState());
         next_index = GetCurrentIndex();
     } while (cur_index != next_index); // Until a coherent state has been read
 
@@ -299,25 +730,39 @@ int JackGraphManager::ComputeTotalLatency(jack_port_id_t port_index)
     return 0;
 }
 
-// Client
+// Server : all ports share the same context, so that each one is computed once
 int JackGraphManager::ComputeTotalLatencies()
 {
-    jack_port_id_t port_index;
-    for (port_index = FIRST_AVAILABLE_PORT; port_index < fPortMax; port_index++) {
-        JackPort* port = GetPort(port_index);
-        if (port->IsUsed()) {
-            ComputeTotalLatency(port_index);
+    UInt16 cur_index;
+    UInt16 next_index;
+
+    do {
+        cur_index = GetCurrentIndex();
+        JackConnectionManager* manager = ReadCurrentState();
+        // One context per direction, since the client latencies differ
+        JackTotalLatencyContext downstream(fPortMax, true);
+        JackTotalLatencyContext upstream(fPortMax, false);
+        for (jack_port_id_t port_index = FIRST_AVAILABLE_PORT; port_index < fPortMax; port_index++) {
+            JackPort* port = GetPort(port_index);
+            if (port->IsUsed()) {
+                port->fTotalLatency = ComputeTotalLatencyAux((port->fFlags & JackPortIsOutput) ? &downstream : &upstream, port_index, manager);
+            }
         }
-    }
+        next_index = GetCurrentIndex();
+    } while (cur_index != next_index); // Until a coherent state has been read
+
     return 0;
 }
 
-void JackGraphManager::RecalculateLatencyAux(jack_port_id_t port_index, jack_latency_callback_mode_t mode)
+void JackGraphManager::GetConnectedLatencyRange(JackConnectionManager* manager, jack_port_id_t port_index, jack_latency_callback_mode_t mode, jack_latency_range_t* latency)
 {
-    const jack_int_t* connections = ReadCurrentState()->GetConnections(port_index);
-    JackPort* port = GetPort(port_index);
-    jack_latency_range_t latency = { UINT32_MAX, 0 };
+    const jack_int_t* connections = manager->GetConnections(port_index);
     jack_port_id_t dst_index;
+    JackPort* port = GetPort(port_index);
+    int refnum = port->fRefNum;
+
+    latency->min = UINT32_MAX;
+    latency->max = 0;
 
     for (int i = 0; (i < CONNECTION_NUM_FOR_PORT) && ((dst_index = connections[i]) != EMPTY); i++) {
         AssertPort(dst_index);
@@ -326,19 +771,31 @@ void JackGraphManager::RecalculateLatencyAux(jack_port_id_t port_index, jack_lat
 
         dst_port->GetLatencyRange(mode, &other_latency);
 
-        if (other_latency.max > latency.max) {
-			latency.max = other_latency.max;
+        // Data crosses cycles
+        jack_nframes_t delay = GetEngineControl()->fBufferSize * ((port->fFlags & JackPortIsOutput)
+            ? manager->GetConnectionCycles(refnum, dst_port->fRefNum)
+            : manager->GetConnectionCycles(dst_port->fRefNum, refnum));
+        other_latency.min += delay;
+        other_latency.max += delay;
+
+        if (other_latency.max > latency->max) {
+			latency->max = other_latency.max;
         }
-		if (other_latency.min < latency.min) {
-			latency.min = other_latency.min;
+		if (other_latency.min < latency->min) {
+			latency->min = other_latency.min;
         }
     }
 
-    if (latency.min == UINT32_MAX) {
-		latency.min = 0;
+    if (latency->min == UINT32_MAX) {
+		latency->min = 0;
     }
+}
 
-	port->SetLatencyRange(mode, &latency);
+void JackGraphManager::RecalculateLatencyAux(jack_port_id_t port_index, jack_latency_callback_mode_t mode)
+{
+    jack_latency_range_t latency;
+    GetConnectedLatencyRange(ReadCurrentState(), port_index, mode, &latency);
+	GetPort(port_index)->SetLatencyRange(mode, &latency);
 }
 
 void JackGraphManager::RecalculateLatency(jack_port_id_t port_index, jack_latency_callback_mode_t mode)
@@ -355,6 +812,70 @@ void JackGraphManager::RecalculateLatency(jack_port_id_t port_index, jack_latenc
     //jack_log("JackGraphManager::RecalculateLatency port_index = %ld", port_index);
 }
 
+static bool SetLatencyRangeIfChanged(JackPort* port, jack_latency_callback_mode_t mode, jack_latency_range_t* latency, bool apply)
+{
+    jack_latency_range_t old_latency;
+    port->GetLatencyRange(mode, &old_latency);
+    if (old_latency.min == latency->min && old_latency.max == latency->max) {
+        return false;
+    }
+    if (apply) {
+        port->SetLatencyRange(mode, latency);
+    }
+    return true;
+}
+
+// Server : ranges of the client ports which are set from their connections (input ports in capture mode, output ports in playback mode),
+// returns true if one of them changes. They are only checked when 'apply' is false, the client will set them itself.
+bool JackGraphManager::RecalculateLatencies(int refnum, jack_latency_callback_mode_t mode, bool apply)
+{
+    JackConnectionManager* manager = ReadCurrentState();
+    const jack_int_t* ports = (mode == JackCaptureLatency) ? manager->GetInputPorts(refnum) : manager->GetOutputPorts(refnum);
+    bool changed = false;
+
+    for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (ports[i] != EMPTY); i++) {
+        jack_latency_range_t latency;
+        GetConnectedLatencyRange(manager, ports[i], mode, &latency);
+        changed |= SetLatencyRangeIfChanged(GetPort(ports[i]), mode, &latency, apply);
+        if (changed && !apply) {
+            break;
+        }
+    }
+    return changed;
+}
+
+// Server : what JackClient::HandleLatencyCallback does without latency callback, all ports are assumed to depend on each other.
+// Returns true if a range changes.
+bool JackGraphManager::PropagateLatencies(int refnum, jack_latency_callback_mode_t mode)
+{
+    JackConnectionManager* manager = ReadCurrentState();
+    const jack_int_t* from_ports = (mode == JackCaptureLatency) ? manager->GetInputPorts(refnum) : manager->GetOutputPorts(refnum);
+    const jack_int_t* to_ports = (mode == JackCaptureLatency) ? manager->GetOutputPorts(refnum) : manager->GetInputPorts(refnum);
+    jack_latency_range_t latency = { UINT32_MAX, 0 };
+    bool changed = false;
+    int i;
+
+    for (i = 0; (i < PORT_NUM_FOR_CLIENT) && (from_ports[i] != EMPTY); i++) {
+        jack_latency_range_t other_latency;
+        GetPort(from_ports[i])->GetLatencyRange(mode, &other_latency);
+        if (other_latency.max > latency.max) {
+            latency.max = other_latency.max;
+        }
+        if (other_latency.min < latency.min) {
+            latency.min = other_latency.min;
+        }
+    }
+
+    if (latency.min == UINT32_MAX) {
+        latency.min = 0;
+    }
+
+    for (i = 0; (i < PORT_NUM_FOR_CLIENT) && (to_ports[i] != EMPTY); i++) {
+        changed |= SetLatencyRangeIfChanged(GetPort(to_ports[i]), mode, &latency, true);
+    }
+    return changed;
+}
+
 // Server
 void JackGraphManager::SetBufferSize(jack_nframes_t buffer_size)
 {
@@ -370,14 +891,14 @@ void JackGraphManager::SetBufferSize(jack_nframes_t buffer_size)
 }
 
 // Server
-jack_port_id_t JackGraphManager::AllocatePortAux(int refnum, const char* port_name, const char* port_type, JackPortFlags flags)
+jack_port_id_t JackGraphManager::AllocatePortAux(int refnum, const char* port_name, const char* port_type, JackPortFlags flags, jack_port_id_t first)
 {
     jack_port_id_t port_index;
 
     // Available ports start at FIRST_AVAILABLE_PORT (= 1), otherwise a port_index of 0 is "seen" as a NULL port by the external API...
-    for (port_index = FIRST_AVAILABLE_PORT; port_index < fPortMax; port_index++) {
+    for (port_index = first; port_index < fPortMax; port_index++) {
         JackPort* port = GetPort(port_index);
-        if (!port->IsUsed()) {
+        if (!port->IsUsed() && !port->fIsCopy) {
             jack_log("JackGraphManager::AllocatePortAux port_index = %ld name = %s type = %s", port_index, port_name, port_type);
             if (!port->Allocate(refnum, port_name, port_type, flags)) {
                 return NO_PORT;
@@ -391,9 +912,15 @@ jack_port_id_t JackGraphManager::AllocatePortAux(int refnum, const char* port_na
 
 // Server
 jack_port_id_t JackGraphManager::AllocatePort(int refnum, const char* port_name, const char* port_type, JackPortFlags flags, jack_nframes_t buffer_size)
+{
+    return AllocatePortAux(refnum, port_name, port_type, flags, buffer_size, FIRST_AVAILABLE_PORT);
+}
+
+// Server
+jack_port_id_t JackGraphManager::AllocatePortAux(int refnum, const char* port_name, const char* port_type, JackPortFlags flags, jack_nframes_t buffer_size, jack_port_id_t first)
 {
     JackConnectionManager* manager = WriteNextStateStart();
-    jack_port_id_t port_index = AllocatePortAux(refnum, port_name, port_type, flags);
+    jack_port_id_t port_index = AllocatePortAux(refnum, port_name, port_type, flags, first);
 
     if (port_index != NO_PORT) {
         JackPort* port = GetPort(port_index);
@@ -401,10 +928,27 @@ jack_port_id_t JackGraphManager::AllocatePort(int refnum, const char* port_name,
         port->ClearBuffer(buffer_size);
 
         int res;
-        if (flags & JackPortIsOutput) {
+        int multiplier = manager->GetBlockMultiplier(refnum);
+        if (multiplier > 1 && GetPortType(port->fTypeId) != &gAudioPortType) {
+            jack_error("JackGraphManager::AllocatePort multi-rate clients only have audio ports");
+            res = -1;
+        } else if (manager->IsPipelined(refnum) && !IsBuiltinPortType(port->fTypeId)) {
+            jack_error("JackGraphManager::AllocatePort pipelined clients only have ports of built-in types");
+            res = -1;
+        } else if (flags & JackPortIsOutput) {
             res = manager->AddOutputPort(refnum, port_index);
+            // Port registered by an active pipelined client
+            if (res == 0 && manager->IsPipelined(refnum) && !AllocateCopy(port_index, buffer_size * multiplier, false)) {
+                manager->RemoveOutputPort(refnum, port_index);
+                res = -1;
+            }
         } else {
             res = manager->AddInputPort(refnum, port_index);
+            // Port registered by an active multi-rate client
+            if (res == 0 && multiplier > 1 && !AllocateCopy(port_index, buffer_size * multiplier, true)) {
+                manager->RemoveInputPort(refnum, port_index);
+                res = -1;
+            }
         }
         // Insertion failure
         if (res < 0) {
@@ -417,6 +961,36 @@ jack_port_id_t JackGraphManager::AllocatePort(int refnum, const char* port_name,
     return port_index;
 }
 
+// Server : all ports in a single graph state change, none of them if one fails
+int JackGraphManager::AllocatePorts(int refnum, const char** port_names, unsigned int count, const char* port_type, JackPortFlags flags, jack_nframes_t buffer_size, jack_port_id_t* port_indexes)
+{
+    WriteNextStateStart();
+    unsigned int i;
+
+    // Ports are taken in index order : the search for a free port continues after the previous one
+    for (i = 0; i < count; i++) {
+        jack_port_id_t first = (i == 0) ? FIRST_AVAILABLE_PORT : port_indexes[i - 1] + 1;
+        port_indexes[i] = AllocatePortAux(refnum, port_names[i], port_type, flags, buffer_size, first);
+        if (port_indexes[i] == NO_PORT) {
+            jack_error("JackGraphManager::AllocatePorts cannot allocate port = %s", port_names[i]);
+            break;
+        }
+    }
+
+    // Allocation failure : release what was already allocated
+    int res = 0;
+    if (i < count) {
+        while (i-- > 0) {
+            ReleasePort(refnum, port_indexes[i]);
+            port_indexes[i] = NO_PORT;
+        }
+        res = -1;
+    }
+
+    WriteNextStateStop();
+    return res;
+}
+
 // Server
 int JackGraphManager::ReleasePort(int refnum, jack_port_id_t port_index)
 {
@@ -432,6 +1006,8 @@ int JackGraphManager::ReleasePort(int refnum, jack_port_id_t port_index)
         res = manager->RemoveInputPort(refnum, port_index);
     }
 
+    SetMetering(port_index, false);
+    ReleaseCopy(port_index);
     port->Release();
     WriteNextStateStop();
     return res;
@@ -559,8 +1135,15 @@ void JackGraphManager::GetConnections(jack_port_id_t port_index, jack_int_t* res
 // Server
 void JackGraphManager::Activate(int refnum)
 {
-    DirectConnect(FREEWHEEL_DRIVER_REFNUM, refnum);
-    DirectConnect(refnum, FREEWHEEL_DRIVER_REFNUM);
+    // A multi-rate client runs out of the graph : the server resumes it when its block is complete (see CopyPipelinedBuffers)
+    JackConnectionManager* manager = WriteNextStateStart();
+    int multiplier = manager->GetBlockMultiplier(refnum);
+    WriteNextStateStop();
+
+    if (multiplier == 1) {
+        DirectConnect(FREEWHEEL_DRIVER_REFNUM, refnum);
+        DirectConnect(refnum, FREEWHEEL_DRIVER_REFNUM);
+    }
 }
 
 /*
@@ -586,6 +1169,270 @@ void JackGraphManager::Deactivate(int refnum)
     }
 }
 
+/*
+A pipelined client runs one cycle behind the other clients : its connections with them do not activate it, so it runs
+concurrently with the whole graph. At the cycle start, the server copies the output buffers of the pipelined clients
+(the other clients read these copies during the cycle) and mixes their input buffers from what the other clients produced
+in the previous cycle. Connections with drivers are used directly : drivers read and write their buffers out of the graph.
+
+A multi-rate client runs every 'multiplier' cycles on 'multiplier' buffers, out of the graph : none of its connections
+activate it, drivers included. Its inputs are accumulated one buffer per cycle in the 'next' copy slots of its input
+ports. When a block is complete, the server swaps these slots with the ones the client reads, copies the block the client
+has produced in its output ports, and resumes the client, which then has 'multiplier' cycles to process the new block.
+The copies of its outputs are played one buffer per cycle to all their readers. Clients with the same multiplier are
+given different offsets, so that they do not all run in the same cycle.
+
+Buffers are only exchanged when the graph has finished : the block phases are computed from the count of exchanges,
+so that a late cycle does not shift them.
+*/
+
+// Server : slot not visible as a port, keeping the buffer of the previous cycle of an output port, or a block of an input port
+jack_port_id_t JackGraphManager::AllocateCopySlot(JackPort* port, jack_nframes_t buffer_size)
+{
+    for (jack_port_id_t copy_index = FIRST_AVAILABLE_PORT; copy_index < fPortMax; copy_index++) {
+        JackPort* copy = GetPort(copy_index);
+        if (!copy->IsUsed() && !copy->fIsCopy) {
+            copy->fIsCopy = true;
+            copy->fTypeId = port->fTypeId;
+            copy->ClearBuffer(buffer_size);
+            return copy_index;
+        }
+    }
+    return NO_PORT;
+}
+
+// Server : input ports of multi-rate clients are double buffered, with a second slot accumulating the next block
+bool JackGraphManager::AllocateCopy(jack_port_id_t port_index, jack_nframes_t buffer_size, bool double_buffered)
+{
+    JackPort* port = GetPort(port_index);
+
+    port->fCopy = AllocateCopySlot(port, buffer_size);
+    if (port->fCopy != NO_PORT && double_buffered) {
+        port->fNextCopy = AllocateCopySlot(port, buffer_size);
+        if (port->fNextCopy == NO_PORT) {
+            ReleaseCopy(port_index);
+        }
+    }
+
+    if (port->fCopy == NO_PORT) {
+        jack_error("JackGraphManager::AllocateCopy no free port for the copy of port = %ld", port_index);
+        return false;
+    }
+    return true;
+}
+
+// Server
+void JackGraphManager::ReleaseCopy(jack_port_id_t port_index)
+{
+    JackPort* port = GetPort(port_index);
+
+    if (port->fCopy != NO_PORT) {
+        GetPort(port->fCopy)->fIsCopy = false;
+        port->fCopy = NO_PORT;
+    }
+    if (port->fNextCopy != NO_PORT) {
+        GetPort(port->fNextCopy)->fIsCopy = false;
+        port->fNextCopy = NO_PORT;
+    }
+}
+
+// Server : copies of all ports in the list, or none of them
+bool JackGraphManager::AllocateCopies(const jack_int_t* ports, jack_nframes_t buffer_size, bool double_buffered)
+{
+    int i;
+
+    for (i = 0; (i < PORT_NUM_FOR_CLIENT) && (ports[i] != EMPTY); i++) {
+        if (!AllocateCopy(ports[i], buffer_size, double_buffered)) {
+            while (i-- > 0) {
+                ReleaseCopy(ports[i]);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+// Server
+void JackGraphManager::ReleaseCopies(const jack_int_t* ports)
+{
+    for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (ports[i] != EMPTY); i++) {
+        ReleaseCopy(ports[i]);
+    }
+}
+
+// Server : the client is not active, thus has no connection
+int JackGraphManager::SetPipelined(int refnum, bool onoff, int multiplier, jack_nframes_t buffer_size)
+{
+    JackConnectionManager* manager = WriteNextStateStart();
+    const jack_int_t* input_ports = manager->GetInputPorts(refnum);
+    const jack_int_t* output_ports = manager->GetOutputPorts(refnum);
+    int res = 0;
+    int i;
+
+    if (!onoff) {
+        ReleaseCopies(input_ports);
+        ReleaseCopies(output_ports);
+        manager->SetPipelined(refnum, false);
+        manager->SetBlockMultiplier(refnum, 1, 0);
+        fBlockRunning[refnum] = false;
+        WriteNextStateStop();
+        return 0;
+    }
+
+    // Buffers of a block are sliced, which only makes sense for audio
+    for (i = 0; multiplier > 1 && (i < PORT_NUM_FOR_CLIENT) && (input_ports[i] != EMPTY); i++) {
+        res |= (GetPortType(GetPort(input_ports[i])->fTypeId) == &gAudioPortType) ? 0 : -1;
+    }
+    for (i = 0; multiplier > 1 && (i < PORT_NUM_FOR_CLIENT) && (output_ports[i] != EMPTY); i++) {
+        res |= (GetPortType(GetPort(output_ports[i])->fTypeId) == &gAudioPortType) ? 0 : -1;
+    }
+    if (res < 0) {
+        jack_error("JackGraphManager::SetPipelined multi-rate clients only have audio ports");
+        WriteNextStateStop();
+        return -1;
+    }
+
+    // Their inputs are mixed by the server, which only knows the functions of the built-in types
+    for (i = 0; (i < PORT_NUM_FOR_CLIENT) && (input_ports[i] != EMPTY); i++) {
+        res |= IsBuiltinPortType(GetPort(input_ports[i])->fTypeId) ? 0 : -1;
+    }
+    for (i = 0; (i < PORT_NUM_FOR_CLIENT) && (output_ports[i] != EMPTY); i++) {
+        res |= IsBuiltinPortType(GetPort(output_ports[i])->fTypeId) ? 0 : -1;
+    }
+    if (res < 0) {
+        jack_error("JackGraphManager::SetPipelined pipelined clients only have ports of built-in types");
+        WriteNextStateStop();
+        return -1;
+    }
+
+    if (!AllocateCopies(output_ports, buffer_size * multiplier, false)) {
+        res = -1;
+    } else if (multiplier > 1 && !AllocateCopies(input_ports, buffer_size * multiplier, true)) {
+        ReleaseCopies(output_ports);
+        res = -1;
+    } else {
+        // Offset used by the fewest clients with the same multiplier
+        int offset = 0;
+        int min_count = CLIENT_NUM;
+        for (int candidate = 0; candidate < multiplier; candidate++) {
+            int count = 0;
+            for (int ref = 0; ref < CLIENT_NUM; ref++) {
+                if (ref != refnum && manager->IsPipelined(ref) && manager->GetBlockMultiplier(ref) == multiplier
+                    && manager->GetBlockPhase(ref, 0) == candidate) {
+                    count++;
+                }
+            }
+            if (count < min_count) {
+                min_count = count;
+                offset = candidate;
+            }
+        }
+        manager->SetPipelined(refnum, true);
+        manager->SetBlockMultiplier(refnum, multiplier, offset);
+        fBlockRunning[refnum] = false;
+    }
+
+    WriteNextStateStop();
+    return res;
+}
+
+// RT, server : called at the start of a cycle following a finished one, before clients are resumed
+void JackGraphManager::CopyPipelinedBuffers(jack_nframes_t frames, JackSynchro* table)
+{
+    JackConnectionManager* manager = ReadCurrentState();
+    bool handover[CLIENT_NUM];
+    int refnum, i;
+
+    fBlockCycle++;
+
+    // Outputs first : inputs of pipelined clients connected to other pipelined clients read the copies
+    for (refnum = 0; refnum < CLIENT_NUM; refnum++) {
+        int multiplier = manager->GetBlockMultiplier(refnum);
+        handover[refnum] = false;
+        // Block of a multi-rate client complete in this exchange
+        if (!manager->IsPipelined(refnum) || manager->GetBlockPhase(refnum, fBlockCycle) != multiplier - 1) {
+            continue;
+        }
+        // The previous block has not been processed in time : its outputs are lost, and so is the new block
+        if (multiplier > 1 && fBlockRunning[refnum]) {
+            jack_error("JackGraphManager::CopyPipelinedBuffers multi-rate client ref = %ld has not finished its block", refnum);
+        } else {
+            handover[refnum] = true;
+        }
+        jack_nframes_t block_frames = frames * multiplier;
+        const jack_int_t* output_ports = manager->GetOutputPorts(refnum);
+        for (i = 0; (i < PORT_NUM_FOR_CLIENT) && (output_ports[i] != EMPTY); i++) {
+            JackPort* port = GetPort(output_ports[i]);
+            if (port->fCopy == NO_PORT) {
+                continue;
+            } else if (handover[refnum]) {
+                void* buffers[1] = { GetBuffer(output_ports[i], block_frames) };
+                GetPort(port->fCopy)->MixBuffers(buffers, 1, block_frames);
+            } else {
+                GetPort(port->fCopy)->ClearBuffer(block_frames);
+            }
+        }
+    }
+
+    for (refnum = 0; refnum < CLIENT_NUM; refnum++) {
+        if (manager->IsPipelined(refnum)) {
+            const jack_int_t* input_ports = manager->GetInputPorts(refnum);
+            int phase = manager->GetBlockPhase(refnum, fBlockCycle);
+            for (i = 0; (i < PORT_NUM_FOR_CLIENT) && (input_ports[i] != EMPTY); i++) {
+                JackPort* port = GetPort(input_ports[i]);
+                // Multi-rate client : the port own buffer is only used for the mix
+                if (port->fNextCopy != NO_PORT) {
+                    jack_default_audio_sample_t* slice = GetBuffer(port->fNextCopy) + phase * frames;
+                    if (manager->Connections(input_ports[i]) > 0) {
+                        memcpy(slice, MixBufferAux(manager, input_ports[i], frames), frames * sizeof(jack_default_audio_sample_t));
+                    } else {
+                        memset(slice, 0, frames * sizeof(jack_default_audio_sample_t));
+                    }
+                } else if (manager->Connections(input_ports[i]) > 0) {
+                    void* buffers[1] = { MixBufferAux(manager, input_ports[i], frames) };
+                    if (buffers[0] != port->GetBuffer()) {
+                        port->MixBuffers(buffers, 1, frames);
+                    }
+                }
+            }
+        }
+    }
+
+    // Complete blocks are given to the multi-rate clients, which run out of the graph until the next handover
+    for (refnum = 0; refnum < CLIENT_NUM; refnum++) {
+        if (handover[refnum] && manager->GetBlockMultiplier(refnum) > 1) {
+            const jack_int_t* input_ports = manager->GetInputPorts(refnum);
+            for (i = 0; (i < PORT_NUM_FOR_CLIENT) && (input_ports[i] != EMPTY); i++) {
+                JackPort* port = GetPort(input_ports[i]);
+                jack_port_id_t copy_index = port->fCopy;
+                port->fCopy = port->fNextCopy;
+                port->fNextCopy = copy_index;
+            }
+            fBlockRunning[refnum] = true;
+            table[refnum].Signal();
+        }
+    }
+}
+
+// RT, client : frames of the cycle for the client, a whole block for a multi-rate client (only resumed when its block is complete)
+jack_nframes_t JackGraphManager::GetCycleFrames(int refnum, jack_nframes_t buffer_size)
+{
+    JackConnectionManager* manager = ReadCurrentState();
+    return buffer_size * manager->GetBlockMultiplier(refnum);
+}
+
+// Server
+int JackGraphManager::GetMaxBlockMultiplier()
+{
+    JackConnectionManager* manager = ReadCurrentState();
+    int res = 1;
+
+    for (int refnum = 0; refnum < CLIENT_NUM; refnum++) {
+        res = std::max(res, manager->GetBlockMultiplier(refnum));
+    }
+    return res;
+}
+
 // Server
 int JackGraphManager::GetInputRefNum(jack_port_id_t port_index)
 {
@@ -633,6 +1480,9 @@ int JackGraphManager::Connect(jack_port_id_t port_src, jack_port_id_t port_dst)
         goto end;
     }
 
+    // A new connection starts with unity gain, a setting left by a previous connection of the same ports is dropped
+    GetPort(port_dst)->ReleaseGain(port_src);
+
     res = manager->Connect(port_src, port_dst);
     if (res < 0) {
         jack_error("JackGraphManager::Connect failed port_src = %ld port_dst = %ld", port_src, port_dst);
@@ -644,7 +1494,9 @@ int JackGraphManager::Connect(jack_port_id_t port_src, jack_port_id_t port_dst)
         goto end;
     }
 
-    if (manager->IsLoopPath(port_src, port_dst)) {
+    if (manager->IsPipelinedConnection(src->fRefNum, dst->fRefNum)) {
+        jack_log("JackGraphManager::Connect: PIPELINED connection");
+    } else if (manager->IsLoopPath(port_src, port_dst)) {
         jack_log("JackGraphManager::Connect: LOOP detected");
         manager->IncFeedbackConnection(port_src, port_dst);
     } else {
@@ -690,13 +1542,18 @@ int JackGraphManager::Disconnect(jack_port_id_t port_src, jack_port_id_t port_ds
         goto end;
     }
 
-    if (manager->IsFeedbackConnection(port_src, port_dst)) {
+    if (manager->IsPipelinedConnection(GetPort(port_src)->fRefNum, GetPort(port_dst)->fRefNum)) {
+        jack_log("JackGraphManager::Disconnect: PIPELINED connection removed");
+    } else if (manager->IsFeedbackConnection(port_src, port_dst)) {
         jack_log("JackGraphManager::Disconnect: FEEDBACK removed");
         manager->DecFeedbackConnection(port_src, port_dst);
     } else {
         manager->DecDirectConnection(port_src, port_dst);
     }
 
+    // The gain setting of the connection is dropped, so that the gain mix is not used for a removed connection
+    GetPort(port_dst)->ReleaseGain(port_src);
+
 end:
     WriteNextStateStop();
     return res;
@@ -757,6 +1614,35 @@ jack_port_id_t JackGraphManager::GetPort(const char* name)
     return NO_PORT;
 }
 
+// Server : ports are scanned once, instead of once per name
+jack_port_id_t JackGraphManager::GetPort(const char** names, unsigned int count)
+{
+    std::set<std::string> name_set;
+
+    for (unsigned int i = 0; i < count; i++) {
+        // Names affected by the JackPort::NameEquals "ALSA" kludge are checked one by one
+        if (strncmp(names[i], "ALSA:", 5) == 0) {
+            jack_port_id_t port_index = GetPort(names[i]);
+            if (port_index != NO_PORT) {
+                return port_index;
+            }
+        } else {
+            name_set.insert(names[i]);
+        }
+    }
+
+    if (name_set.size() > 0) {
+        for (unsigned int i = 0; i < fPortMax; i++) {
+            JackPort* port = GetPort(i);
+            if (port->IsUsed()
+                && (name_set.count(port->fName) > 0 || name_set.count(port->fAlias1) > 0 || name_set.count(port->fAlias2) > 0)) {
+                return i;
+            }
+        }
+    }
+    return NO_PORT;
+}
+
 /*!
 \brief Get the connection port name array.
 */
@@ -32,6 +32,20 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 namespace Jack
 {
 
+struct JackTotalLatencyContext;
+
+/*!
+\brief Port type registered by a client, shared by all processes so that they agree on the type ids.
+*/
+
+PRE_PACKED_STRUCTURE
+struct JackPortTypeInfo
+{
+    char fName[JACK_PORT_TYPE_SIZE + 1];    // Empty when the slot is free
+    UInt32 fSize;                           // Buffer size in bytes
+
+} POST_PACKED_STRUCTURE;
+
 /*!
 \brief Graph manager: contains the connection manager and the port array.
 */
@@ -44,16 +58,34 @@ class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState
 
         unsigned int fPortMax;
         JackClientTiming fClientTiming[CLIENT_NUM];
+        JackPortMeter fPortMeter[PORT_NUM_MAX];
+        volatile UInt32 fCycle;     // Incremented by the server at each cycle start
+        volatile UInt32 fBlockCycle;    // Incremented by the server at each exchange of the pipelined buffers, gives the block phases
+        volatile bool fBlockRunning[CLIENT_NUM];    // Multi-rate clients resumed on a block and not finished yet
+        JackPortTypeInfo fPortTypeInfo[CUSTOM_PORT_TYPE_NUM];
         JackPort fPortArray[0];    // The actual size depends of port_max, it will be dynamically computed and allocated using "placement" new
 
         void AssertPort(jack_port_id_t port_index);
-        jack_port_id_t AllocatePortAux(int refnum, const char* port_name, const char* port_type, JackPortFlags flags);
+        jack_port_id_t AllocatePortAux(int refnum, const char* port_name, const char* port_type, JackPortFlags flags, jack_port_id_t first);
+        jack_port_id_t AllocatePortAux(int refnum, const char* port_name, const char* port_type, JackPortFlags flags, jack_nframes_t buffer_size, jack_port_id_t first);
         void GetConnectionsAux(JackConnectionManager* manager, const char** res, jack_port_id_t port_index);
         void GetPortsAux(const char** matching_ports, const char* port_name_pattern, const char* type_name_pattern, unsigned long flags);
         jack_default_audio_sample_t* GetBuffer(jack_port_id_t port_index);
         void* GetBufferAux(JackConnectionManager* manager, jack_port_id_t port_index, jack_nframes_t frames);
-        jack_nframes_t ComputeTotalLatencyAux(jack_port_id_t port_index, jack_port_id_t src_port_index, JackConnectionManager* manager, int hop_count);
+        void* MixBufferAux(JackConnectionManager* manager, jack_port_id_t port_index, jack_nframes_t frames);
+        void* GetSourceBuffer(JackConnectionManager* manager, JackPort* port, jack_port_id_t src_index, jack_nframes_t frames);
+        jack_port_id_t AllocateCopySlot(JackPort* port, jack_nframes_t buffer_size);
+        bool AllocateCopy(jack_port_id_t port_index, jack_nframes_t buffer_size, bool double_buffered);
+        void ReleaseCopy(jack_port_id_t port_index);
+        bool AllocateCopies(const jack_int_t* ports, jack_nframes_t buffer_size, bool double_buffered);
+        void ReleaseCopies(const jack_int_t* ports);
+        jack_nframes_t GetLatencyEdges(JackTotalLatencyContext* context, int node, JackConnectionManager* manager);
+        void ComputeLatencyNode(JackTotalLatencyContext* context, int node, JackConnectionManager* manager);
+        jack_nframes_t ComputeTotalLatencyAux(JackTotalLatencyContext* context, jack_port_id_t port_index, JackConnectionManager* manager);
+        void GetConnectedLatencyRange(JackConnectionManager* manager, jack_port_id_t port_index, jack_latency_callback_mode_t mode, jack_latency_range_t* latency);
         void RecalculateLatencyAux(jack_port_id_t port_index, jack_latency_callback_mode_t mode);
+        void UpdateMeter(jack_port_id_t port_index, void* buffer, jack_nframes_t frames);
+        void UpdateOutputMeters(JackConnectionManager* manager, int refnum);
 
     public:
 
@@ -65,6 +97,7 @@ class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState
 
         // Ports management
         jack_port_id_t AllocatePort(int refnum, const char* port_name, const char* port_type, JackPortFlags flags, jack_nframes_t buffer_size);
+        int AllocatePorts(int refnum, const char** port_names, unsigned int count, const char* port_type, JackPortFlags flags, jack_nframes_t buffer_size, jack_port_id_t* port_indexes);
         int ReleasePort(int refnum, jack_port_id_t port_index);
         void GetInputPorts(int refnum, jack_int_t* res);
         void GetOutputPorts(int refnum, jack_int_t* res);
@@ -73,18 +106,28 @@ class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState
 
         JackPort* GetPort(jack_port_id_t index);
         jack_port_id_t GetPort(const char* name);
+        jack_port_id_t GetPort(const char** names, unsigned int count);
 
         int ComputeTotalLatency(jack_port_id_t port_index);
         int ComputeTotalLatencies();
         void RecalculateLatency(jack_port_id_t port_index, jack_latency_callback_mode_t mode);
+        bool RecalculateLatencies(int refnum, jack_latency_callback_mode_t mode, bool apply);
+        bool PropagateLatencies(int refnum, jack_latency_callback_mode_t mode);
 
         int RequestMonitor(jack_port_id_t port_index, bool onoff);
 
+        // Metering
+        int SetMetering(jack_port_id_t port_index, bool onoff);
+        int GetMeter(jack_port_id_t port_index, jack_default_audio_sample_t* peak, jack_default_audio_sample_t* rms);
+
         // Connections management
         int Connect(jack_port_id_t src_index, jack_port_id_t dst_index);
         int Disconnect(jack_port_id_t src_index, jack_port_id_t dst_index);
         int IsConnected(jack_port_id_t port_src, jack_port_id_t port_dst);
 
+        int SetConnectionGain(jack_port_id_t port_src, jack_port_id_t port_dst, jack_default_audio_sample_t gain, int mute);
+        int GetConnectionGain(jack_port_id_t port_src, jack_port_id_t port_dst, jack_default_audio_sample_t* gain, int* mute);
+
         // RT, client
         int GetConnectionsNum(jack_port_id_t port_index)
         {
@@ -110,11 +153,26 @@ class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState
         void Activate(int refnum);
         void Deactivate(int refnum);
 
+        // Pipelined and multi-rate clients
+        int SetPipelined(int refnum, bool onoff, int multiplier, jack_nframes_t buffer_size);
+        void CopyPipelinedBuffers(jack_nframes_t frames, JackSynchro* table);
+        jack_nframes_t GetCycleFrames(int refnum, jack_nframes_t buffer_size);
+        int GetMaxBlockMultiplier();
+
         int GetInputRefNum(jack_port_id_t port_index);
         int GetOutputRefNum(jack_port_id_t port_index);
 
         // Buffer management
-        void* GetBuffer(jack_port_id_t port_index, jack_nframes_t frames);
+        void* GetBuffer(jack_port_id_t port_index, jack_nframes_t frames, bool in_cycle = true);
+
+        // Port types registered by clients
+        int RegisterPortType(const char* port_type, size_t buffer_size);
+        int FindPortType(const char* port_type);
+
+        const JackPortTypeInfo* GetPortTypeInfo(int slot)
+        {
+            return &fPortTypeInfo[slot];
+        }
 
         // Activation management
         void RunCurrentGraph();
@@ -70,6 +70,10 @@ class JackInternalClientChannel : public detail::JackClientChannelInterface
         {
             *result = fEngine->PortRegister(refnum, name, type, flags, buffer_size, port_index);
         }
+        void PortRegisterMany(int refnum, const char** names, unsigned int count, const char* type, unsigned int flags, unsigned int buffer_size, jack_port_id_t* port_indexes, int* result)
+        {
+            *result = fEngine->PortRegisterMany(refnum, names, count, type, flags, buffer_size, port_indexes);
+        }
         void PortUnRegister(int refnum, jack_port_id_t port_index, int* result)
         {
             *result = fEngine->PortUnRegister(refnum, port_index);
@@ -103,9 +107,9 @@ class JackInternalClientChannel : public detail::JackClientChannelInterface
         {
             *result = fServer->SetFreewheel(onoff);
         }
-        void ComputeTotalLatencies(int* result)
+        void ComputeTotalLatencies(int refnum, int* result)
         {
-            *result = fEngine->ComputeTotalLatencies();
+            *result = fEngine->ComputeTotalLatencies(refnum);
         }
 
         void ReleaseTimebase(int refnum, int* result)
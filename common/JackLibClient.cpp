@@ -30,7 +30,7 @@ namespace Jack
 // Used for external C API (JackAPI.cpp)
 JackGraphManager* GetGraphManager()
 {
-    if (JackLibGlobals::fGlobals) {
+    if (JackLibGlobals::fGlobals && !JackLibGlobals::fGlobals->fParked) {
         return JackLibGlobals::fGlobals->fGraphManager;
     } else {
         return NULL;
@@ -39,7 +39,7 @@ JackGraphManager* GetGraphManager()
 
 JackEngineControl* GetEngineControl()
 {
-    if (JackLibGlobals::fGlobals) {
+    if (JackLibGlobals::fGlobals && !JackLibGlobals::fGlobals->fParked) {
         return JackLibGlobals::fGlobals->fEngineControl;
     } else {
         return NULL;
@@ -130,8 +130,7 @@ int JackLibClient::Open(const char* server_name, const char* name, jack_uuid_t u
 
     try {
         // Map shared memory segments
-        JackLibGlobals::fGlobals->fEngineControl.SetShmIndex(shared_engine, fServerName);
-        JackLibGlobals::fGlobals->fGraphManager.SetShmIndex(shared_graph, fServerName);
+        JackLibGlobals::fGlobals->Attach(shared_engine, shared_graph, fServerName);
         fClientControl.SetShmIndex(shared_client, fServerName);
         JackGlobals::fVerbose = GetEngineControl()->fVerbose;
     } catch (...) {
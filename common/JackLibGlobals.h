@@ -57,6 +57,7 @@ struct JackLibGlobals
     JackSynchro fSynchroTable[CLIENT_NUM];                  /*! Shared synchro table */
     JackMetadata *fMetadata;                                /*! Shared metadata base */
     sigset_t fProcessSignals;
+    bool fParked;                                           /*! No client open, server segments kept mapped ($JACK_KEEP_SEGMENTS) */
 
     static int fClientCount;
     static JackLibGlobals* fGlobals;
@@ -64,13 +65,31 @@ struct JackLibGlobals
     JackLibGlobals()
     {
         jack_log("JackLibGlobals");
-        if (!JackMessageBuffer::Create()) {
-            jack_error("Cannot create message buffer");
-        }
         fGraphManager = -1;
         fEngineControl = -1;
 
         fMetadata = new JackMetadata(false);
+        Acquire();
+    }
+
+    ~JackLibGlobals()
+    {
+        jack_log("~JackLibGlobals");
+        if (!fParked) {
+            Release();
+        }
+
+        delete fMetadata;
+        fMetadata = NULL;
+    }
+
+    // Process state needed while clients are open
+    void Acquire()
+    {
+        fParked = false;
+        if (!JackMessageBuffer::Create()) {
+            jack_error("Cannot create message buffer");
+        }
 
         // Filter SIGPIPE to avoid having client get a SIGPIPE when trying to access a died server.
     #ifdef WIN32
@@ -83,17 +102,13 @@ struct JackLibGlobals
     #endif
     }
 
-    ~JackLibGlobals()
+    void Release()
     {
-        jack_log("~JackLibGlobals");
         for (int i = 0; i < CLIENT_NUM; i++) {
             fSynchroTable[i].Disconnect();
         }
         JackMessageBuffer::Destroy();
 
-        delete fMetadata;
-        fMetadata = NULL;
-
        // Restore old signal mask
     #ifdef WIN32
        // TODO
@@ -102,6 +117,23 @@ struct JackLibGlobals
     #endif
     }
 
+    /*
+    Map the server segments. If $JACK_KEEP_SEGMENTS is defined, the graph manager and engine control stay
+    mapped (and locked) when the last client closes, the next opened client reuses them if the server
+    still publishes the same ones.
+    */
+    void Attach(int shared_engine, int shared_graph, const char* server_name)
+    {
+        if (fClientCount == 1 && fEngineControl.GetShmIndex() >= 0
+            && (!fEngineControl.IsAttached(shared_engine) || !fGraphManager.IsAttached(shared_graph) || fEngineControl->fClosed)) {
+            jack_log("JackLibGlobals Attach: server segments have changed");
+            fEngineControl.Release();
+            fGraphManager.Release();
+        }
+        fEngineControl.SetShmIndex(shared_engine, server_name);
+        fGraphManager.SetShmIndex(shared_graph, server_name);
+    }
+
     static void Init()
     {
         if (!JackGlobals::fServerRunning && fClientCount > 0) {
@@ -123,20 +155,32 @@ struct JackLibGlobals
             fGlobals = NULL;
         }
 
-        if (fClientCount++ == 0 && !fGlobals) {
-            jack_log("JackLibGlobals Init %x", fGlobals);
-            InitTime();
-            fGlobals = new JackLibGlobals();
+        if (fClientCount++ == 0) {
+            if (!fGlobals) {
+                jack_log("JackLibGlobals Init %x", fGlobals);
+                InitTime();
+                fGlobals = new JackLibGlobals();
+            } else if (fGlobals->fParked) {
+                jack_log("JackLibGlobals Init reuse %x", fGlobals);
+                fGlobals->Acquire();
+            }
         }
     }
 
     static void Destroy()
     {
         if (--fClientCount == 0 && fGlobals) {
-            jack_log("JackLibGlobals Destroy %x", fGlobals);
-            EndTime();
-            delete fGlobals;
-            fGlobals = NULL;
+            if (JackGlobals::fServerRunning && getenv("JACK_KEEP_SEGMENTS")) {
+                // Keep the server segments mapped for the next client, on request only since they are large and locked
+                jack_log("JackLibGlobals Park %x", fGlobals);
+                fGlobals->Release();
+                fGlobals->fParked = true;
+            } else {
+                jack_log("JackLibGlobals Destroy %x", fGlobals);
+                EndTime();
+                delete fGlobals;
+                fGlobals = NULL;
+            }
         }
     }
 
@@ -116,11 +116,11 @@ class SERVER_EXPORT JackLockedEngine
             return fEngine.ClientCheck(name, uuid, name_res, protocol, options, status);
             CATCH_EXCEPTION_RETURN
         }
-        int ClientExternalOpen(const char* name, int pid, jack_uuid_t uuid, int* ref, int* shared_engine, int* shared_client, int* shared_graph_manager)
+        int ClientExternalOpen(const char* name, const char* notify_name, int pid, jack_uuid_t uuid, int* ref, int* shared_engine, int* shared_client, int* shared_graph_manager)
         {
             TRY_CALL
             JackLock lock(&fEngine);
-            return fEngine.ClientExternalOpen(name, pid, uuid, ref, shared_engine, shared_client, shared_graph_manager);
+            return fEngine.ClientExternalOpen(name, notify_name, pid, uuid, ref, shared_engine, shared_client, shared_graph_manager);
             CATCH_EXCEPTION_RETURN
         }
         int ClientInternalOpen(const char* name, int* ref, JackEngineControl** shared_engine, JackGraphManager** shared_manager, JackClientInterface* client, bool wait)
@@ -200,6 +200,13 @@ class SERVER_EXPORT JackLockedEngine
             return (fEngine.CheckClient(refnum)) ? fEngine.PortRegister(refnum, name, type, flags, buffer_size, port) : -1;
             CATCH_EXCEPTION_RETURN
         }
+        int PortRegisterMany(int refnum, const char** names, unsigned int count, const char *type, unsigned int flags, unsigned int buffer_size, jack_port_id_t* ports)
+        {
+            TRY_CALL
+            JackLock lock(&fEngine);
+            return (fEngine.CheckClient(refnum)) ? fEngine.PortRegisterMany(refnum, names, count, type, flags, buffer_size, ports) : -1;
+            CATCH_EXCEPTION_RETURN
+        }
         int PortUnRegister(int refnum, jack_port_id_t port)
         {
             TRY_CALL
@@ -254,11 +261,11 @@ class SERVER_EXPORT JackLockedEngine
             CATCH_EXCEPTION_RETURN
         }
 
-        int ComputeTotalLatencies()
+        int ComputeTotalLatencies(int refnum)
         {
             TRY_CALL
             JackLock lock(&fEngine);
-            return fEngine.ComputeTotalLatencies();
+            return (refnum == ALL_CLIENTS || fEngine.CheckClient(refnum)) ? fEngine.ComputeTotalLatencies(refnum) : -1;
             CATCH_EXCEPTION_RETURN
         }
 
@@ -299,6 +306,13 @@ class SERVER_EXPORT JackLockedEngine
             fEngine.NotifyBufferSize(buffer_size);
             CATCH_EXCEPTION
         }
+        void NotifyBufferSizePrepare(jack_nframes_t buffer_size)
+        {
+            TRY_CALL
+            JackLock lock(&fEngine);
+            fEngine.NotifyBufferSizePrepare(buffer_size);
+            CATCH_EXCEPTION
+        }
         void NotifySampleRate(jack_nframes_t sample_rate)
         {
             TRY_CALL
@@ -338,6 +352,14 @@ class SERVER_EXPORT JackLockedEngine
             CATCH_EXCEPTION_RETURN
         }
 
+        int GetClientCPU(const char* name)
+        {
+            TRY_CALL
+            JackLock lock(&fEngine);
+            return fEngine.GetClientCPU(name);
+            CATCH_EXCEPTION_RETURN
+        }
+
         void NotifyQuit()
         {
             // No lock needed
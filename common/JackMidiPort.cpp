@@ -156,7 +156,10 @@ const JackPortType gMidiPortType =
     JACK_DEFAULT_MIDI_TYPE,
     MidiBufferSize,
     MidiBufferInit,
-    MidiBufferMixdown
+    MidiBufferMixdown,
+    NULL,
+    NULL,
+    NULL
 };
 
 } // namespace Jack
@@ -0,0 +1,193 @@
+/*
+Copyright (C) 2026
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "JackMultiChannelResampler.h"
+#include <string.h>
+
+#if defined (__SSE__) && !defined (__sun__)
+#include <xmmintrin.h>
+#elif defined (__ARM_NEON__) || defined (__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Jack
+{
+
+#define RESAMPLER_BLOCK_SIZE 64
+
+JackMultiChannelResampler::JackMultiChannelResampler(int channels, unsigned int size)
+    :fChannels(channels), fSize(size + 4)
+{
+    fBuffer = new jack_default_audio_sample_t[fSize * fChannels];
+    fScratch = new jack_default_audio_sample_t[RESAMPLER_BLOCK_SIZE * fChannels];
+    Reset(0);
+}
+
+JackMultiChannelResampler::~JackMultiChannelResampler()
+{
+    delete[] fBuffer;
+    delete[] fScratch;
+}
+
+void JackMultiChannelResampler::Reset(unsigned int frames)
+{
+    if (frames > fSize - 1) {
+        frames = fSize - 1;
+    }
+    // One silent history frame, then the queued silence
+    memset(fBuffer, 0, sizeof(jack_default_audio_sample_t) * (frames + 1) * fChannels);
+    fReadFrame = 1;
+    fWriteFrame = frames + 1;
+    fPhase = 0.;
+}
+
+bool JackMultiChannelResampler::Reserve(unsigned int frames)
+{
+    if (fWriteFrame + frames <= fSize) {
+        return true;
+    }
+
+    // Move the frames still needed, history frame included, back to the beginning
+    unsigned int first = fReadFrame - 1;
+    memmove(fBuffer, fBuffer + first * fChannels, sizeof(jack_default_audio_sample_t) * (fWriteFrame - first) * fChannels);
+    fReadFrame -= first;
+    fWriteFrame -= first;
+    return (fWriteFrame + frames <= fSize);
+}
+
+jack_default_audio_sample_t* JackMultiChannelResampler::GetWriteBuffer(unsigned int frames)
+{
+    return (Reserve(frames)) ? fBuffer + fWriteFrame * fChannels : NULL;
+}
+
+void JackMultiChannelResampler::WriteAdvance(unsigned int frames)
+{
+    fWriteFrame += frames;
+}
+
+unsigned int JackMultiChannelResampler::Write(jack_default_audio_sample_t** buffers, unsigned int frames)
+{
+    if (!Reserve(frames)) {
+        frames = fSize - fWriteFrame;
+    }
+
+    jack_default_audio_sample_t* dst = fBuffer + fWriteFrame * fChannels;
+    for (int chan = 0; chan < fChannels; chan++) {
+        jack_default_audio_sample_t* src = buffers[chan];
+        if (src) {
+            for (unsigned int i = 0; i < frames; i++) {
+                dst[i * fChannels + chan] = src[i];
+            }
+        } else {
+            for (unsigned int i = 0; i < frames; i++) {
+                dst[i * fChannels + chan] = 0.f;
+            }
+        }
+    }
+
+    fWriteFrame += frames;
+    return frames;
+}
+
+unsigned int JackMultiChannelResampler::Resample(jack_default_audio_sample_t* buffer, unsigned int frames, double step)
+{
+    unsigned int i;
+
+    for (i = 0; i < frames && fReadFrame + 2 < fWriteFrame; i++) {
+        // Catmull-Rom weights of the four frames around the position, shared by all channels
+        float t = float(fPhase);
+        float t2 = t * t;
+        float t3 = t2 * t;
+        float w0 = 0.5f * (-t3 + 2.f * t2 - t);
+        float w1 = 0.5f * (3.f * t3 - 5.f * t2 + 2.f);
+        float w2 = 0.5f * (-3.f * t3 + 4.f * t2 + t);
+        float w3 = 0.5f * (t3 - t2);
+
+        const jack_default_audio_sample_t* x0 = fBuffer + (fReadFrame - 1) * fChannels;
+        const jack_default_audio_sample_t* x1 = x0 + fChannels;
+        const jack_default_audio_sample_t* x2 = x1 + fChannels;
+        const jack_default_audio_sample_t* x3 = x2 + fChannels;
+        jack_default_audio_sample_t* out = buffer + i * fChannels;
+        int chan = 0;
+
+    #if defined (__SSE__) && !defined (__sun__)
+        __m128 v0 = _mm_set1_ps(w0);
+        __m128 v1 = _mm_set1_ps(w1);
+        __m128 v2 = _mm_set1_ps(w2);
+        __m128 v3 = _mm_set1_ps(w3);
+        for (; chan + 4 <= fChannels; chan += 4) {
+            __m128 acc = _mm_add_ps(_mm_mul_ps(v0, _mm_loadu_ps(x0 + chan)), _mm_mul_ps(v1, _mm_loadu_ps(x1 + chan)));
+            acc = _mm_add_ps(acc, _mm_add_ps(_mm_mul_ps(v2, _mm_loadu_ps(x2 + chan)), _mm_mul_ps(v3, _mm_loadu_ps(x3 + chan))));
+            _mm_storeu_ps(out + chan, acc);
+        }
+    #elif defined (__ARM_NEON__) || defined (__ARM_NEON)
+        for (; chan + 4 <= fChannels; chan += 4) {
+            float32x4_t acc = vmulq_n_f32(vld1q_f32(x0 + chan), w0);
+            acc = vmlaq_n_f32(acc, vld1q_f32(x1 + chan), w1);
+            acc = vmlaq_n_f32(acc, vld1q_f32(x2 + chan), w2);
+            acc = vmlaq_n_f32(acc, vld1q_f32(x3 + chan), w3);
+            vst1q_f32(out + chan, acc);
+        }
+    #endif
+        for (; chan < fChannels; chan++) {
+            out[chan] = w0 * x0[chan] + w1 * x1[chan] + w2 * x2[chan] + w3 * x3[chan];
+        }
+
+        fPhase += step;
+        unsigned int advance = (unsigned int)fPhase;
+        fReadFrame += advance;
+        fPhase -= advance;
+    }
+
+    return i;
+}
+
+unsigned int JackMultiChannelResampler::ReadResample(jack_default_audio_sample_t* buffer, unsigned int frames, double ratio)
+{
+    // Drift compensation only, also keeps the position inside the FIFO
+    ratio = (ratio < 0.5) ? 0.5 : ((ratio > 2.0) ? 2.0 : ratio);
+    return Resample(buffer, frames, 1.0 / ratio);
+}
+
+unsigned int JackMultiChannelResampler::ReadResample(jack_default_audio_sample_t** buffers, unsigned int frames, double ratio)
+{
+    ratio = (ratio < 0.5) ? 0.5 : ((ratio > 2.0) ? 2.0 : ratio);
+    unsigned int read = 0;
+
+    while (read < frames) {
+        unsigned int block = (frames - read < RESAMPLER_BLOCK_SIZE) ? frames - read : RESAMPLER_BLOCK_SIZE;
+        unsigned int done = Resample(fScratch, block, 1.0 / ratio);
+        for (int chan = 0; chan < fChannels; chan++) {
+            jack_default_audio_sample_t* dst = buffers[chan];
+            if (dst) {
+                for (unsigned int i = 0; i < done; i++) {
+                    dst[read + i] = fScratch[i * fChannels + chan];
+                }
+            }
+        }
+        read += done;
+        if (done < block) {
+            break;
+        }
+    }
+
+    return read;
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+Copyright (C) 2026
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __JackMultiChannelResampler__
+#define __JackMultiChannelResampler__
+
+#include "types.h"
+
+namespace Jack
+{
+
+/*!
+\brief Resampler for all the channels of a device at once.
+
+Frames are kept interleaved in a FIFO and interpolated with a cubic (Catmull-Rom) kernel:
+the position and the kernel weights are computed once per output frame and shared by all
+channels, the inner loop over the channels is vectorized. Meant to follow small clock drifts,
+the ratio (output rate / input rate) can change at each read. Not thread safe : both sides
+are expected to be used from the same thread, like a driver cycle.
+*/
+
+class JackMultiChannelResampler
+{
+
+    private:
+
+        int fChannels;
+        unsigned int fSize;                     // in frames
+        jack_default_audio_sample_t* fBuffer;   // interleaved frames
+        jack_default_audio_sample_t* fScratch;  // interleaved output block
+        unsigned int fReadFrame;                // frame at the current position, preceded by one history frame
+        unsigned int fWriteFrame;
+        double fPhase;                          // in [0, 1) between fReadFrame and fReadFrame + 1
+
+        bool Reserve(unsigned int frames);
+        unsigned int Resample(jack_default_audio_sample_t* buffer, unsigned int frames, double step);
+
+    public:
+
+        JackMultiChannelResampler(int channels, unsigned int size);
+        ~JackMultiChannelResampler();
+
+        // Empties the FIFO, then queues 'frames' frames of silence
+        void Reset(unsigned int frames);
+
+        // Input frames not consumed yet
+        unsigned int ReadSpace()
+        {
+            return fWriteFrame - fReadFrame;
+        }
+
+        // Frames that can be queued, the history frame being kept
+        unsigned int WriteSpace()
+        {
+            return fSize - (fWriteFrame - fReadFrame) - 1;
+        }
+
+        int GetChannels()
+        {
+            return fChannels;
+        }
+
+        // Room for 'frames' interleaved frames, to be committed with WriteAdvance, or NULL when full
+        jack_default_audio_sample_t* GetWriteBuffer(unsigned int frames);
+        void WriteAdvance(unsigned int frames);
+
+        // Interleaves one buffer per channel, a NULL buffer is written as silence
+        unsigned int Write(jack_default_audio_sample_t** buffers, unsigned int frames);
+
+        // Produces 'frames' frames, interleaved or one buffer per channel (NULL buffers are skipped),
+        // returns less when the input runs out
+        unsigned int ReadResample(jack_default_audio_sample_t* buffer, unsigned int frames, double ratio);
+        unsigned int ReadResample(jack_default_audio_sample_t** buffers, unsigned int frames, double ratio);
+
+};
+
+}
+
+#endif
@@ -50,6 +50,7 @@ namespace Jack
         fParams.fPeriodSize = buffer_size;
         fParams.fSlaveSyncMode = 1;
         fParams.fNetworkLatency = NETWORK_DEFAULT_LATENCY;
+        fParams.fFecGroup = 0;
         fParams.fSampleEncoder = JackFloatEncoder;
         fClient = jack_client;
     
@@ -117,6 +118,13 @@ namespace Jack
                         throw std::bad_alloc();
                     }
                     break;
+                case 'f' :
+                    fParams.fFecGroup = param->value.ui;
+                    if (fParams.fFecGroup > NETWORK_MAX_FEC_GROUP) {
+                        jack_error("Error : forward error correction group is limited to %d packets\n", NETWORK_MAX_FEC_GROUP);
+                        throw std::bad_alloc();
+                    }
+                    break;
                 case 'q':
                     fQuality = param->value.ui;
                     break;
@@ -453,6 +461,9 @@ extern "C"
         value.ui = 5U;
         jack_driver_descriptor_add_parameter(desc, &filler, "latency", 'l', JackDriverParamUInt, &value, NULL, "Network latency", NULL);
 
+        value.ui = 0U;
+        jack_driver_descriptor_add_parameter(desc, &filler, "fec", 'f', JackDriverParamUInt, &value, NULL, "Forward error correction group size", "Number of audio packets protected by one parity packet (0 = no forward error correction)");
+
         value.i = 0;
         jack_driver_descriptor_add_parameter(desc, &filler, "quality", 'q', JackDriverParamInt, &value, NULL, "Resample algorithm quality (0 - 4)", NULL);
 
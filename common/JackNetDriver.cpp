@@ -30,7 +30,7 @@ namespace Jack
     JackNetDriver::JackNetDriver(const char* name, const char* alias, JackLockedEngine* engine, JackSynchro* table,
                                 const char* ip, int udp_port, int mtu, int midi_input_ports, int midi_output_ports,
                                 char* net_name, uint transport_sync, int network_latency, 
-                                int celt_encoding, int opus_encoding, bool auto_save)
+                                int celt_encoding, int opus_encoding, bool auto_save, uint fec_group)
             : JackWaiterDriver(name, alias, engine, table), JackNetSlaveInterface(ip, udp_port)
     {
         jack_log("JackNetDriver::JackNetDriver ip %s, port %d", ip, udp_port);
@@ -59,6 +59,7 @@ namespace Jack
         fSocket.GetName(fParams.fSlaveNetName);
         fParams.fTransportSync = transport_sync;
         fParams.fNetworkLatency = network_latency;
+        fParams.fFecGroup = fec_group;
         fSendTransportData.fState = -1;
         fReturnTransportData.fState = -1;
         fLastTransportState = -1;
@@ -714,6 +715,9 @@ Deactivated for now..
             value.ui = 5U;
             jack_driver_descriptor_add_parameter(desc, &filler, "latency", 'l', JackDriverParamUInt, &value, NULL, "Network latency", NULL);
 
+            value.ui = 0U;
+            jack_driver_descriptor_add_parameter(desc, &filler, "fec", 'f', JackDriverParamUInt, &value, NULL, "Forward error correction group size", "Number of audio packets protected by one parity packet (0 = no forward error correction)");
+
             return desc;
         }
 
@@ -735,6 +739,7 @@ Deactivated for now..
             int opus_encoding = -1;
             bool monitor = false;
             int network_latency = 5;
+            uint fec_group = 0;
             const JSList* node;
             const jack_driver_param_t* param;
             bool auto_save = false;
@@ -802,6 +807,13 @@ Deactivated for now..
                             return NULL;
                         }
                         break;
+                    case 'f' :
+                        fec_group = param->value.ui;
+                        if (fec_group > NETWORK_MAX_FEC_GROUP) {
+                            printf("Error : forward error correction group is limited to %d packets\n", NETWORK_MAX_FEC_GROUP);
+                            return NULL;
+                        }
+                        break;
                 }
             }
 
@@ -811,7 +823,7 @@ Deactivated for now..
                         new Jack::JackNetDriver("system", "net_pcm", engine, table, multicast_ip, udp_port, mtu,
                                                 midi_input_ports, midi_output_ports,
                                                 net_name, transport_sync,
-                                                network_latency, celt_encoding, opus_encoding, auto_save));
+                                                network_latency, celt_encoding, opus_encoding, auto_save, fec_group));
                 if (driver->Open(period_size, sample_rate, 1, 1, audio_capture_ports, audio_playback_ports, monitor, "from_master_", "to_master_", 0, 0) == 0) {
                     return driver;
                 } else {
@@ -81,7 +81,7 @@ namespace Jack
             JackNetDriver(const char* name, const char* alias, JackLockedEngine* engine, JackSynchro* table,
                         const char* ip, int port, int mtu, int midi_input_ports, int midi_output_ports,
                         char* net_name, uint transport_sync, int network_latency, int celt_encoding,
-                        int opus_encoding, bool auto_save);
+                        int opus_encoding, bool auto_save, uint fec_group = 0);
             virtual ~JackNetDriver();
 
             int Open(jack_nframes_t buffer_size,
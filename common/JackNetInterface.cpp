@@ -21,6 +21,7 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #include "JackError.h"
 
 #include <assert.h>
+#include <algorithm>
 
 using namespace std;
 
@@ -36,11 +37,13 @@ namespace Jack
 
     JackNetInterface::JackNetInterface() : fSocket()
     {
+        memset(&fParams, 0, sizeof(session_params_t));
         Initialize();
     }
 
     JackNetInterface::JackNetInterface(const char* multicast_ip, int port) : fSocket(multicast_ip, port)
     {
+        memset(&fParams, 0, sizeof(session_params_t));
         strcpy(fMulticastIP, multicast_ip);
         Initialize();
     }
@@ -57,6 +60,8 @@ namespace Jack
         fSetTimeOut = false;
         fTxBuffer = NULL;
         fRxBuffer = NULL;
+        fFecTxBuffer = NULL;
+        fFecRxBuffer = NULL;
         fNetAudioCaptureBuffer = NULL;
         fNetAudioPlaybackBuffer = NULL;
         fNetMidiCaptureBuffer = NULL;
@@ -85,6 +90,8 @@ namespace Jack
         fSocket.Close();
         delete[] fTxBuffer;
         delete[] fRxBuffer;
+        delete[] fFecTxBuffer;
+        delete[] fFecRxBuffer;
         delete fNetAudioCaptureBuffer;
         delete fNetAudioPlaybackBuffer;
         delete fNetMidiCaptureBuffer;
@@ -97,6 +104,10 @@ namespace Jack
         float audio_size = (fNetAudioCaptureBuffer)
                         ? fNetAudioCaptureBuffer->GetCycleSize()
                         : (fNetAudioPlaybackBuffer) ? fNetAudioPlaybackBuffer->GetCycleSize() : 0;
+        // one parity packet per group of audio packets
+        if (fParams.fFecGroup > 0) {
+            audio_size += audio_size / fParams.fFecGroup + fParams.fMtu;
+        }
         jack_log("audio_size %f", audio_size);
 
         // midi
@@ -150,6 +161,15 @@ namespace Jack
         fTxData = fTxBuffer + HEADER_SIZE;
         fRxData = fRxBuffer + HEADER_SIZE;
 
+        // forward error correction buffers
+        fFecTxBuffer = new char[PACKET_AVAILABLE_SIZE(&fParams)];
+        fFecRxBuffer = new char[PACKET_AVAILABLE_SIZE(&fParams)];
+        fFecTxSize = 0;
+        fFecRxCycle = -1;
+        fFecRxGroup = -1;
+        fFecRxMask = 0;
+        fFecRxPackets = 0;
+
         return true;
     }
 
@@ -183,15 +203,46 @@ namespace Jack
             fTxHeader.fActivePorts = buffer->RenderFromJackPorts(fTxHeader.fFrames);
             fTxHeader.fNumPacket = buffer->GetNumPackets(fTxHeader.fActivePorts);
 
+            uint32_t group = fParams.fFecGroup;
+
             for (uint subproc = 0; subproc < fTxHeader.fNumPacket; subproc++) {
+                bool last = (subproc == (fTxHeader.fNumPacket - 1));
+                fTxHeader.fDataType = 'a';
                 fTxHeader.fSubCycle = subproc;
-                fTxHeader.fIsLastPckt = (subproc == (fTxHeader.fNumPacket - 1)) ? 1 : 0;
-                fTxHeader.fPacketSize = HEADER_SIZE + buffer->RenderToNetwork(subproc, fTxHeader.fActivePorts);
+                // With forward error correction, the last parity packet ends the cycle
+                fTxHeader.fIsLastPckt = (last && group == 0) ? 1 : 0;
+                uint32_t data_size = buffer->RenderToNetwork(subproc, fTxHeader.fActivePorts);
+                fTxHeader.fPacketSize = HEADER_SIZE + data_size;
+
+                if (group > 0) {
+                    if (subproc % group == 0) {
+                        memset(fFecTxBuffer, 0, PACKET_AVAILABLE_SIZE(&fParams));
+                        fFecTxSize = 0;
+                    }
+                    for (uint32_t byte = 0; byte < data_size; byte++) {
+                        fFecTxBuffer[byte] ^= fTxData[byte];
+                    }
+                    fFecTxSize = std::max(fFecTxSize, data_size);
+                }
+
                 memcpy(fTxBuffer, &fTxHeader, HEADER_SIZE);
                 //PacketHeaderDisplay(&fTxHeader);
                 if (Send(fTxHeader.fPacketSize, 0) == SOCKET_ERROR) {
                     return SOCKET_ERROR;
                 }
+
+                // Parity packet at the end of each group, the group index is sent as sub cycle
+                if (group > 0 && (last || (subproc % group == group - 1))) {
+                    fTxHeader.fDataType = 'f';
+                    fTxHeader.fSubCycle = subproc / group;
+                    fTxHeader.fIsLastPckt = (last) ? 1 : 0;
+                    fTxHeader.fPacketSize = HEADER_SIZE + fFecTxSize;
+                    memcpy(fTxData, fFecTxBuffer, fFecTxSize);
+                    memcpy(fTxBuffer, &fTxHeader, HEADER_SIZE);
+                    if (Send(fTxHeader.fPacketSize, 0) == SOCKET_ERROR) {
+                        return SOCKET_ERROR;
+                    }
+                }
             }
         }
         return 0;
@@ -220,6 +271,17 @@ namespace Jack
         fRxHeader.fIsLastPckt = rx_head->fIsLastPckt;
         fRxHeader.fActivePorts = rx_head->fActivePorts;
         fRxHeader.fFrames = rx_head->fFrames;
+
+        // Accumulate the parity of the group, to rebuild a lost packet
+        if (fParams.fFecGroup > 0 && rx_bytes >= int(HEADER_SIZE)) {
+            FecRxGroup(rx_head);
+            for (int byte = 0; byte < rx_bytes - int(HEADER_SIZE); byte++) {
+                fFecRxBuffer[byte] ^= fRxData[byte];
+            }
+            fFecRxMask |= 1U << (rx_head->fSubCycle % fParams.fFecGroup);
+            fFecRxPackets++;
+        }
+
         rx_bytes = buffer->RenderFromNetwork(rx_head->fCycle, rx_head->fSubCycle, fRxHeader.fActivePorts);
         
         // Last audio packet is received, so finish rendering...
@@ -230,6 +292,70 @@ namespace Jack
         return rx_bytes;
     }
 
+    void JackNetInterface::FecRxGroup(packet_header_t* rx_head)
+    {
+        int group = (rx_head->fDataType == 'f') ? rx_head->fSubCycle : rx_head->fSubCycle / fParams.fFecGroup;
+
+        if (int(rx_head->fCycle) != fFecRxCycle) {
+            fFecRxCycle = rx_head->fCycle;
+            fFecRxPackets = 0;
+            fFecRxGroup = -1;
+        }
+        if (group != fFecRxGroup) {
+            memset(fFecRxBuffer, 0, PACKET_AVAILABLE_SIZE(&fParams));
+            fFecRxGroup = group;
+            fFecRxMask = 0;
+        }
+    }
+
+    int JackNetInterface::FecRecv(packet_header_t* rx_head, NetAudioBuffer* buffer)
+    {
+        int rx_bytes = Recv(rx_head->fPacketSize, 0);
+        fRxHeader.fCycle = rx_head->fCycle;
+        fRxHeader.fIsLastPckt = rx_head->fIsLastPckt;
+        fRxHeader.fActivePorts = rx_head->fActivePorts;
+        fRxHeader.fFrames = rx_head->fFrames;
+
+        if (fParams.fFecGroup > 0 && rx_bytes >= int(HEADER_SIZE)) {
+            FecRxGroup(rx_head);
+
+            uint32_t first = rx_head->fSubCycle * fParams.fFecGroup;
+            uint32_t expected = std::min(fParams.fFecGroup, rx_head->fNumPacket - first);
+            uint32_t received = 0;
+            uint32_t missing = 0;
+            for (uint32_t packet = 0; packet < expected; packet++) {
+                if (fFecRxMask & (1U << packet)) {
+                    received++;
+                } else {
+                    missing = packet;
+                }
+            }
+
+            // Exactly one packet lost in the group : it is the parity of the received ones
+            if (received + 1 == expected) {
+                for (int byte = 0; byte < rx_bytes - int(HEADER_SIZE); byte++) {
+                    fRxData[byte] ^= fFecRxBuffer[byte];
+                }
+                fRxHeader.fSubCycle = first + missing;
+                buffer->RenderFromNetwork(rx_head->fCycle, fRxHeader.fSubCycle, fRxHeader.fActivePorts);
+                fFecRxPackets++;
+                jack_log("JackNetInterface::FecRecv packet %u rebuilt in cycle %u", fRxHeader.fSubCycle, rx_head->fCycle);
+            } else if (received + 1 < expected) {
+                jack_error("Packet(s) missing in group %u : %u lost, cannot be rebuilt", rx_head->fSubCycle, expected - received);
+            }
+            fFecRxGroup = -1;
+        }
+
+        // Last audio packet is received, so finish rendering...
+        if (fRxHeader.fIsLastPckt) {
+            buffer->RenderToJackPorts(fRxHeader.fFrames);
+            if (fFecRxPackets < rx_head->fNumPacket) {
+                return DATA_PACKET_ERROR;
+            }
+        }
+        return rx_bytes;
+    }
+
     int JackNetInterface::FinishRecv(NetAudioBuffer* buffer)
     {
         if (buffer) {
@@ -301,6 +427,18 @@ namespace Jack
             return false;
         }
 
+        // the shared send stream of a fan-out group goes to its own multicast group and port
+        if (fParams.fFanOutID > 0) {
+            if (fFanOutSocket.NewSocket() == SOCKET_ERROR) {
+                jack_error("Can't create fan-out socket : %s", StrError(NET_ERROR_CODE));
+                return false;
+            }
+            fFanOutSocket.SetAddress(fParams.fFanOutIP, fParams.fFanOutPort);
+            if (fFanOutSocket.SetLocalLoop() == SOCKET_ERROR) {
+                jack_error("Can't set local loop : %s", StrError(NET_ERROR_CODE));
+            }
+        }
+
         // send 'SLAVE_SETUP' until 'START_MASTER' received
         jack_info("Sending parameters to %s...", fParams.fSlaveNetName);
         do
@@ -343,6 +481,11 @@ namespace Jack
         fTxHeader.fDataStream = 's';
         fRxHeader.fDataStream = 'r';
 
+        // the slaves of a fan-out group all receive the shared send stream
+        if (fParams.fFanOutID > 0) {
+            fTxHeader.fID = fParams.fFanOutID;
+        }
+
         fMaxCycleOffset = fParams.fNetworkLatency;
 
         // midi net buffers
@@ -450,7 +593,8 @@ namespace Jack
         packet_header_t* header = reinterpret_cast<packet_header_t*>(fTxBuffer);
         PacketHeaderHToN(header, header);
 
-        if (((tx_bytes = fSocket.Send(fTxBuffer, size, flags)) == SOCKET_ERROR) && fRunning) {
+        tx_bytes = (fFanOutSending) ? fFanOutSocket.SendTo(fTxBuffer, size, flags) : fSocket.Send(fTxBuffer, size, flags);
+        if ((tx_bytes == SOCKET_ERROR) && fRunning) {
             FatalSendError();
         }
         return tx_bytes;
@@ -460,7 +604,10 @@ namespace Jack
     {
         SetRcvTimeOut();
         
-        fTxHeader.fCycle++;
+        // in a fan-out group, the cycle is set by the master from the shared clock
+        if (fParams.fFanOutID == 0) {
+            fTxHeader.fCycle++;
+        }
         fTxHeader.fSubCycle = 0;
         fTxHeader.fDataType = 's';
         fTxHeader.fIsLastPckt = (fParams.fSendMidiChannels == 0 && fParams.fSendAudioChannels == 0) ? 1 : 0;
@@ -545,6 +692,10 @@ namespace Jack
                         rx_bytes = AudioRecv(rx_head, fNetAudioPlaybackBuffer);
                         break;
 
+                    case 'f':   // audio parity
+                        rx_bytes = FecRecv(rx_head, fNetAudioPlaybackBuffer);
+                        break;
+
                     case 's':   // sync
                         jack_info("NetMaster : missing last data packet from '%s'", fParams.fName);
                         return FinishRecv(fNetAudioPlaybackBuffer);
@@ -749,9 +900,27 @@ namespace Jack
 
         // everything is OK, copy parameters
         fParams = host_params;
-     
-        // connect the socket
-        if (fSocket.Connect() == SOCKET_ERROR) {
+
+        if (fParams.fFanOutID > 0) {
+            // the send stream is multicasted by the master on the group and port of the fan-out :
+            // receive it on a dedicated socket, and keep the unconnected one to reply to the master
+            fFanOutSocket.SetPort(fParams.fFanOutPort);
+            if (fFanOutSocket.NewSocket() == SOCKET_ERROR) {
+                jack_error("Can't create fan-out socket : %s", StrError(NET_ERROR_CODE));
+                return NET_SOCKET_ERROR;
+            }
+            if (fFanOutSocket.Bind() == SOCKET_ERROR) {
+                jack_error("Can't bind the fan-out socket : %s", StrError(NET_ERROR_CODE));
+                return NET_SOCKET_ERROR;
+            }
+            if (fFanOutSocket.JoinMCastGroup(fParams.fFanOutIP) == SOCKET_ERROR) {
+                jack_error("Can't join multicast group : %s", StrError(NET_ERROR_CODE));
+                return NET_CONNECT_ERROR;
+            }
+            // the new socket gets the packet timeout on the first SyncRecv
+            fSetTimeOut = false;
+        } else if (fSocket.Connect() == SOCKET_ERROR) {
+            // connect the socket
             jack_error("Error in connect : %s", StrError(NET_ERROR_CODE));
             return NET_CONNECT_ERROR;
         }
@@ -768,7 +937,10 @@ namespace Jack
         memset(&net_params, 0, sizeof(session_params_t));
         SetPacketType(&fParams, START_MASTER);
         SessionParamsHToN(&fParams, &net_params);
-        if (fSocket.Send(&net_params, sizeof(session_params_t), 0) == SOCKET_ERROR) {
+        int tx_bytes = (fParams.fFanOutID > 0)
+            ? fSocket.SendTo(&net_params, sizeof(session_params_t), 0)
+            : fSocket.Send(&net_params, sizeof(session_params_t), 0);
+        if (tx_bytes == SOCKET_ERROR) {
             jack_error("Error in send : %s", StrError(NET_ERROR_CODE));
             return (fSocket.GetError() == NET_CONN_ERROR) ? NET_ERROR : NET_SEND_ERROR;
         }
@@ -786,6 +958,11 @@ namespace Jack
         fTxHeader.fDataStream = 'r';
         fRxHeader.fDataStream = 's';
 
+        // the send stream of a fan-out group is shared by all its slaves
+        if (fParams.fFanOutID > 0) {
+            fRxHeader.fID = fParams.fFanOutID;
+        }
+
         // midi net buffers
         if (fParams.fSendMidiChannels > 0) {
             fNetMidiCaptureBuffer = new NetMidiBuffer(&fParams, fParams.fSendMidiChannels, fRxData);
@@ -838,7 +1015,7 @@ namespace Jack
 
     int JackNetSlaveInterface::Recv(size_t size, int flags)
     {
-        int rx_bytes = fSocket.Recv(fRxBuffer, size, flags);
+        int rx_bytes = (fParams.fFanOutID > 0) ? fFanOutSocket.Recv(fRxBuffer, size, flags) : fSocket.Recv(fRxBuffer, size, flags);
         
         // handle errors
         if (rx_bytes == SOCKET_ERROR) {
@@ -854,7 +1031,7 @@ namespace Jack
     {
         packet_header_t* header = reinterpret_cast<packet_header_t*>(fTxBuffer);
         PacketHeaderHToN(header, header);
-        int tx_bytes = fSocket.Send(fTxBuffer, size, flags);
+        int tx_bytes = (fParams.fFanOutID > 0) ? fSocket.SendTo(fTxBuffer, size, flags) : fSocket.Send(fTxBuffer, size, flags);
 
         // handle errors
         if (tx_bytes == SOCKET_ERROR) {
@@ -864,6 +1041,17 @@ namespace Jack
         return tx_bytes;
     }
 
+    void JackNetSlaveInterface::SetRcvTimeOut()
+    {
+        if (!fSetTimeOut && fParams.fFanOutID > 0) {
+            if (fFanOutSocket.SetTimeOut(fPacketTimeOut) == SOCKET_ERROR) {
+                jack_error("Can't set rx timeout : %s", StrError(NET_ERROR_CODE));
+                return;
+            }
+        }
+        JackNetInterface::SetRcvTimeOut();
+    }
+
     int JackNetSlaveInterface::SyncRecv()
     {
         SetRcvTimeOut();
@@ -871,7 +1059,7 @@ namespace Jack
         int rx_bytes = 0;
         packet_header_t* rx_head = reinterpret_cast<packet_header_t*>(fRxBuffer);
      
-        // receive sync (launch the cycle)
+        // receive sync (launch the cycle), the unconnected socket of a fan-out slave may also get other streams
         do {
             rx_bytes = Recv(fParams.fMtu, 0);
             // connection issue (return -1)
@@ -879,7 +1067,7 @@ namespace Jack
                 return rx_bytes;
             }
         }
-        while (strcmp(rx_head->fPacketType, "header") != 0);
+        while (strcmp(rx_head->fPacketType, "header") != 0 || rx_head->fID != fRxHeader.fID);
         
         if (rx_head->fDataType != 's') {
             jack_error("Wrong packet type : %c", rx_head->fDataType);
@@ -908,7 +1096,7 @@ namespace Jack
                 return rx_bytes;
             }
 
-            if (rx_bytes && (rx_head->fDataStream == 's') && (rx_head->fID == fParams.fID)) {
+            if (rx_bytes && (rx_head->fDataStream == 's') && (rx_head->fID == fRxHeader.fID)) {
                 // read data
                 switch (rx_head->fDataType) {
 
@@ -920,10 +1108,17 @@ namespace Jack
                         rx_bytes = AudioRecv(rx_head, fNetAudioCaptureBuffer);
                         break;
 
+                    case 'f':   // audio parity
+                        rx_bytes = FecRecv(rx_head, fNetAudioCaptureBuffer);
+                        break;
+
                     case 's':   // sync
                         jack_info("NetSlave : missing last data packet");
                         return FinishRecv(fNetAudioCaptureBuffer);
                 }
+            } else if (rx_bytes) {
+                // not for this slave (another fan-out group) : drop it
+                Recv(rx_bytes, 0);
             }
         }
 
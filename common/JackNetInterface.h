@@ -40,6 +40,7 @@ namespace Jack
 
 #define NETWORK_DEFAULT_LATENCY     2
 #define NETWORK_MAX_LATENCY         30  // maximum possible latency in network master/slave loop
+#define NETWORK_MAX_FEC_GROUP       32  // maximum number of audio packets protected by one parity packet
 
     /**
     \Brief This class describes the basic Net Interface, used by both master and slave.
@@ -75,6 +76,15 @@ namespace Jack
             char* fTxData;
             char* fRxData;
 
+            // forward error correction : parity of the audio packets of the current group
+            char* fFecTxBuffer;
+            char* fFecRxBuffer;
+            uint32_t fFecTxSize;
+            int fFecRxCycle;
+            int fFecRxGroup;
+            uint32_t fFecRxMask;
+            uint32_t fFecRxPackets;
+
             // JACK buffers
             NetMidiBuffer* fNetMidiCaptureBuffer;
             NetMidiBuffer* fNetMidiPlaybackBuffer;
@@ -113,6 +123,8 @@ namespace Jack
 
             int MidiRecv(packet_header_t* rx_head, NetMidiBuffer* buffer, uint& recvd_midi_pckt);
             int AudioRecv(packet_header_t* rx_head, NetAudioBuffer* buffer);
+            int FecRecv(packet_header_t* rx_head, NetAudioBuffer* buffer);
+            void FecRxGroup(packet_header_t* rx_head);
 
             int FinishRecv(NetAudioBuffer* buffer);
 
@@ -150,6 +162,12 @@ namespace Jack
             int fMaxCycleOffset;
             bool fSynched;
 
+            // multicast socket of the fan-out group, only used by the master sending the shared stream
+            JackNetSocket fFanOutSocket;
+            // set by the manager thread, latched once per cycle by the process thread
+            volatile bool fFanOutLeader;
+            bool fFanOutSending;
+
             bool Init();
             bool SetParams();
 
@@ -178,14 +196,18 @@ namespace Jack
                 fRunning(false), 
                 fCurrentCycleOffset(0), 
                 fMaxCycleOffset(0), 
-                fSynched(false)
+                fSynched(false),
+                fFanOutLeader(false),
+                fFanOutSending(false)
             {}
             JackNetMasterInterface(session_params_t& params, JackNetSocket& socket, const char* multicast_ip)
                     : JackNetInterface(params, socket, multicast_ip), 
                     fRunning(false), 
                     fCurrentCycleOffset(0), 
                     fMaxCycleOffset(0), 
-                    fSynched(false)
+                    fSynched(false),
+                    fFanOutLeader(false),
+                    fFanOutSending(false)
             {}
 
             virtual~JackNetMasterInterface()
@@ -203,6 +225,9 @@ namespace Jack
 
             static uint fSlaveCounter;
 
+            // multicast socket receiving the shared send stream of a fan-out group
+            JackNetSocket fFanOutSocket;
+
             bool Init();
             bool InitConnection(int time_out_sec);
             bool InitRendering();
@@ -225,6 +250,8 @@ namespace Jack
             int Recv(size_t size, int flags);
             int Send(size_t size, int flags);
 
+            void SetRcvTimeOut();
+
             void FatalRecvError();
             void FatalSendError();
 
@@ -468,7 +468,8 @@ namespace Jack
         for (int audio_port_index = 0; audio_port_index < fParams.fSendAudioChannels; audio_port_index++) {
 
         #ifdef OPTIMIZED_PROTOCOL
-            if (fNetAudioCaptureBuffer->GetConnected(audio_port_index)) {
+            // A fan-out stream feeds all the slaves of the group, whatever the connections of this one
+            if (fParams.fFanOutID > 0 || fNetAudioCaptureBuffer->GetConnected(audio_port_index)) {
                 // Port is connected on other side...
                 fNetAudioCaptureBuffer->SetBuffer(audio_port_index,
                                                 ((jack_port_connected(fAudioCapturePorts[audio_port_index]) > 0)
@@ -493,7 +494,8 @@ namespace Jack
         for (int audio_port_index = 0; audio_port_index < fParams.fReturnAudioChannels; audio_port_index++) {
 
         #ifdef OPTIMIZED_PROTOCOL
-            sample_t* out = (jack_port_connected(fAudioPlaybackPorts[audio_port_index]) > 0)
+            // The sync packet of a fan-out group asks all the slaves for all their ports
+            sample_t* out = (fParams.fFanOutID > 0 || jack_port_connected(fAudioPlaybackPorts[audio_port_index]) > 0)
                 ? static_cast<sample_t*>(jack_port_get_buffer(fAudioPlaybackPorts[audio_port_index], fParams.fPeriodSize))
                 : NULL;
             if (out) {
@@ -509,20 +511,33 @@ namespace Jack
         #endif
         }
 
-        // encode the first packet
-        EncodeSyncPacket();
-
-        if (SyncSend() == SOCKET_ERROR) {
-            return SOCKET_ERROR;
+        // the masters of a fan-out group count cycles with the same clock, only the leader sends the shared stream
+        if (fParams.fFanOutID > 0) {
+            fTxHeader.fCycle = jack_last_frame_time(fClient) / fParams.fPeriodSize;
         }
 
-#ifdef JACK_MONITOR
-        fNetTimeMon->Add((((float)(GetMicroSeconds() - begin_time)) / (float) fPeriodUsecs) * 100.f);
-#endif
+        // the leader role may be handed over by the manager thread : only look at it once per cycle
+        fFanOutSending = fFanOutLeader;
+
+        if (fParams.fFanOutID == 0 || fFanOutSending) {
 
-        // send data
-        if (DataSend() == SOCKET_ERROR) {
-            return SOCKET_ERROR;
+            // encode the first packet
+            EncodeSyncPacket();
+
+            if (SyncSend() == SOCKET_ERROR) {
+                return SOCKET_ERROR;
+            }
+
+        #ifdef JACK_MONITOR
+            fNetTimeMon->Add((((float)(GetMicroSeconds() - begin_time)) / (float) fPeriodUsecs) * 100.f);
+        #endif
+
+            // send data
+            if (DataSend() == SOCKET_ERROR) {
+                return SOCKET_ERROR;
+            }
+        } else {
+            SetRcvTimeOut();
         }
 
 #ifdef JACK_MONITOR
@@ -630,6 +645,48 @@ namespace Jack
         }
     }
 
+    bool JackNetMaster::SameSendStream(const session_params_t& params)
+    {
+        return (fParams.fFanOutID > 0)
+            && (fParams.fSendAudioChannels == params.fSendAudioChannels)
+            && (fParams.fSendMidiChannels == params.fSendMidiChannels)
+            && (fParams.fSampleEncoder == params.fSampleEncoder)
+            && (fParams.fKBps == params.fKBps)
+            && (fParams.fMtu == params.fMtu)
+            && (fParams.fFecGroup == params.fFecGroup)
+            && (fParams.fSampleRate == params.fSampleRate)
+            && (fParams.fPeriodSize == params.fPeriodSize);
+    }
+
+    void JackNetMaster::TakeFanOut(JackNetMaster* leader)
+    {
+        jack_info("'%s' now sends the fan-out stream %u", fParams.fName, fParams.fFanOutID);
+
+        // Feed the new leader like the previous one
+        for (int i = 0; i < fParams.fSendAudioChannels; i++) {
+            const char** connected_port = jack_port_get_all_connections(fClient, leader->fAudioCapturePorts[i]);
+            if (connected_port != NULL) {
+                for (int port = 0; connected_port[port]; port++) {
+                    jack_connect(fClient, connected_port[port], jack_port_name(fAudioCapturePorts[i]));
+                }
+                jack_free(connected_port);
+            }
+        }
+
+        for (int i = 0; i < fParams.fSendMidiChannels; i++) {
+            const char** connected_port = jack_port_get_all_connections(fClient, leader->fMidiCapturePorts[i]);
+            if (connected_port != NULL) {
+                for (int port = 0; connected_port[port]; port++) {
+                    jack_connect(fClient, connected_port[port], jack_port_name(fMidiCapturePorts[i]));
+                }
+                jack_free(connected_port);
+            }
+        }
+
+        // picked up by Process at the start of the next cycle
+        fFanOutLeader = true;
+    }
+
 
 //JackNetMasterManager***********************************************************************************************
 
@@ -643,6 +700,7 @@ namespace Jack
         fRunning = true;
         fAutoConnect = false;
         fAutoSave = false;
+        fFanOut = false;
 
         const JSList* node;
         const jack_driver_param_t* param;
@@ -683,6 +741,10 @@ namespace Jack
                 case 's':
                     fAutoSave = true;
                     break;
+
+                case 'f':
+                    fFanOut = true;
+                    break;
             }
         }
 
@@ -886,9 +948,29 @@ namespace Jack
             jack_info("Takes physical %d MIDI output(s) for slave", params.fReturnMidiChannels);
         }
 
+        //join the fan-out group sending the same stream, or start a new one
+        params.fFanOutID = 0;
+        if (fFanOut) {
+            for (master_list_it_t it = fMasterList.begin(); it != fMasterList.end(); it++) {
+                if ((*it)->SameSendStream(params)) {
+                    params.fFanOutID = (*it)->fParams.fFanOutID;
+                    break;
+                }
+            }
+            if (params.fFanOutID == 0) {
+                params.fFanOutID = NewFanOutID();
+            }
+            //each group streams on its own port of the multicast group, away from the discovery traffic
+            strcpy(params.fFanOutIP, fMulticastIP);
+            params.fFanOutPort = fSocket.GetPort() + params.fFanOutID;
+        }
+
         //create a new master and add it to the list
         JackNetMaster* master = new JackNetMaster(fSocket, params, fMulticastIP);
         if (master->Init(fAutoConnect)) {
+            if (params.fFanOutID > 0 && FindFanOutLeader(params.fFanOutID) == fMasterList.end()) {
+                master->fFanOutLeader = true;
+            }
             fMasterList.push_back(master);
             if (fAutoSave && fMasterConnectionList.find(params.fName) != fMasterConnectionList.end()) {
                 master->LoadConnections(fMasterConnectionList[params.fName]);
@@ -913,18 +995,58 @@ namespace Jack
         return it;
     }
 
+    master_list_it_t JackNetMasterManager::FindFanOutLeader(uint32_t fan_out_id)
+    {
+        master_list_it_t it;
+        for (it = fMasterList.begin(); it != fMasterList.end(); it++) {
+            if ((*it)->fParams.fFanOutID == fan_out_id && (*it)->IsFanOutLeader()) {
+                return it;
+            }
+        }
+        return it;
+    }
+
+    uint32_t JackNetMasterManager::NewFanOutID()
+    {
+        //smallest ID not used by a running group, so that the fan-out ports stay next to the discovery one
+        uint32_t fan_out_id = 1;
+        master_list_it_t it = fMasterList.begin();
+        while (it != fMasterList.end()) {
+            if ((*it)->fParams.fFanOutID == fan_out_id) {
+                fan_out_id++;
+                it = fMasterList.begin();
+            } else {
+                it++;
+            }
+        }
+        return fan_out_id;
+    }
+
     int JackNetMasterManager::KillMaster(session_params_t* params)
     {
         jack_log("JackNetMasterManager::KillMaster ID = %u", params->fID);
 
         master_list_it_t master_it = FindMaster(params->fID);
         if (master_it != fMasterList.end()) {
+            JackNetMaster* master = *master_it;
             if (fAutoSave) {
                 fMasterConnectionList[params->fName].clear();
-                (*master_it)->SaveConnections(fMasterConnectionList[params->fName]);
+                master->SaveConnections(fMasterConnectionList[params->fName]);
             }
             fMasterList.erase(master_it);
-            delete (*master_it);
+
+            //another master of the group takes over the fan-out stream
+            if (master->IsFanOutLeader()) {
+                master->fFanOutLeader = false;
+                for (master_list_it_t it = fMasterList.begin(); it != fMasterList.end(); it++) {
+                    if ((*it)->fParams.fFanOutID == master->fParams.fFanOutID) {
+                        (*it)->TakeFanOut(master);
+                        break;
+                    }
+                }
+            }
+
+            delete master;
             return 1;
         }
         return 0;
@@ -958,6 +1080,9 @@ extern "C"
         value.i = false;
         jack_driver_descriptor_add_parameter(desc, &filler, "auto-save", 's', JackDriverParamBool, &value, NULL, "Save/restore netmaster connection state when restarted", NULL);
 
+        value.i = false;
+        jack_driver_descriptor_add_parameter(desc, &filler, "fan-out", 'f', JackDriverParamBool, &value, NULL, "Multicast send streams shared by slaves", "Slaves with the same send configuration share one send stream, encoded once and multicasted on the next UDP ports");
+
         return desc;
     }
 
@@ -83,6 +83,14 @@ namespace Jack
             void SaveConnections(connections_list_t& connections);
             void LoadConnections(const connections_list_t& connections);
 
+            //fan-out
+            bool IsFanOutLeader()
+            {
+                return fFanOutLeader;
+            }
+            bool SameSendStream(const session_params_t& params);
+            void TakeFanOut(JackNetMaster* leader);
+
         public:
 
             JackNetMaster(JackNetSocket& socket, session_params_t& params, const char* multicast_ip);
@@ -120,10 +128,13 @@ namespace Jack
             bool fRunning;
             bool fAutoConnect;
             bool fAutoSave;
+            bool fFanOut;
 
             void Run();
             JackNetMaster* InitMaster(session_params_t& params);
             master_list_it_t FindMaster(uint32_t client_id);
+            master_list_it_t FindFanOutLeader(uint32_t fan_out_id);
+            uint32_t NewFanOutID();
             int KillMaster(session_params_t* params);
             int SyncCallback(jack_transport_state_t state, jack_position_t* pos);
             int CountIO(const char* type, int flags);
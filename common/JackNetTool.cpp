@@ -206,6 +206,7 @@ namespace Jack
         fNPorts = nports;
         fNetBuffer = net_buffer;
         fNumPackets = 0;
+        fFecGroup = params->fFecGroup;
 
         fPortBuffer = new sample_t*[fNPorts];
         fConnectedPorts = new bool[fNPorts];
@@ -215,7 +216,7 @@ namespace Jack
             fConnectedPorts[port_index] = true;
         }
         
-        fLastSubCycle = 0;
+        fLastSubCycle = -1;
         fPeriodSize = 0;
         fSubPeriodSize = 0;
         fSubPeriodBytesSize = 0;
@@ -241,13 +242,17 @@ namespace Jack
 
     int NetAudioBuffer::CheckPacket(int cycle, int sub_cycle)
     {
-        int res;
+        int res = 0;
+
+        // Packet rebuilt from parity, after the following ones were received
+        if (fFecGroup > 0 && sub_cycle <= fLastSubCycle) {
+            return res;
+        }
 
-        if (sub_cycle != fLastSubCycle + 1) {
+        // With forward error correction, the interface reports the packets that could not be rebuilt at the end of the cycle
+        if (sub_cycle != fLastSubCycle + 1 && fFecGroup == 0) {
             jack_error("Packet(s) missing from... %d %d", fLastSubCycle, sub_cycle);
             res = DATA_PACKET_ERROR;
-        } else {
-            res = 0;
         }
 
         fLastSubCycle = sub_cycle;
@@ -383,8 +388,8 @@ namespace Jack
 
     int NetFloatAudioBuffer::RenderFromNetwork(int cycle, int sub_cycle, uint32_t port_num)
     {
-        // Cleanup all JACK ports at the beginning of the cycle
-        if (sub_cycle == 0) {
+        // Cleanup all JACK ports at the first packet received in the cycle
+        if (fLastSubCycle < 0) {
             Cleanup();
         }
 
@@ -680,8 +685,8 @@ namespace Jack
     //network<->buffer
     int NetCeltAudioBuffer::RenderFromNetwork(int cycle, int sub_cycle, uint32_t port_num)
     {
-        // Cleanup all JACK ports at the beginning of the cycle
-        if (sub_cycle == 0) {
+        // Cleanup all JACK ports at the first packet received in the cycle
+        if (fLastSubCycle < 0) {
             Cleanup();
         }
 
@@ -896,8 +901,8 @@ namespace Jack
     //network<->buffer
     int NetOpusAudioBuffer::RenderFromNetwork(int cycle, int sub_cycle, uint32_t port_num)
     {
-        // Cleanup all JACK ports at the beginning of the cycle
-        if (sub_cycle == 0) {
+        // Cleanup all JACK ports at the first packet received in the cycle
+        if (fLastSubCycle < 0) {
             Cleanup();
         }
 
@@ -1037,8 +1042,8 @@ namespace Jack
     //network<->buffer
     int NetIntAudioBuffer::RenderFromNetwork(int cycle, int sub_cycle, uint32_t port_num)
     {
-        // Cleanup all JACK ports at the beginning of the cycle
-        if (sub_cycle == 0) {
+        // Cleanup all JACK ports at the first packet received in the cycle
+        if (fLastSubCycle < 0) {
             Cleanup();
         }
 
@@ -1097,6 +1102,9 @@ namespace Jack
         dst_params->fKBps = htonl(src_params->fKBps);
         dst_params->fSlaveSyncMode = htonl(src_params->fSlaveSyncMode);
         dst_params->fNetworkLatency = htonl(src_params->fNetworkLatency);
+        dst_params->fFecGroup = htonl(src_params->fFecGroup);
+        dst_params->fFanOutID = htonl(src_params->fFanOutID);
+        dst_params->fFanOutPort = htonl(src_params->fFanOutPort);
     }
 
     SERVER_EXPORT void SessionParamsNToH(session_params_t* src_params, session_params_t* dst_params)
@@ -1117,6 +1125,9 @@ namespace Jack
         dst_params->fKBps = ntohl(src_params->fKBps);
         dst_params->fSlaveSyncMode = ntohl(src_params->fSlaveSyncMode);
         dst_params->fNetworkLatency = ntohl(src_params->fNetworkLatency);
+        dst_params->fFecGroup = ntohl(src_params->fFecGroup);
+        dst_params->fFanOutID = ntohl(src_params->fFanOutID);
+        dst_params->fFanOutPort = ntohl(src_params->fFanOutPort);
     }
 
     SERVER_EXPORT void SessionParamsDisplay(session_params_t* params)
@@ -1151,6 +1162,14 @@ namespace Jack
         jack_info("Sample rate : %u frames per second", params->fSampleRate);
         jack_info("Period size : %u frames per period", params->fPeriodSize);
         jack_info("Network latency : %u cycles", params->fNetworkLatency);
+        if (params->fFecGroup > 0) {
+            jack_info("Forward error correction : one parity packet every %u audio packets", params->fFecGroup);
+        } else {
+            jack_info("Forward error correction : no");
+        }
+        if (params->fFanOutID > 0) {
+            jack_info("Fan-out : multicast send stream %u on %s:%u", params->fFanOutID, params->fFanOutIP, params->fFanOutPort);
+        }
         switch (params->fSampleEncoder) {
             case (JackFloatEncoder):
                 jack_info("SampleEncoder : %s", "Float");
@@ -38,7 +38,7 @@ using namespace std;
 #endif
 #endif
 
-#define NETWORK_PROTOCOL 8
+#define NETWORK_PROTOCOL 11
 
 #define NET_SYNCHING      0
 #define SYNC_PACKET_ERROR -2
@@ -82,6 +82,8 @@ namespace Jack
         - number of audio frames in one network packet (depends on the channel number)
         - is the NetDriver in Sync or ASync mode ?
         - is the NetDriver linked with the master's transport
+        - the number of audio packets protected by one parity packet (forward error correction)
+        - the ID of the send stream shared by a fan-out group of slaves, and the multicast group and port it is sent to
 
     Data encoding : headers (session_params and packet_header) are encoded using HTN kind of functions but float data
     are kept in LITTLE_ENDIAN format (to avoid 2 conversions in the more common LITTLE_ENDIAN <==> LITTLE_ENDIAN connection case).
@@ -109,6 +111,10 @@ namespace Jack
         uint32_t fKBps;                             //KB per second for CELT encoder
         uint32_t fSlaveSyncMode;                    //is the slave in sync mode ?
         uint32_t fNetworkLatency;                   //network latency
+        uint32_t fFecGroup;                         //audio packets per parity packet (0 : no forward error correction)
+        uint32_t fFanOutID;                         //ID of the multicast send stream (0 : unicast)
+        char fFanOutIP[32];                         //multicast group of the send stream
+        uint32_t fFanOutPort;                       //multicast port of the send stream
     } POST_PACKED_STRUCTURE;
 
 //net status **********************************************************************************
@@ -174,14 +180,14 @@ namespace Jack
     struct _packet_header
     {
         char fPacketType[8];        //packet type ('headr')
-        uint32_t fDataType;         //'a' for audio, 'm' for midi and 's' for sync
+        uint32_t fDataType;         //'a' for audio, 'm' for midi, 's' for sync and 'f' for audio parity
         uint32_t fDataStream;       //'s' for send, 'r' for return
         uint32_t fID;               //unique ID of the slave
         uint32_t fNumPacket;        //number of data packets of the cycle
         uint32_t fPacketSize;       //packet size in bytes
         uint32_t fActivePorts;      //number of active ports
         uint32_t fCycle;            //process cycle counter
-        uint32_t fSubCycle;         //midi/audio subcycle counter
+        uint32_t fSubCycle;         //midi/audio subcycle counter (group counter for audio parity)
         int32_t fFrames;            //process cycle size in frames (can be -1 to indicate entire buffer)
         uint32_t fIsLastPckt;       //is it the last packet of a given cycle ('y' or 'n')
     } POST_PACKED_STRUCTURE;
@@ -286,6 +292,7 @@ namespace Jack
             int fNPorts;
             int fLastSubCycle;
             int fNumPackets;
+            uint32_t fFecGroup;
 
             char* fNetBuffer;
             sample_t** fPortBuffer;
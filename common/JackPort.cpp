@@ -21,6 +21,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackPort.h"
 #include "JackError.h"
 #include "JackPortType.h"
+#include "JackAtomic.h"
 #include <stdio.h>
 #include <assert.h>
 
@@ -50,14 +51,18 @@ bool JackPort::Allocate(int refnum, const char* port_name, const char* port_type
     fPlaybackLatency.min = fPlaybackLatency.max = 0;
     fCaptureLatency.min = fCaptureLatency.max = 0;
     fTied = NO_PORT;
+    fCopy = NO_PORT;
+    fNextCopy = NO_PORT;
     fAlias1[0] = '\0';
     fAlias2[0] = '\0';
+    fBufferFrames = 0;
     // DB: At this point we do not know current buffer size in frames,
     // but every time buffer will be returned to any user,
     // it will be called with either ClearBuffer or MixBuffers
     // with correct current buffer size.
     // So it is safe to init with 0 here.
     ClearBuffer(0);
+    ReleaseGains();
     return true;
 }
 
@@ -73,8 +78,13 @@ void JackPort::Release()
     fPlaybackLatency.min = fPlaybackLatency.max = 0;
     fCaptureLatency.min = fCaptureLatency.max = 0;
     fTied = NO_PORT;
+    fCopy = NO_PORT;
+    fNextCopy = NO_PORT;
+    fIsCopy = false;
     fAlias1[0] = '\0';
     fAlias2[0] = '\0';
+    fBufferFrames = 0;
+    ReleaseGains();
 }
 
 int JackPort::GetRefNum() const
@@ -304,4 +314,80 @@ void JackPort::MixBuffers(void** src_buffers, int src_count, jack_nframes_t buff
     (type->mixdown)(GetBuffer(), src_buffers, src_count, buffer_size);
 }
 
+void JackPort::MixBuffers(void** src_buffers, const jack_default_audio_sample_t* start_gains, const jack_default_audio_sample_t* end_gains, int src_count, jack_nframes_t buffer_size)
+{
+    const JackPortType* type = GetPortType(fTypeId);
+    (type->mixdown_gain)(GetBuffer(), src_buffers, start_gains, end_gains, src_count, buffer_size);
+}
+
+// RT : when 'ramp' is true, the gain of each connection goes from its previous value to the current setting during the cycle
+void JackPort::GetGains(const jack_port_id_t* src_ports, int src_count, jack_default_audio_sample_t* start_gains, jack_default_audio_sample_t* end_gains, bool ramp)
+{
+    for (int i = 0; i < src_count; i++) {
+        JackConnectionGain* gain = FindGain(src_ports[i]);
+        if (gain) {
+            jack_default_audio_sample_t target = (gain->fMute) ? 0.f : gain->fGain;
+            start_gains[i] = (ramp) ? gain->fCurrentGain : target;
+            end_gains[i] = target;
+            if (ramp) {
+                gain->fCurrentGain = target;
+            }
+        } else {
+            start_gains[i] = end_gains[i] = 1.f;
+        }
+    }
+}
+
+JackConnectionGain* JackPort::FindGain(jack_port_id_t src_index)
+{
+    for (int i = 0; i < CONNECTION_GAIN_NUM_FOR_PORT; i++) {
+        if (GetGain(i)->fSource == src_index) {
+            return GetGain(i);
+        }
+    }
+    return NULL;
+}
+
+JackConnectionGain* JackPort::AllocateGain(jack_port_id_t src_index)
+{
+    JackConnectionGain* gain = FindGain(src_index);
+    if (gain) {
+        return gain;
+    }
+
+    // Lock-free : a slot is taken by atomically setting its source, free slots always have unity gain
+    for (int i = 0; i < CONNECTION_GAIN_NUM_FOR_PORT; i++) {
+        if (CAS(NO_PORT, src_index, &GetGain(i)->fSource)) {
+            INC_ATOMIC(GetGainCount());
+            return GetGain(i);
+        }
+    }
+    return NULL;
+}
+
+void JackPort::ReleaseGain(jack_port_id_t src_index)
+{
+    for (int i = 0; i < CONNECTION_GAIN_NUM_FOR_PORT; i++) {
+        JackConnectionGain* gain = GetGain(i);
+        if (gain->fSource == src_index) {
+            gain->fGain = gain->fCurrentGain = 1.f;
+            gain->fMute = 0;
+            if (CAS(src_index, NO_PORT, &gain->fSource)) {
+                DEC_ATOMIC(GetGainCount());
+            }
+        }
+    }
+}
+
+void JackPort::ReleaseGains()
+{
+    for (int i = 0; i < CONNECTION_GAIN_NUM_FOR_PORT; i++) {
+        JackConnectionGain* gain = GetGain(i);
+        gain->fGain = gain->fCurrentGain = 1.f;
+        gain->fMute = 0;
+        gain->fSource = NO_PORT;
+    }
+    fGainCounter[0] = fGainCounter[1] = 0;
+}
+
 } // end of namespace
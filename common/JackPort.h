@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "types.h"
 #include "JackConstants.h"
 #include "JackCompilerDeps.h"
+#include "JackTypes.h"
 
 namespace Jack
 {
@@ -31,6 +32,20 @@ namespace Jack
 #define ALL_PORTS	0xFFFF
 #define NO_PORT		0xFFFE
 
+/*!
+\brief Gain and mute of a connection, kept by the destination port.
+*/
+
+PRE_PACKED_STRUCTURE
+struct JackConnectionGain
+{
+    volatile UInt32 fSource;                        // NO_PORT when the slot is free
+    volatile jack_default_audio_sample_t fGain;
+    volatile UInt32 fMute;
+    jack_default_audio_sample_t fCurrentGain;       // Gain reached at the end of the last mix (RT)
+
+} POST_PACKED_STRUCTURE;
+
 /*!
 \brief Base class for port.
 */
@@ -58,6 +73,18 @@ class SERVER_EXPORT JackPort
 
         bool fInUse;
         jack_port_id_t fTied;   // Locally tied source port
+        jack_port_id_t fCopy;   // Output port of a pipelined client : slot keeping its buffer of the previous cycle for the other clients
+        jack_port_id_t fNextCopy;   // Input port of a multi-rate client : slot accumulating the next block, swapped with fCopy
+        bool fIsCopy;           // Slot used as a copy, not as a port
+        char fGainSlots[CONNECTION_GAIN_NUM_FOR_PORT * sizeof(JackConnectionGain) + 3];   // Gain slots, in the aligned part (see GetGain)
+        SInt32 fGainCounter[2];         // Number of used gain slots, in the aligned word (see GetGainCount)
+
+        // Input buffer resolved for a cycle, graph state and buffer size (see JackGraphManager::GetBuffer)
+        UInt32 fBufferCycle;
+        UInt16 fBufferState;
+        jack_nframes_t fBufferFrames;   // 0 when nothing is resolved
+        UInt32 fBufferOffset;           // From the graph manager start, 0 for the shared silence buffer
+
         jack_default_audio_sample_t fBuffer[BUFFER_SIZE_MAX + 8];
 
         bool IsUsed() const
@@ -68,6 +95,24 @@ class SERVER_EXPORT JackPort
         // RT
         void ClearBuffer(jack_nframes_t frames);
         void MixBuffers(void** src_buffers, int src_count, jack_nframes_t frames);
+        void MixBuffers(void** src_buffers, const jack_default_audio_sample_t* start_gains, const jack_default_audio_sample_t* end_gains, int src_count, jack_nframes_t frames);
+        void GetGains(const jack_port_id_t* src_ports, int src_count, jack_default_audio_sample_t* start_gains, jack_default_audio_sample_t* end_gains, bool ramp);
+
+        // The structure is packed : atomic operations use the aligned word of the counter storage,
+        // and the aligned part of the slot storage where slot sources are taken with CAS
+        volatile SInt32* GetGainCount()
+        {
+            return (volatile SInt32*)(((uintptr_t)fGainCounter + 3) & ~3L);
+        }
+        JackConnectionGain* GetGain(int slot)
+        {
+            return (JackConnectionGain*)(((uintptr_t)fGainSlots + 3) & ~3L) + slot;
+        }
+
+        JackConnectionGain* FindGain(jack_port_id_t src_index);
+        JackConnectionGain* AllocateGain(jack_port_id_t src_index);
+        void ReleaseGain(jack_port_id_t src_index);
+        void ReleaseGains();
 
     public:
 
@@ -115,6 +160,28 @@ class SERVER_EXPORT JackPort
 
 } POST_PACKED_STRUCTURE;
 
+#define METER_PEAK_HOLD_RATE 10     // Peaks are held for 1/10 second
+
+/*!
+\brief Port meter, computed in each cycle for ports where metering has been requested (see JackGraphManager::UpdateMeter).
+Readers only read fPeak and fRMS, the hold fields are only used by the process metering the port.
+*/
+
+PRE_PACKED_STRUCTURE
+struct JackPortMeter
+{
+    volatile UInt32 fEnabled;
+    jack_default_audio_sample_t fPeak;          // Highest peak of the previous and current hold periods
+    jack_default_audio_sample_t fRMS;           // RMS of the last cycle
+    jack_default_audio_sample_t fHeldPeak;      // Highest peak of the previous hold period
+    jack_default_audio_sample_t fHoldPeak;      // Highest peak of the current hold period
+    UInt32 fHoldFrames;                         // Frames metered in the current hold period
+
+    JackPortMeter():fEnabled(0), fPeak(0.f), fRMS(0.f), fHeldPeak(0.f), fHoldPeak(0.f), fHoldFrames(0)
+    {}
+
+} POST_PACKED_STRUCTURE;
+
 } // end of namespace
 
 
@@ -18,6 +18,9 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 */
 
 #include "JackPortType.h"
+#include "JackGraphManager.h"
+#include "JackGlobals.h"
+#include "JackError.h"
 #include <string.h>
 #include <assert.h>
 
@@ -28,29 +31,195 @@ static const JackPortType* gPortTypes[] =
 {
     &gAudioPortType,
     &gMidiPortType,
+    &gControlPortType,
+    &gLastControlPortType,
 };
 
-const jack_port_type_id_t PORT_TYPES_MAX = sizeof(gPortTypes) / sizeof(gPortTypes[0]);
+static const jack_port_type_id_t BUILTIN_PORT_TYPES = sizeof(gPortTypes) / sizeof(gPortTypes[0]);
+
+const jack_port_type_id_t PORT_TYPES_MAX = BUILTIN_PORT_TYPES + CUSTOM_PORT_TYPE_NUM;
+
+/*
+Types registered by clients get their id from the slot the server gives them in the graph manager (see
+JackGraphManager::RegisterPortType), so that all processes agree on it. Their functions are only known by the processes
+which registered them with jack_port_type_register : the other ones, the server included, clear the whole buffer and
+mix by copying the last connection. Each slot has its own JackPortType functions, which find the slot data.
+*/
+
+struct JackCustomPortType
+{
+    char fName[JACK_PORT_TYPE_SIZE + 1];
+    size_t fSize;
+    JackPortTypeInitCallback fInit;
+    JackPortTypeMixdownCallback fMixdown;
+    JackGraphManager* fManager;     // Graph manager the slot has been resolved in, NULL if not resolved
+};
+
+static JackCustomPortType gRegisteredPortTypes[CUSTOM_PORT_TYPE_NUM];   // Registered by this process, by name
+static JackCustomPortType gCustomPortTypes[CUSTOM_PORT_TYPE_NUM];       // By slot
+
+template <int slot>
+static size_t CustomBufferSize()
+{
+    return gCustomPortTypes[slot].fSize;
+}
+
+template <int slot>
+static void CustomBufferInit(void* buffer, size_t, jack_nframes_t)
+{
+    const JackCustomPortType* type = &gCustomPortTypes[slot];
+    if (type->fInit) {
+        type->fInit(buffer, type->fSize);
+    } else {
+        memset(buffer, 0, type->fSize);
+    }
+}
+
+template <int slot>
+static void CustomBufferMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t)
+{
+    const JackCustomPortType* type = &gCustomPortTypes[slot];
+    if (type->fMixdown) {
+        type->fMixdown(mixbuffer, src_buffers, src_count, type->fSize);
+    } else {
+        memcpy(mixbuffer, src_buffers[src_count - 1], type->fSize);
+    }
+}
+
+#define CUSTOM_PORT_TYPE(slot) \
+    { gCustomPortTypes[slot].fName, CustomBufferSize<slot>, CustomBufferInit<slot>, CustomBufferMixdown<slot>, NULL, NULL, NULL }
+
+// One entry per slot, CUSTOM_PORT_TYPE_NUM entries
+static const JackPortType gCustomPortTypeTable[] =
+{
+    CUSTOM_PORT_TYPE(0), CUSTOM_PORT_TYPE(1), CUSTOM_PORT_TYPE(2), CUSTOM_PORT_TYPE(3),
+    CUSTOM_PORT_TYPE(4), CUSTOM_PORT_TYPE(5), CUSTOM_PORT_TYPE(6), CUSTOM_PORT_TYPE(7),
+    CUSTOM_PORT_TYPE(8), CUSTOM_PORT_TYPE(9), CUSTOM_PORT_TYPE(10), CUSTOM_PORT_TYPE(11),
+    CUSTOM_PORT_TYPE(12), CUSTOM_PORT_TYPE(13), CUSTOM_PORT_TYPE(14), CUSTOM_PORT_TYPE(15),
+};
+
+typedef char CheckCustomPortTypeTable[(sizeof(gCustomPortTypeTable) / sizeof(gCustomPortTypeTable[0]) == CUSTOM_PORT_TYPE_NUM) ? 1 : -1];
+
+static JackCustomPortType* FindRegisteredPortType(const char* port_type)
+{
+    for (int i = 0; i < CUSTOM_PORT_TYPE_NUM && gRegisteredPortTypes[i].fName[0] != 0; i++) {
+        if (strcmp(gRegisteredPortTypes[i].fName, port_type) == 0) {
+            return &gRegisteredPortTypes[i];
+        }
+    }
+    return NULL;
+}
+
+// Resolved again when the process uses another server
+static const JackPortType* GetCustomPortType(int slot)
+{
+    JackCustomPortType* type = &gCustomPortTypes[slot];
+    JackGraphManager* manager = GetGraphManager();
+
+    if (type->fManager != manager) {
+        if (!manager) {
+            return NULL;
+        }
+        const JackPortTypeInfo* info = manager->GetPortTypeInfo(slot);
+        if (info->fName[0] == 0) {
+            return NULL;
+        }
+        JackCustomPortType* registered = FindRegisteredPortType(info->fName);
+        strcpy(type->fName, info->fName);
+        type->fSize = info->fSize;
+        type->fInit = (registered) ? registered->fInit : NULL;
+        type->fMixdown = (registered) ? registered->fMixdown : NULL;
+        type->fManager = manager;
+    }
+
+    return &gCustomPortTypeTable[slot];
+}
 
 jack_port_type_id_t GetPortTypeId(const char* port_type)
 {
-    for (jack_port_type_id_t i = 0; i < PORT_TYPES_MAX; ++i) {
+    for (jack_port_type_id_t i = 0; i < BUILTIN_PORT_TYPES; ++i) {
         const JackPortType* type = gPortTypes[i];
         assert(type != NULL);
         if (strcmp(port_type, type->fName) == 0) {
             return i;
         }
     }
-    return PORT_TYPES_MAX;
+
+    JackGraphManager* manager = GetGraphManager();
+    int slot = (manager) ? manager->FindPortType(port_type) : -1;
+    return (slot >= 0) ? BUILTIN_PORT_TYPES + slot : PORT_TYPES_MAX;
 }
 
 const JackPortType* GetPortType(jack_port_type_id_t type_id)
 {
     if (type_id >= PORT_TYPES_MAX)
         return NULL;
+    if (type_id >= BUILTIN_PORT_TYPES)
+        return GetCustomPortType(type_id - BUILTIN_PORT_TYPES);
     const JackPortType* type = gPortTypes[type_id];
     assert(type != NULL);
     return type;
 }
 
+int RegisterPortType(const char* port_type, size_t buffer_size, JackPortTypeInitCallback init, JackPortTypeMixdownCallback mixdown)
+{
+    if (buffer_size == 0 || buffer_size > BUFFER_SIZE_MAX * sizeof(jack_default_audio_sample_t)
+        || strlen(port_type) > JACK_PORT_TYPE_SIZE || GetPortTypeId(port_type) < BUILTIN_PORT_TYPES) {
+        jack_error("Cannot register port type = %s with buffer size = %ld", port_type, buffer_size);
+        return -1;
+    }
+
+    JackCustomPortType* type = FindRegisteredPortType(port_type);
+    if (type && type->fSize != buffer_size) {
+        jack_error("Port type = %s is already registered with buffer size = %ld", port_type, type->fSize);
+        return -1;
+    }
+
+    for (int i = 0; !type && i < CUSTOM_PORT_TYPE_NUM; i++) {
+        if (gRegisteredPortTypes[i].fName[0] == 0) {
+            type = &gRegisteredPortTypes[i];
+            strcpy(type->fName, port_type);
+            type->fSize = buffer_size;
+        }
+    }
+
+    if (!type) {
+        jack_error("No more slot to register port type = %s", port_type);
+        return -1;
+    }
+
+    type->fInit = init;
+    type->fMixdown = mixdown;
+
+    // Slots already resolved in this process use the new functions
+    for (int slot = 0; slot < CUSTOM_PORT_TYPE_NUM; slot++) {
+        if (gCustomPortTypes[slot].fManager && strcmp(gCustomPortTypes[slot].fName, port_type) == 0) {
+            gCustomPortTypes[slot].fInit = init;
+            gCustomPortTypes[slot].fMixdown = mixdown;
+        }
+    }
+    return 0;
+}
+
+size_t GetRegisteredPortTypeSize(const char* port_type)
+{
+    JackCustomPortType* type = FindRegisteredPortType(port_type);
+    return (type) ? type->fSize : 0;
+}
+
+bool IsUsablePortType(const char* port_type)
+{
+    for (jack_port_type_id_t i = 0; i < BUILTIN_PORT_TYPES; ++i) {
+        if (strcmp(port_type, gPortTypes[i]->fName) == 0) {
+            return true;
+        }
+    }
+    return (FindRegisteredPortType(port_type) != NULL);
+}
+
+bool IsBuiltinPortType(jack_port_type_id_t port_type_id)
+{
+    return (port_type_id < BUILTIN_PORT_TYPES);
+}
+
 } // namespace Jack
@@ -27,6 +27,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 namespace Jack
 {
 
+// Built-in types, then types registered by clients : also the id of unknown types
 extern const jack_port_type_id_t PORT_TYPES_MAX;
 
 struct JackPortType
@@ -35,13 +36,30 @@ struct JackPortType
     size_t (*size)();
     void (*init)(void* buffer, size_t buffer_size, jack_nframes_t nframes);
     void (*mixdown)(void *mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes);
+    // Optional: mixdown where each source is multiplied by a gain going linearly from start_gains[i] to end_gains[i]
+    void (*mixdown_gain)(void* mixbuffer, void** src_buffers, const jack_default_audio_sample_t* start_gains, const jack_default_audio_sample_t* end_gains, int src_count, jack_nframes_t nframes);
+    // Optional: accumulates the highest absolute sample in 'peak' and the sum of squares in 'power'
+    void (*meter)(void* buffer, jack_nframes_t nframes, jack_default_audio_sample_t* peak, jack_default_audio_sample_t* power);
+    // Optional: read-only buffer of BUFFER_SIZE_MAX frames holding what 'init' writes, shared by all unconnected input ports
+    const void* (*silence)();
 };
 
 extern jack_port_type_id_t GetPortTypeId(const char* port_type);
 extern const struct JackPortType* GetPortType(jack_port_type_id_t port_type_id);
 
+// Functions of a port type used by this process, -1 if the type is already registered with a different size
+extern int RegisterPortType(const char* port_type, size_t buffer_size, JackPortTypeInitCallback init, JackPortTypeMixdownCallback mixdown);
+// Buffer size given to RegisterPortType, 0 if the type has not been registered by this process
+extern size_t GetRegisteredPortTypeSize(const char* port_type);
+// Built-in types, and types registered by this process : the only ones a client of this process can create ports of
+extern bool IsUsablePortType(const char* port_type);
+// Types mixed the same way in all processes, the server included
+extern bool IsBuiltinPortType(jack_port_type_id_t port_type_id);
+
 extern const struct JackPortType gAudioPortType;
 extern const struct JackPortType gMidiPortType;
+extern const struct JackPortType gControlPortType;
+extern const struct JackPortType gLastControlPortType;
 
 } // namespace Jack
 
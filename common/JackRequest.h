@@ -31,6 +31,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include <stdio.h>
 #include <stdlib.h>
 #include <list>
+#include <vector>
 
 namespace Jack
 {
@@ -90,7 +91,9 @@ struct JackRequest
         kGetUUIDByClient = 37,
         kClientHasSessionCallback = 38,
         kComputeTotalLatencies = 39,
-        kPropertyChangeNotify = 40
+        kPropertyChangeNotify = 40,
+        kClientCheckOpen = 41,
+        kRegisterPorts = 42
     };
 
     RequestType fType;
@@ -248,25 +251,35 @@ struct JackClientOpenRequest : public JackRequest
     int fPID;
     jack_uuid_t fUUID;
     char fName[JACK_CLIENT_NAME_SIZE+1];
+    char fNotifyName[JACK_CLIENT_NAME_SIZE+1];  // Notification channel name, the client name when empty
 
     JackClientOpenRequest() : fPID(0), fUUID(JACK_UUID_EMPTY_INITIALIZER)
     {
         memset(fName, 0, sizeof(fName));
+        memset(fNotifyName, 0, sizeof(fNotifyName));
     }
-    JackClientOpenRequest(const char* name, int pid, jack_uuid_t uuid): JackRequest(JackRequest::kClientOpen)
+    JackClientOpenRequest(const char* name, int pid, jack_uuid_t uuid, const char* notify_name = ""): JackRequest(JackRequest::kClientOpen)
     {
         memset(fName, 0, sizeof(fName));
         snprintf(fName, sizeof(fName), "%s", name);
+        memset(fNotifyName, 0, sizeof(fNotifyName));
+        snprintf(fNotifyName, sizeof(fNotifyName), "%s", notify_name);
         fPID = pid;
         fUUID = uuid;
     }
 
+    const char* GetNotifyName()
+    {
+        return (fNotifyName[0] != 0) ? fNotifyName : fName;
+    }
+
     int Read(detail::JackChannelTransactionInterface* trans)
     {
         CheckSize();
         CheckRes(trans->Read(&fPID, sizeof(int)));
         CheckRes(trans->Read(&fUUID, sizeof(jack_uuid_t)));
-        return trans->Read(&fName, sizeof(fName));
+        CheckRes(trans->Read(&fName, sizeof(fName)));
+        return trans->Read(&fNotifyName, sizeof(fNotifyName));
     }
 
     int Write(detail::JackChannelTransactionInterface* trans)
@@ -274,10 +287,11 @@ struct JackClientOpenRequest : public JackRequest
         CheckRes(JackRequest::Write(trans, Size()));
         CheckRes(trans->Write(&fPID, sizeof(int)));
         CheckRes(trans->Write(&fUUID, sizeof(jack_uuid_t)));
-        return trans->Write(&fName, sizeof(fName));
+        CheckRes(trans->Write(&fName, sizeof(fName)));
+        return trans->Write(&fNotifyName, sizeof(fNotifyName));
     }
 
-    int Size() { return sizeof(int) + sizeof(jack_uuid_t) + sizeof(fName); }
+    int Size() { return sizeof(int) + sizeof(jack_uuid_t) + sizeof(fName) + sizeof(fNotifyName); }
 
 };
 
@@ -319,6 +333,96 @@ struct JackClientOpenResult : public JackResult
 
 };
 
+/*!
+\brief CheckClient followed by NewClient in a single request.
+
+The notification channel is opened by the client under a provisional name before the request,
+since the final client name is only known once checked.
+*/
+
+struct JackClientCheckOpenRequest : public JackRequest
+{
+
+    char fName[JACK_CLIENT_NAME_SIZE+1];
+    char fNotifyName[JACK_CLIENT_NAME_SIZE+1];
+    int fProtocol;
+    int fOptions;
+    int fPID;
+    jack_uuid_t fUUID;
+
+    JackClientCheckOpenRequest() : fProtocol(0), fOptions(0), fPID(0), fUUID(JACK_UUID_EMPTY_INITIALIZER)
+    {
+        memset(fName, 0, sizeof(fName));
+        memset(fNotifyName, 0, sizeof(fNotifyName));
+    }
+    JackClientCheckOpenRequest(const char* name, const char* notify_name, int protocol, int options, int pid, jack_uuid_t uuid)
+        : JackRequest(JackRequest::kClientCheckOpen), fProtocol(protocol), fOptions(options), fPID(pid), fUUID(uuid)
+    {
+        memset(fName, 0, sizeof(fName));
+        snprintf(fName, sizeof(fName), "%s", name);
+        memset(fNotifyName, 0, sizeof(fNotifyName));
+        snprintf(fNotifyName, sizeof(fNotifyName), "%s", notify_name);
+    }
+
+    int Read(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckSize();
+        CheckRes(trans->Read(&fName, sizeof(fName)));
+        CheckRes(trans->Read(&fNotifyName, sizeof(fNotifyName)));
+        CheckRes(trans->Read(&fProtocol, sizeof(int)));
+        CheckRes(trans->Read(&fOptions, sizeof(int)));
+        CheckRes(trans->Read(&fPID, sizeof(int)));
+        return trans->Read(&fUUID, sizeof(jack_uuid_t));
+    }
+
+    int Write(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckRes(JackRequest::Write(trans, Size()));
+        CheckRes(trans->Write(&fName, sizeof(fName)));
+        CheckRes(trans->Write(&fNotifyName, sizeof(fNotifyName)));
+        CheckRes(trans->Write(&fProtocol, sizeof(int)));
+        CheckRes(trans->Write(&fOptions, sizeof(int)));
+        CheckRes(trans->Write(&fPID, sizeof(int)));
+        return trans->Write(&fUUID, sizeof(jack_uuid_t));
+    }
+
+    int Size() { return sizeof(fName) + sizeof(fNotifyName) + 3 * sizeof(int) + sizeof(jack_uuid_t); }
+
+};
+
+/*!
+\brief CheckClient followed by NewClient result.
+*/
+
+struct JackClientCheckOpenResult : public JackClientOpenResult
+{
+
+    char fName[JACK_CLIENT_NAME_SIZE+1];
+    int fStatus;
+
+    JackClientCheckOpenResult(): JackClientOpenResult(), fStatus(0)
+    {
+        memset(fName, 0, sizeof(fName));
+    }
+
+    int Read(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckRes(JackClientOpenResult::Read(trans));
+        CheckRes(trans->Read(&fName, sizeof(fName)));
+        CheckRes(trans->Read(&fStatus, sizeof(int)));
+        return 0;
+    }
+
+    int Write(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckRes(JackClientOpenResult::Write(trans));
+        CheckRes(trans->Write(&fName, sizeof(fName)));
+        CheckRes(trans->Write(&fStatus, sizeof(int)));
+        return 0;
+    }
+
+};
+
 /*!
 \brief CloseClient request.
 */
@@ -489,6 +593,142 @@ struct JackPortRegisterResult : public JackResult
 
 };
 
+/*!
+\brief PortRegister request for several ports of the same type and flags, registered all at once or not at all.
+
+Names are sent packed one after the other, each one null terminated.
+*/
+
+struct JackPortRegisterManyRequest : public JackRequest
+{
+
+    int fRefNum;
+    unsigned int fCount;
+    char fPortType[JACK_PORT_TYPE_SIZE + 1];
+    unsigned int fFlags;
+    unsigned int fBufferSize;
+    std::vector<char> fNames;
+
+    JackPortRegisterManyRequest() : fRefNum(0), fCount(0), fFlags(0), fBufferSize(0)
+    {
+        memset(fPortType, 0, sizeof(fPortType));
+    }
+    JackPortRegisterManyRequest(int refnum, const char** names, unsigned int count, const char* port_type, unsigned int flags, unsigned int buffer_size)
+            : JackRequest(JackRequest::kRegisterPorts), fRefNum(refnum), fCount(count), fFlags(flags), fBufferSize(buffer_size)
+    {
+        memset(fPortType, 0, sizeof(fPortType));
+        strncpy(fPortType, port_type, sizeof(fPortType)-1);
+        for (unsigned int i = 0; i < count; i++) {
+            fNames.insert(fNames.end(), names[i], names[i] + strlen(names[i]) + 1);
+        }
+    }
+
+    // Names in the order they were given
+    void GetNames(const char** names)
+    {
+        const char* name = &fNames[0];
+        for (unsigned int i = 0; i < fCount; i++) {
+            names[i] = name;
+            name += strlen(name) + 1;
+        }
+    }
+
+    int Read(detail::JackChannelTransactionInterface* trans)
+    {
+        // Variable size: the names take what is left after the fixed fields
+        CheckRes(trans->Read(&fSize, sizeof(int)));
+        int names_size = fSize - FixedSize();
+        if (names_size < 0 || names_size > PORT_NUM_FOR_CLIENT * (REAL_JACK_PORT_NAME_SIZE + 1)) {
+            jack_error("CheckSize error size = %d", fSize);
+            return -1;
+        }
+        CheckRes(trans->Read(&fRefNum, sizeof(int)));
+        CheckRes(trans->Read(&fCount, sizeof(unsigned int)));
+        CheckRes(trans->Read(&fPortType, sizeof(fPortType)));
+        CheckRes(trans->Read(&fFlags, sizeof(unsigned int)));
+        CheckRes(trans->Read(&fBufferSize, sizeof(unsigned int)));
+        fNames.resize(names_size);
+        if (names_size > 0) {
+            CheckRes(trans->Read(&fNames[0], names_size));
+        }
+        // Check there are as many null terminated names as announced, none of them too long
+        unsigned int count = 0;
+        int len = 0;
+        for (int i = 0; i < names_size; i++) {
+            if (fNames[i] == 0) {
+                count++;
+                len = 0;
+            } else if (++len > REAL_JACK_PORT_NAME_SIZE) {
+                jack_error("JackPortRegisterManyRequest : port name too long");
+                return -1;
+            }
+        }
+        if (count != fCount || len != 0) {
+            jack_error("JackPortRegisterManyRequest : %d names expected, %d received", fCount, count);
+            return -1;
+        }
+        return 0;
+    }
+
+    int Write(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckRes(JackRequest::Write(trans, Size()));
+        CheckRes(trans->Write(&fRefNum, sizeof(int)));
+        CheckRes(trans->Write(&fCount, sizeof(unsigned int)));
+        CheckRes(trans->Write(&fPortType, sizeof(fPortType)));
+        CheckRes(trans->Write(&fFlags, sizeof(unsigned int)));
+        CheckRes(trans->Write(&fBufferSize, sizeof(unsigned int)));
+        if (fNames.size() > 0) {
+            CheckRes(trans->Write(&fNames[0], fNames.size()));
+        }
+        return 0;
+    }
+
+    int FixedSize() { return sizeof(int) + sizeof(fPortType) + 3 * sizeof(unsigned int); }
+    int Size() { return FixedSize() + fNames.size(); }
+
+};
+
+/*!
+\brief PortRegister result for several ports.
+*/
+
+struct JackPortRegisterManyResult : public JackResult
+{
+
+    std::vector<jack_port_id_t> fPortIndexes;
+
+    JackPortRegisterManyResult(): JackResult()
+    {}
+
+    int Read(detail::JackChannelTransactionInterface* trans)
+    {
+        unsigned int count;
+        CheckRes(JackResult::Read(trans));
+        CheckRes(trans->Read(&count, sizeof(unsigned int)));
+        if (count > PORT_NUM_FOR_CLIENT) {
+            return -1;
+        }
+        fPortIndexes.resize(count);
+        if (count > 0) {
+            CheckRes(trans->Read(&fPortIndexes[0], count * sizeof(jack_port_id_t)));
+        }
+        return 0;
+    }
+
+    int Write(detail::JackChannelTransactionInterface* trans)
+    {
+        unsigned int count = fPortIndexes.size();
+        CheckRes(JackResult::Write(trans));
+        CheckRes(trans->Write(&count, sizeof(unsigned int)));
+        if (count > 0) {
+            CheckRes(trans->Write(&fPortIndexes[0], count * sizeof(jack_port_id_t)));
+        }
+        return 0;
+    }
+
+};
+
 /*!
 \brief PortUnregister request.
 */
@@ -806,23 +1046,27 @@ struct JackSetFreeWheelRequest : public JackRequest
 struct JackComputeTotalLatenciesRequest : public JackRequest
 {
 
-    JackComputeTotalLatenciesRequest()
-        : JackRequest(JackRequest::kComputeTotalLatencies)
+    int fRefNum;    // Client whose latencies changed, its latency callback is always called
+
+    JackComputeTotalLatenciesRequest() : fRefNum(ALL_CLIENTS)
+    {}
+    JackComputeTotalLatenciesRequest(int refnum)
+        : JackRequest(JackRequest::kComputeTotalLatencies), fRefNum(refnum)
     {}
 
     int Read(detail::JackChannelTransactionInterface* trans)
     {
         CheckSize();
-        return 0;
+        return trans->Read(&fRefNum, sizeof(int));
     }
 
     int Write(detail::JackChannelTransactionInterface* trans)
     {
         CheckRes(JackRequest::Write(trans, Size()));
-        return 0;
+        return trans->Write(&fRefNum, sizeof(int));
     }
 
-    int Size() { return 0; }
+    int Size() { return sizeof(int); }
 };
 
 /*!
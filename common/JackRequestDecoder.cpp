@@ -75,6 +75,20 @@ int JackRequestDecoder::HandleRequest(detail::JackChannelTransactionInterface* s
             break;
         }
 
+        case JackRequest::kClientCheckOpen: {
+            jack_log("JackRequest::ClientCheckOpen");
+            JackClientCheckOpenRequest req;
+            JackClientCheckOpenResult res;
+            CheckRead(req, socket);
+            res.fResult = fServer->GetEngine()->ClientCheck(req.fName, req.fUUID, res.fName, req.fProtocol, req.fOptions, &res.fStatus);
+            if (res.fResult == 0) {
+                JackClientOpenRequest open_req(res.fName, req.fPID, req.fUUID, req.fNotifyName);
+                fHandler->ClientAdd(socket, &open_req, &res);
+            }
+            CheckWriteName("JackRequest::ClientCheckOpen", socket);
+            break;
+        }
+
         case JackRequest::kClientClose: {
             jack_log("JackRequest::ClientClose");
             JackClientCloseRequest req;
@@ -82,6 +96,7 @@ int JackRequestDecoder::HandleRequest(detail::JackChannelTransactionInterface* s
             CheckRead(req, socket);
             res.fResult = fServer->GetEngine()->ClientExternalClose(req.fRefNum);
             CheckWriteRefNum("JackRequest::ClientClose", socket);
+            socket->Flush();
             fHandler->ClientRemove(socket, req.fRefNum);
             // Will cause the wrapping thread to stop
             return -1;
@@ -117,6 +132,25 @@ int JackRequestDecoder::HandleRequest(detail::JackChannelTransactionInterface* s
             break;
         }
 
+        case JackRequest::kRegisterPorts: {
+            jack_log("JackRequest::RegisterPorts");
+            JackPortRegisterManyRequest req;
+            JackPortRegisterManyResult res;
+            CheckRead(req, socket);
+            std::vector<const char*> names(req.fCount);
+            std::vector<jack_port_id_t> port_indexes(req.fCount);
+            if (req.fCount > 0) {
+                req.GetNames(&names[0]);
+            }
+            res.fResult = fServer->GetEngine()->PortRegisterMany(req.fRefNum, (req.fCount > 0) ? &names[0] : NULL, req.fCount,
+                                                                 req.fPortType, req.fFlags, req.fBufferSize, (req.fCount > 0) ? &port_indexes[0] : NULL);
+            if (res.fResult == 0) {
+                res.fPortIndexes = port_indexes;
+            }
+            CheckWriteRefNum("JackRequest::RegisterPorts", socket);
+            break;
+        }
+
         case JackRequest::kUnRegisterPort: {
             jack_log("JackRequest::UnRegisterPort");
             JackPortUnRegisterRequest req;
@@ -202,7 +236,7 @@ int JackRequestDecoder::HandleRequest(detail::JackChannelTransactionInterface* s
             JackComputeTotalLatenciesRequest req;
             JackResult res;
             CheckRead(req, socket);
-            res.fResult = fServer->GetEngine()->ComputeTotalLatencies();
+            res.fResult = fServer->GetEngine()->ComputeTotalLatencies(req.fRefNum);
             CheckWrite("JackRequest::ComputeTotalLatencies", socket);
             break;
         }
@@ -43,9 +43,11 @@ namespace Jack
 //----------------
 // Server control 
 //----------------
-JackServer::JackServer(bool sync, bool temporary, int timeout, bool rt, int priority, int port_max, bool verbose, jack_timer_type_t clock, char self_connect_mode, const char* server_name)
+JackServer::JackServer(bool sync, bool temporary, int timeout, bool rt, int priority, int port_max, bool verbose, jack_timer_type_t clock, char self_connect_mode, const char* server_name, int driver_cpu, const char* client_cpus, bool sched_deadline, bool parallel_slaves)
 {
-    if (rt) {
+    if (rt && sched_deadline) {
+        jack_info("JACK server starting in realtime mode with SCHED_DEADLINE scheduling");
+    } else if (rt) {
         jack_info("JACK server starting in realtime mode with priority %ld", priority);
     } else {
         jack_info("JACK server starting in non-realtime mode");
@@ -54,7 +56,7 @@ JackServer::JackServer(bool sync, bool temporary, int timeout, bool rt, int prio
     jack_info("self-connect-mode is \"%s\"", jack_get_self_connect_mode_description(self_connect_mode));
 
     fGraphManager = JackGraphManager::Allocate(port_max);
-    fEngineControl = new JackEngineControl(sync, temporary, timeout, rt, priority, verbose, clock, server_name);
+    fEngineControl = new JackEngineControl(sync, temporary, timeout, rt, priority, verbose, clock, server_name, driver_cpu, client_cpus, sched_deadline, parallel_slaves);
     fEngine = new JackLockedEngine(fGraphManager, GetSynchroTable(), fEngineControl, self_connect_mode);
 
     // A distinction is made between the threaded freewheel driver and the
@@ -255,6 +257,20 @@ int JackServer::SetBufferSize(jack_nframes_t buffer_size)
         return -1;
     }
 
+    // Blocks of the multi-rate clients are sliced in buffers (see JackEngine::ClientActivate)
+    int multiplier = fGraphManager->GetMaxBlockMultiplier();
+    if (multiplier > 1 && (buffer_size * multiplier > BUFFER_SIZE_MAX || buffer_size % 8 != 0)) {
+        jack_error("SetBufferSize: buffer size = %ld cannot be used with block multiplier = %d", buffer_size, multiplier);
+        return -1;
+    }
+
+    /*
+    Staged change: clients first prepare for the new size while the graph is still running,
+    so that the interruption only covers the driver reconfiguration and the final notification.
+    */
+    fEngine->NotifyBufferSizePrepare(buffer_size);
+
+    jack_time_t stop_date = GetMicroSeconds();
     if (fAudioDriver->Stop() != 0) {
         jack_error("Cannot stop audio driver");
         return -1;
@@ -262,7 +278,9 @@ int JackServer::SetBufferSize(jack_nframes_t buffer_size)
 
     if (fAudioDriver->SetBufferSize(buffer_size) == 0) {
         fEngine->NotifyBufferSize(buffer_size);
-        return fAudioDriver->Start();
+        int res = fAudioDriver->Start();
+        jack_log("JackServer::SetBufferSize driver stopped during %ld usecs", long(GetMicroSeconds() - stop_date));
+        return res;
     } else { // Failure: try to restore current value
         jack_error("Cannot SetBufferSize for audio driver, restore current value %ld", current_buffer_size);
         fAudioDriver->SetBufferSize(current_buffer_size);
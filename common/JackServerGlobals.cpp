@@ -49,10 +49,14 @@ int JackServerGlobals::Start(const char* server_name,
                              int port_max,
                              int verbose,
                              jack_timer_type_t clock,
-                             char self_connect_mode)
+                             char self_connect_mode,
+                             int driver_cpu,
+                             const char* client_cpus,
+                             bool sched_deadline,
+                             bool parallel_slaves)
 {
     jack_log("Jackdmp: sync = %ld timeout = %ld rt = %ld priority = %ld verbose = %ld ", sync, time_out_ms, rt, priority, verbose);
-    new JackServer(sync, temporary, time_out_ms, rt, priority, port_max, verbose, clock, self_connect_mode, server_name);  // Will setup fInstance and fUserCount globals
+    new JackServer(sync, temporary, time_out_ms, rt, priority, port_max, verbose, clock, self_connect_mode, server_name, driver_cpu, client_cpus, sched_deadline, parallel_slaves);  // Will setup fInstance and fUserCount globals
     int res = fInstance->Open(driver_desc, driver_params);
     return (res < 0) ? res : fInstance->Start();
 }
@@ -118,6 +122,10 @@ bool JackServerGlobals::Init()
     int rc, i;
     int res;
     int replace_registry = 0;
+    int driver_cpu = -1;
+    char* client_cpus = NULL;
+    int sched_deadline = 0;
+    int parallel_slaves = 0;
 
     FILE* fp = 0;
     char filename[255];
@@ -130,7 +138,7 @@ bool JackServerGlobals::Init()
 
         jack_log("JackServerGlobals Init");
 
-        const char *options = "-d:X:I:P:uvshVrRL:STFl:t:mn:p:"
+        const char *options = "-d:X:I:P:uvshVrRL:STFl:t:mn:p:D:A:"
     #ifdef __linux__
             "c:"
     #endif
@@ -160,6 +168,10 @@ bool JackServerGlobals::Init()
                                        { "version", 0, 0, 'V' },
                                        { "silent", 0, 0, 's' },
                                        { "sync", 0, 0, 'S' },
+                                       { "driver-cpu", 1, 0, 'D' },
+                                       { "client-cpus", 1, 0, 'A' },
+                                       { "sched-deadline", 0, &sched_deadline, 1 },
+                                       { "parallel-slaves", 0, &parallel_slaves, 1 },
                                        { 0, 0, 0, 0 }
                                    };
 
@@ -274,6 +286,18 @@ bool JackServerGlobals::Init()
                     client_timeout = atoi(optarg);
                     break;
 
+                case 0:
+                    // Long option setting a flag
+                    break;
+
+                case 'D':
+                    driver_cpu = atoi(optarg);
+                    break;
+
+                case 'A':
+                    client_cpus = optarg;
+                    break;
+
                 default:
                     jack_error("unknown option character %c", optopt);
                     break;
@@ -344,11 +368,12 @@ bool JackServerGlobals::Init()
             client_timeout = 500; /* 0.5 sec; usable when non realtime. */
         }
 
+        int res = Start(server_name, driver_desc, master_driver_params, sync, temporary, client_timeout, realtime, realtime_priority, port_max, verbose_aux, clock_source, JACK_DEFAULT_SELF_CONNECT_MODE, driver_cpu, client_cpus, sched_deadline, parallel_slaves);
+
         for (i = 0; i < argc; i++) {
             free(argv[i]);
         }
 
-        int res = Start(server_name, driver_desc, master_driver_params, sync, temporary, client_timeout, realtime, realtime_priority, port_max, verbose_aux, clock_source, JACK_DEFAULT_SELF_CONNECT_MODE);
         if (res < 0) {
             jack_error("Cannot start server... exit");
             Delete();
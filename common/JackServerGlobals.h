@@ -62,7 +62,11 @@ struct SERVER_EXPORT JackServerGlobals
                      int port_max,
                      int verbose,
                      jack_timer_type_t clock,
-                     char self_connect_mode);
+                     char self_connect_mode,
+                     int driver_cpu,
+                     const char* client_cpus,
+                     bool sched_deadline,
+                     bool parallel_slaves);
     static void Stop();
     static void Delete();
 };
@@ -113,6 +113,7 @@ class JackShmReadWritePtr
 
         jack_shm_info_t fInfo;
         bool fInitDone;
+        int fAllocator;
 
         void Init(int index, const char* server_name = JACK_DEFAULT_SERVER_NAME)
         {
@@ -126,6 +127,7 @@ class JackShmReadWritePtr
                     throw std::bad_alloc();
                 }
                 GetShmAddress()->LockMemory();
+                fAllocator = jack_shm_allocator(index);
                 fInitDone = true;
             }
         }
@@ -136,11 +138,15 @@ class JackShmReadWritePtr
         {
             fInfo.index = -1;
             fInitDone = false;
+            fAllocator = 0;
             fInfo.ptr.attached_at = (char*)NULL;
         }
 
         JackShmReadWritePtr(int index, const char* server_name)
         {
+            fInfo.index = -1;
+            fInitDone = false;
+            fAllocator = 0;
             Init(index, server_name);
         }
 
@@ -150,12 +156,25 @@ class JackShmReadWritePtr
                jack_error("JackShmReadWritePtr::~JackShmReadWritePtr - Init not done for %d, skipping unlock", fInfo.index);
                return;
             }
-            if (fInfo.index >= 0) {
-                jack_log("JackShmReadWritePtr::~JackShmReadWritePtr %d", fInfo.index);
+            Release();
+        }
+
+        // Detach, the next SetShmIndex attaches again
+        void Release()
+        {
+            if (fInitDone && fInfo.index >= 0) {
+                jack_log("JackShmReadWritePtr::Release %d", fInfo.index);
                 GetShmAddress()->UnlockMemory();
                 jack_release_lib_shm(&fInfo);
                 fInfo.index = -1;
-             }
+                fInfo.ptr.attached_at = (char*)NULL;
+            }
+        }
+
+        // True when attached to the segment published at this index by the same process as before
+        bool IsAttached(int index)
+        {
+            return fInfo.index >= 0 && fInfo.index == index && jack_shm_allocator(index) == fAllocator;
         }
 
         T* operator->() const
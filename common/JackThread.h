@@ -105,12 +105,16 @@ class SERVER_EXPORT JackThreadInterface
         int DropRealTime();                     // Used when called from another thread
         int DropSelfRealTime();                 // Used when called from thread itself
 
+        int AcquireSelfAffinity(const int* cpus, int count);    // Used when called from thread itself
+        int AcquireSelfDeadline(UInt64 runtime, UInt64 deadline, UInt64 period);  // Used when called from thread itself, in nanoseconds
+
         jack_native_thread_t GetThreadID();
         bool IsThread();
 
         static int AcquireRealTimeImp(jack_native_thread_t thread, int priority);
         static int AcquireRealTimeImp(jack_native_thread_t thread, int priority, UInt64 period, UInt64 computation, UInt64 constraint);
         static int DropRealTimeImp(jack_native_thread_t thread);
+        static int AcquireAffinityImp(jack_native_thread_t thread, const int* cpus, int count);
         static int StartImp(jack_native_thread_t* thread, int priority, int realtime, void*(*start_routine)(void*), void* arg);
         static int StopImp(jack_native_thread_t thread);
         static int KillImp(jack_native_thread_t thread);
@@ -28,7 +28,7 @@
 namespace Jack
 {
 
-JackThreadedDriver::JackThreadedDriver(JackDriver* driver):fThread(this),fDriver(driver)
+JackThreadedDriver::JackThreadedDriver(JackDriver* driver):fThread(this),fDriver(driver),fPeriodChanged(false)
 {}
 
 JackThreadedDriver::~JackThreadedDriver()
@@ -98,7 +98,12 @@ bool JackThreadedDriver::IsFixedBufferSize()
 
 int JackThreadedDriver::SetBufferSize(jack_nframes_t buffer_size)
 {
-    return fDriver->SetBufferSize(buffer_size);
+    int res = fDriver->SetBufferSize(buffer_size);
+    // SCHED_DEADLINE runtime and period follow the new period : applied by the thread itself (see Execute)
+    if (res == 0) {
+        fPeriodChanged = true;
+    }
+    return res;
 }
 
 int JackThreadedDriver::SetSampleRate(jack_nframes_t sample_rate)
@@ -241,6 +246,10 @@ int JackThreadedDriver::Stop()
 
 bool JackThreadedDriver::Execute()
 {
+    // Buffer size changed while the thread was running : it is not restarted, so Init has not been called again
+    if (fPeriodChanged) {
+        SetRealTime();
+    }
     return (Process() == 0);
 }
 
@@ -256,17 +265,41 @@ bool JackThreadedDriver::Init()
 
 void JackThreadedDriver::SetRealTime()
 {
+    fPeriodChanged = false;
+
     if (fDriver->IsRealTime()) {
         jack_log("JackThreadedDriver::Init real-time");
         // Will do "something" on OSX only...
         GetEngineControl()->fPeriod = GetEngineControl()->fConstraint = GetEngineControl()->fPeriodUsecs * 1000;
         GetEngineControl()->fComputation = JackTools::ComputationMicroSec(GetEngineControl()->fBufferSize) * 1000;
         fThread.SetParams(GetEngineControl()->fPeriod, GetEngineControl()->fComputation, GetEngineControl()->fConstraint);
+        if (GetEngineControl()->fSchedDeadline) {
+            UInt64 period = GetEngineControl()->fPeriodUsecs * 1000;
+            if (fThread.AcquireSelfDeadline((period * JACK_DEADLINE_DRIVER_RATIO) / 100, period, period) == 0) {
+                jack_info("Driver thread uses SCHED_DEADLINE runtime = %lld usec period = %lld usec",
+                          (long long)(GetEngineControl()->fPeriodUsecs * JACK_DEADLINE_DRIVER_RATIO) / 100, (long long)GetEngineControl()->fPeriodUsecs);
+                set_threaded_log_function();
+                if (GetEngineControl()->fDriverCPU >= 0) {
+                    jack_info("Driver thread not pinned : SCHED_DEADLINE threads cannot be restricted to a subset of the CPUs");
+                }
+                return;
+            }
+            jack_error("Driver thread falls back to SCHED_FIFO scheduling");
+        }
         if (fThread.AcquireSelfRealTime(GetEngineControl()->fServerPriority) < 0) {
             jack_error("AcquireSelfRealTime error");
         } else {
             set_threaded_log_function();
         }
+        // Copied : the engine control is a packed structure
+        int driver_cpu = GetEngineControl()->fDriverCPU;
+        if (driver_cpu >= 0) {
+            if (fThread.AcquireSelfAffinity(&driver_cpu, 1) < 0) {
+                jack_error("AcquireSelfAffinity error");
+            } else {
+                jack_info("Driver thread pinned on CPU %d", driver_cpu);
+            }
+        }
     } else {
         jack_log("JackThreadedDriver::Init non-realtime");
     }
@@ -38,6 +38,7 @@ class SERVER_EXPORT JackThreadedDriver : public JackDriverClientInterface, publi
 
         JackThread fThread;
         JackDriver* fDriver;
+        volatile bool fPeriodChanged;   // Set by a buffer size change, the RT parameters depend on the period
 
         void SetRealTime();
 
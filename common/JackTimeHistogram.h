@@ -0,0 +1,166 @@
+/*
+Copyright (C) 2026
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __JackTimeHistogram__
+#define __JackTimeHistogram__
+
+#include "JackCompilerDeps.h"
+#include "JackTypes.h"
+#include "JackConstants.h"
+#include "types.h"
+#include <string.h>
+
+namespace Jack
+{
+
+/*
+Log-linear buckets: values below 16 usecs have their own bucket, then each power of two
+is split in 8 buckets, that is a relative resolution of 12.5%, up to about 16 seconds.
+*/
+#define JACK_HISTOGRAM_SUB_BUCKETS 8
+#define JACK_HISTOGRAM_BUCKETS 176
+
+/*!
+\brief Histogram of durations in usecs, in shared memory.
+
+Only one thread (the server RT thread) adds values. Readers in any process take a copy of the
+buckets, and ask for a reset by incrementing fResetRequest: the writer clears the table when adding
+the next value, so that no lock is ever taken in the RT thread.
+*/
+
+PRE_PACKED_STRUCTURE
+struct JackTimeHistogram
+{
+    UInt32 fBuckets[JACK_HISTOGRAM_BUCKETS];
+    UInt32 fCount;
+    jack_time_t fMax;
+    volatile UInt32 fResetRequest;
+    volatile UInt32 fResetDone;
+
+    void Init()
+    {
+        memset(fBuckets, 0, sizeof(fBuckets));
+        fCount = 0;
+        fMax = 0;
+        fResetRequest = 0;
+        fResetDone = 0;
+    }
+
+    static int GetBucket(jack_time_t usecs)
+    {
+        int shift = 0;
+        while ((usecs >> shift) >= 2 * JACK_HISTOGRAM_SUB_BUCKETS) {
+            shift++;
+        }
+        int bucket = shift * JACK_HISTOGRAM_SUB_BUCKETS + int(usecs >> shift);
+        return (bucket < JACK_HISTOGRAM_BUCKETS) ? bucket : JACK_HISTOGRAM_BUCKETS - 1;
+    }
+
+    // Largest value counted in a bucket
+    static jack_time_t GetUpperBound(int bucket)
+    {
+        if (bucket < 2 * JACK_HISTOGRAM_SUB_BUCKETS) {
+            return bucket;
+        } else {
+            int shift = bucket / JACK_HISTOGRAM_SUB_BUCKETS - 1;
+            jack_time_t mantissa = bucket % JACK_HISTOGRAM_SUB_BUCKETS + JACK_HISTOGRAM_SUB_BUCKETS;
+            return ((mantissa + 1) << shift) - 1;
+        }
+    }
+
+    // RT thread
+    void Add(jack_time_t usecs)
+    {
+        UInt32 request = fResetRequest;
+        if (request != fResetDone) {
+            memset(fBuckets, 0, sizeof(fBuckets));
+            fCount = 0;
+            fMax = 0;
+            fResetDone = request;
+        }
+        fBuckets[GetBucket(usecs)]++;
+        fCount++;
+        if (usecs > fMax) {
+            fMax = usecs;
+        }
+    }
+
+    // Any thread or process
+    void Reset()
+    {
+        fResetRequest = fResetRequest + 1;
+    }
+
+    // Copy of the buckets, returns the number of values
+    UInt32 Read(UInt32* buckets, jack_time_t* max) const
+    {
+        if (fResetRequest != fResetDone) {
+            memset(buckets, 0, sizeof(fBuckets));
+            *max = 0;
+            return 0;
+        }
+        UInt32 count = 0;
+        for (int i = 0; i < JACK_HISTOGRAM_BUCKETS; i++) {
+            buckets[i] = fBuckets[i];
+            count += buckets[i];
+        }
+        *max = fMax;
+        return count;
+    }
+
+    // Upper bound of the bucket containing the given percentile, or -1 if the histogram is empty
+    float GetPercentile(float percentile) const
+    {
+        UInt32 buckets[JACK_HISTOGRAM_BUCKETS];
+        jack_time_t max;
+        UInt32 count = Read(buckets, &max);
+        if (count == 0) {
+            return -1.f;
+        }
+
+        percentile = (percentile < 0.f) ? 0.f : ((percentile > 100.f) ? 100.f : percentile);
+        double rank = (double(percentile) * count) / 100.;
+        UInt32 cumulated = 0;
+        for (int i = 0; i < JACK_HISTOGRAM_BUCKETS; i++) {
+            cumulated += buckets[i];
+            if (cumulated > 0 && cumulated >= rank) {
+                jack_time_t bound = GetUpperBound(i);
+                return float((bound < max) ? bound : max);
+            }
+        }
+        return float(max);
+    }
+
+} POST_PACKED_STRUCTURE;
+
+/*!
+\brief Compute time histogram of a client.
+*/
+
+PRE_PACKED_STRUCTURE
+struct JackClientHistogram
+{
+    char fName[JACK_CLIENT_NAME_SIZE + 1];
+    JackTimeHistogram fHistogram;
+
+} POST_PACKED_STRUCTURE;
+
+} // end of namespace
+
+#endif
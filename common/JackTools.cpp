@@ -236,6 +236,74 @@ namespace Jack {
         new_name[i] = '\0';
     }
 
+    /*
+    Parse a CPU list like "2,4-7" (the format used by taskset and cpusets), returns the number of CPUs or -1 on error.
+    */
+    int JackTools::ParseCPUList(const char* list, int* cpus, int max_count)
+    {
+        int count = 0;
+        const char* ptr = list;
+
+        while (ptr && *ptr) {
+            char* end;
+            long first = strtol(ptr, &end, 10);
+            long last = first;
+            if (end == ptr || first < 0) {
+                jack_error("Invalid CPU list '%s'", list);
+                return -1;
+            }
+            if (*end == '-') {
+                ptr = end + 1;
+                last = strtol(ptr, &end, 10);
+                if (end == ptr || last < first) {
+                    jack_error("Invalid CPU range in '%s'", list);
+                    return -1;
+                }
+            }
+            for (long cpu = first; cpu <= last; cpu++) {
+                if (count == max_count) {
+                    jack_error("Too many CPUs in '%s' (max = %d)", list, max_count);
+                    return -1;
+                }
+                cpus[count++] = int(cpu);
+            }
+            if (*end == ',') {
+                end++;
+            } else if (*end != '\0') {
+                jack_error("Invalid CPU list '%s'", list);
+                return -1;
+            }
+            ptr = end;
+        }
+
+        return count;
+    }
+
+    /*
+    Returns an identifier of the last level cache shared by the CPU (the lowest CPU number sharing it), or -1 when unknown.
+    */
+    int JackTools::GetCPUCacheDomain(int cpu)
+    {
+#ifdef __linux__
+        char path[256];
+        char buffer[256];
+        int domain = -1;
+        for (int index = 3; index >= 2 && domain < 0; index--) {
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+            FILE* file = fopen(path, "r");
+            if (file) {
+                if (fgets(buffer, sizeof(buffer), file)) {
+                    domain = atoi(buffer);
+                }
+                fclose(file);
+            }
+        }
+        return domain;
+#else
+        return -1;
+#endif
+    }
+
 #ifdef WIN32
 
 void BuildClientPath(char* path_to_so, int path_len, const char* so_name)
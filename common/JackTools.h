@@ -68,6 +68,10 @@ namespace Jack
         static void RewriteName(const char* name, char* new_name);
         static void ThrowJackNetException();
 
+        // CPU placement
+        static int ParseCPUList(const char* list, int* cpus, int max_count);
+        static int GetCPUCacheDomain(int cpu);
+
         // For OSX only
         static int ComputationMicroSec(int buffer_size)
         {
@@ -161,6 +161,9 @@ DECL_FUNCTION(int, jack_set_buffer_size, (jack_client_t *client, jack_nframes_t
 DECL_FUNCTION(int, jack_set_buffer_size_callback, (jack_client_t *client,
                                             JackBufferSizeCallback bufsize_callback,
                                             void *arg), (client, bufsize_callback, arg));
+DECL_FUNCTION(int, jack_set_buffer_size_prepare_callback, (jack_client_t *client,
+                                            JackBufferSizeCallback prepare_callback,
+                                            void *arg), (client, prepare_callback, arg));
 DECL_FUNCTION(int, jack_set_sample_rate_callback, (jack_client_t *client,
                                             JackSampleRateCallback srate_callback,
                                             void *arg), (client, srate_callback, arg));
@@ -187,9 +190,14 @@ DECL_FUNCTION(int, jack_set_latency_callback, (jack_client_t *client,
                                             void *arg), (client, latency_callback, arg));
 DECL_FUNCTION(int, jack_activate, (jack_client_t *client), (client));
 DECL_FUNCTION(int, jack_deactivate, (jack_client_t *client), (client));
+DECL_FUNCTION(int, jack_set_pipelined, (jack_client_t *client, int onoff), (client, onoff));
+DECL_FUNCTION(int, jack_set_block_multiplier, (jack_client_t *client, int multiplier), (client, multiplier));
 DECL_FUNCTION_NULL(jack_port_t *, jack_port_register, (jack_client_t *client, const char *port_name, const char *port_type,
                                                   unsigned long flags, unsigned long buffer_size),
               (client, port_name, port_type, flags, buffer_size));
+DECL_FUNCTION(int, jack_port_register_many, (jack_client_t *client, const char **port_names, const char *port_type,
+                                             unsigned long flags, unsigned long buffer_size, jack_port_t **ports, unsigned int count),
+              (client, port_names, port_type, flags, buffer_size, ports, count));
 DECL_FUNCTION(int, jack_port_unregister, (jack_client_t *client, jack_port_t* port), (client, port));
 DECL_FUNCTION_NULL(void *, jack_port_get_buffer, (jack_port_t *port, jack_nframes_t nframes), (port, nframes));
 DECL_FUNCTION_NULL(const char*, jack_port_name, (const jack_port_t *port), (port));
@@ -221,12 +229,19 @@ DECL_FUNCTION(int, jack_port_request_monitor, (jack_port_t *port, int onoff), (p
 DECL_FUNCTION(int, jack_port_request_monitor_by_name, (jack_client_t *client, const char *port_name, int onoff), (client, port_name, onoff));
 DECL_FUNCTION(int, jack_port_ensure_monitor, (jack_port_t *port, int onoff), (port, onoff));
 DECL_FUNCTION(int, jack_port_monitoring_input, (jack_port_t *port) ,(port));
+DECL_FUNCTION(int, jack_port_set_metering, (jack_port_t *port, int onoff), (port, onoff));
+DECL_FUNCTION(int, jack_port_get_meter, (jack_port_t *port, jack_default_audio_sample_t *peak, jack_default_audio_sample_t *rms), (port, peak, rms));
+DECL_FUNCTION(int, jack_connection_set_gain, (jack_port_t *source, jack_port_t *destination, float gain), (source, destination, gain));
+DECL_FUNCTION(int, jack_connection_set_mute, (jack_port_t *source, jack_port_t *destination, int onoff), (source, destination, onoff));
+DECL_FUNCTION(int, jack_connection_get_gain, (jack_port_t *source, jack_port_t *destination, float *gain, int *mute), (source, destination, gain, mute));
 DECL_FUNCTION(int, jack_connect, (jack_client_t * client, const char *source_port, const char *destination_port), (client, source_port, destination_port));
 DECL_FUNCTION(int, jack_disconnect, (jack_client_t * client, const char *source_port, const char *destination_port), (client, source_port, destination_port));
 DECL_FUNCTION(int, jack_port_disconnect, (jack_client_t * client, jack_port_t * port), (client, port));
 DECL_FUNCTION(int, jack_port_name_size,(),());
 DECL_FUNCTION(int, jack_port_type_size,(),());
 DECL_FUNCTION(size_t, jack_port_type_get_buffer_size, (jack_client_t *client, const char* port_type), (client, port_type));
+DECL_FUNCTION(int, jack_port_type_register, (jack_client_t *client, const char* port_type, size_t buffer_size,
+              JackPortTypeInitCallback init, JackPortTypeMixdownCallback mixdown), (client, port_type, buffer_size, init, mixdown));
 
 DECL_FUNCTION(jack_nframes_t, jack_get_sample_rate, (jack_client_t *client), (client));
 DECL_FUNCTION(jack_nframes_t, jack_get_buffer_size, (jack_client_t *client), (client));
@@ -250,6 +265,9 @@ DECL_VOID_FUNCTION(jack_set_info_function, (print_function fun), (fun));
 DECL_FUNCTION(float, jack_get_max_delayed_usecs, (jack_client_t *client), (client));
 DECL_FUNCTION(float, jack_get_xrun_delayed_usecs, (jack_client_t *client), (client));
 DECL_VOID_FUNCTION(jack_reset_max_delayed_usecs, (jack_client_t *client), (client));
+DECL_FUNCTION(int, jack_get_cycle_histogram, (jack_client_t *client, jack_cycle_histogram_t type, const char *client_name, jack_time_t *upper_bounds, uint32_t *counts, int size), (client, type, client_name, upper_bounds, counts, size));
+DECL_FUNCTION(float, jack_get_cycle_percentile, (jack_client_t *client, jack_cycle_histogram_t type, const char *client_name, float percentile), (client, type, client_name, percentile));
+DECL_VOID_FUNCTION(jack_reset_cycle_histograms, (jack_client_t *client), (client));
 
 DECL_FUNCTION(int, jack_release_timebase, (jack_client_t *client), (client));
 DECL_FUNCTION(int, jack_set_sync_callback, (jack_client_t *client, JackSyncCallback sync_callback, void *arg), (client, sync_callback, arg));
@@ -212,6 +212,10 @@ static void usage(FILE* file, jackctl_server_t *server, bool full = true)
 #ifdef __linux__
             "               [ --clocksource OR -c [ h(pet) | s(ystem) ]\n"
 #endif
+            "               [ --driver-cpu OR -D cpu ]\n"
+            "               [ --client-cpus OR -A cpu-list ]\n"
+            "               [ --sched-deadline ]\n"
+            "               [ --parallel-slaves ]\n"
             "               [ --autoconnect OR -a <modechar>]\n");
 
     server_parameters = jackctl_server_get_parameters(server);
@@ -263,6 +267,8 @@ int main(int argc, char** argv)
     jackctl_driver_t * master_driver_ctl;
     jackctl_driver_t * loopback_driver_ctl = NULL;
     int replace_registry = 0;
+    int sched_deadline = 0;
+    int parallel_slaves = 0;
 
     for(int a = 1; a < argc; ++a) {
         if( !strcmp(argv[a], "--version") || !strcmp(argv[a], "-V") ) {
@@ -271,7 +277,7 @@ int main(int argc, char** argv)
         }
     }
     const char *options = "-d:X:I:P:uvshrRL:STFl:t:mn:p:C:"
-        "a:"
+        "a:D:A:"
 #ifdef __linux__
         "c:"
 #endif
@@ -302,6 +308,10 @@ int main(int argc, char** argv)
                                        { "silent", 0, 0, 's' },
                                        { "sync", 0, 0, 'S' },
                                        { "autoconnect", 1, 0, 'a' },
+                                       { "driver-cpu", 1, 0, 'D' },
+                                       { "client-cpus", 1, 0, 'A' },
+                                       { "sched-deadline", 0, &sched_deadline, 1 },
+                                       { "parallel-slaves", 0, &parallel_slaves, 1 },
                                        { 0, 0, 0, 0 }
                                    };
 
@@ -391,6 +401,22 @@ int main(int argc, char** argv)
                 }
                 break;
 
+            case 'D':
+                param = jackctl_get_parameter(server_parameters, "driver-cpu");
+                if (param != NULL) {
+                    value.i = atoi(optarg);
+                    jackctl_parameter_set_value(param, &value);
+                }
+                break;
+
+            case 'A':
+                param = jackctl_get_parameter(server_parameters, "client-cpus");
+                if (param != NULL) {
+                    strncpy(value.str, optarg, JACK_PARAM_STRING_MAX);
+                    jackctl_parameter_set_value(param, &value);
+                }
+                break;
+
             case 'd':
                 master_driver_name = optarg;
                 break;
@@ -499,6 +525,10 @@ int main(int argc, char** argv)
                 return_value = 0;
                 goto destroy_server;
 
+            case 0:
+                // Long option setting a flag
+                break;
+
             default:
                 fprintf(stderr, "unknown option character %c\n", optopt);
                 usage(stdout, server_ctl);
@@ -513,6 +543,18 @@ int main(int argc, char** argv)
         jackctl_parameter_set_value(param, &value);
     }
 
+    param = jackctl_get_parameter(server_parameters, "sched-deadline");
+    if (param != NULL && sched_deadline) {
+        value.b = true;
+        jackctl_parameter_set_value(param, &value);
+    }
+
+    param = jackctl_get_parameter(server_parameters, "parallel-slaves");
+    if (param != NULL && parallel_slaves) {
+        value.b = true;
+        jackctl_parameter_set_value(param, &value);
+    }
+
     if (!master_driver_name) {
         usage(stderr, server_ctl, false);
         goto destroy_server;
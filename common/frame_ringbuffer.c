@@ -0,0 +1,344 @@
+/*
+  Copyright (C) 2026
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation; either version 2.1 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+  Single reader / single writer ringbuffer of multichannel audio frames.
+
+  Indices are free running frame counters, only masked when accessing the
+  buffer, so the whole capacity is usable. The writer owns write_index and
+  its cached copy of read_index, the reader owns read_index and its cached
+  copy of write_index, and each pair lives in its own cache line: the
+  remote index is only loaded (with acquire semantic) when the cached
+  value says the buffer looks full or empty.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#ifdef USE_MLOCK
+#include <sys/mman.h>
+#endif /* USE_MLOCK */
+#include "JackCompilerDeps.h"
+
+#define FRAME_RINGBUFFER_CACHE_LINE 64
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FRAME_RINGBUFFER_LOAD_ACQUIRE(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define FRAME_RINGBUFFER_STORE_RELEASE(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#else
+/* Enough on strongly ordered CPUs only */
+#define FRAME_RINGBUFFER_LOAD_ACQUIRE(ptr) (*(volatile size_t*)(ptr))
+#define FRAME_RINGBUFFER_STORE_RELEASE(ptr, val) (*(volatile size_t*)(ptr) = (val))
+#endif
+
+typedef struct jack_frame_ringbuffer {
+	/* Writer side */
+	size_t write_index;
+	size_t cached_read_index;
+	char pad1[FRAME_RINGBUFFER_CACHE_LINE - 2 * sizeof(size_t)];
+	/* Reader side */
+	size_t read_index;
+	size_t cached_write_index;
+	char pad2[FRAME_RINGBUFFER_CACHE_LINE - 2 * sizeof(size_t)];
+	/* Constant after creation */
+	float *buf;
+	size_t frames;
+	size_t frames_mask;
+	unsigned int channels;
+	int mlocked;
+	void *mem;
+}
+jack_frame_ringbuffer_t;
+
+LIB_EXPORT jack_frame_ringbuffer_t *jack_frame_ringbuffer_create(unsigned int channels, size_t frames);
+LIB_EXPORT void jack_frame_ringbuffer_free(jack_frame_ringbuffer_t *rb);
+LIB_EXPORT int jack_frame_ringbuffer_mlock(jack_frame_ringbuffer_t *rb);
+LIB_EXPORT void jack_frame_ringbuffer_reset(jack_frame_ringbuffer_t *rb);
+LIB_EXPORT unsigned int jack_frame_ringbuffer_channels(const jack_frame_ringbuffer_t *rb);
+LIB_EXPORT size_t jack_frame_ringbuffer_read_space(jack_frame_ringbuffer_t *rb);
+LIB_EXPORT size_t jack_frame_ringbuffer_write_space(jack_frame_ringbuffer_t *rb);
+LIB_EXPORT size_t jack_frame_ringbuffer_write(jack_frame_ringbuffer_t *rb, const float *const *channels, size_t frames);
+LIB_EXPORT size_t jack_frame_ringbuffer_write_interleaved(jack_frame_ringbuffer_t *rb, const float *src, size_t frames);
+LIB_EXPORT size_t jack_frame_ringbuffer_read(jack_frame_ringbuffer_t *rb, float *const *channels, size_t frames);
+LIB_EXPORT size_t jack_frame_ringbuffer_read_interleaved(jack_frame_ringbuffer_t *rb, float *dest, size_t frames);
+
+/* Create a new frame ringbuffer to hold at least `frames' frames of
+   `channels' samples. The actual capacity is rounded up to the next
+   power of two. The structure is cache line aligned. */
+
+LIB_EXPORT jack_frame_ringbuffer_t *
+jack_frame_ringbuffer_create (unsigned int channels, size_t frames)
+{
+	jack_frame_ringbuffer_t *rb;
+	void *mem;
+	size_t size = 1;
+
+	if (channels == 0 || frames == 0) {
+		return NULL;
+	}
+
+	while (size < frames) {
+		size <<= 1;
+	}
+
+	if ((mem = malloc (sizeof (jack_frame_ringbuffer_t) + FRAME_RINGBUFFER_CACHE_LINE)) == NULL) {
+		return NULL;
+	}
+
+	rb = (jack_frame_ringbuffer_t *) (((uintptr_t) mem + FRAME_RINGBUFFER_CACHE_LINE - 1) & ~(uintptr_t) (FRAME_RINGBUFFER_CACHE_LINE - 1));
+	memset (rb, 0, sizeof (jack_frame_ringbuffer_t));
+	rb->mem = mem;
+	rb->frames = size;
+	rb->frames_mask = size - 1;
+	rb->channels = channels;
+
+	if ((rb->buf = (float *) calloc (size * channels, sizeof (float))) == NULL) {
+		free (mem);
+		return NULL;
+	}
+
+	return rb;
+}
+
+/* Free all data associated with the frame ringbuffer `rb'. */
+
+LIB_EXPORT void
+jack_frame_ringbuffer_free (jack_frame_ringbuffer_t * rb)
+{
+#ifdef USE_MLOCK
+	if (rb->mlocked) {
+		munlock (rb->buf, rb->frames * rb->channels * sizeof (float));
+	}
+#endif /* USE_MLOCK */
+	free (rb->buf);
+	free (rb->mem);
+}
+
+/* Lock the data block of `rb' using the system call 'mlock'.  */
+
+LIB_EXPORT int
+jack_frame_ringbuffer_mlock (jack_frame_ringbuffer_t * rb)
+{
+#ifdef USE_MLOCK
+	if (mlock (rb->buf, rb->frames * rb->channels * sizeof (float))) {
+		return -1;
+	}
+#endif /* USE_MLOCK */
+	rb->mlocked = 1;
+	return 0;
+}
+
+/* Reset the read and write indices to zero. This is not thread safe. */
+
+LIB_EXPORT void
+jack_frame_ringbuffer_reset (jack_frame_ringbuffer_t * rb)
+{
+	rb->write_index = 0;
+	rb->cached_read_index = 0;
+	rb->read_index = 0;
+	rb->cached_write_index = 0;
+}
+
+LIB_EXPORT unsigned int
+jack_frame_ringbuffer_channels (const jack_frame_ringbuffer_t * rb)
+{
+	return rb->channels;
+}
+
+/* Reader side: number of frames available for reading. The write index
+   is only loaded when the cached one does not show enough frames. */
+
+static size_t
+frame_ringbuffer_read_space (jack_frame_ringbuffer_t * rb, size_t wanted)
+{
+	size_t available = rb->cached_write_index - rb->read_index;
+
+	if (available < wanted) {
+		rb->cached_write_index = FRAME_RINGBUFFER_LOAD_ACQUIRE (&rb->write_index);
+		available = rb->cached_write_index - rb->read_index;
+	}
+	return available;
+}
+
+/* Writer side: number of frames available for writing. The read index
+   is only loaded when the cached one does not show enough space. */
+
+static size_t
+frame_ringbuffer_write_space (jack_frame_ringbuffer_t * rb, size_t wanted)
+{
+	size_t available = rb->frames - (rb->write_index - rb->cached_read_index);
+
+	if (available < wanted) {
+		rb->cached_read_index = FRAME_RINGBUFFER_LOAD_ACQUIRE (&rb->read_index);
+		available = rb->frames - (rb->write_index - rb->cached_read_index);
+	}
+	return available;
+}
+
+LIB_EXPORT size_t
+jack_frame_ringbuffer_read_space (jack_frame_ringbuffer_t * rb)
+{
+	return frame_ringbuffer_read_space (rb, rb->frames);
+}
+
+LIB_EXPORT size_t
+jack_frame_ringbuffer_write_space (jack_frame_ringbuffer_t * rb)
+{
+	return frame_ringbuffer_write_space (rb, rb->frames);
+}
+
+/* Interleave `frames' frames of `channels' buffers starting at `offset'
+   into `dest'. */
+
+static void
+frame_ringbuffer_interleave (float *dest, const float *const *channels, unsigned int count, size_t offset, size_t frames)
+{
+	size_t i;
+	unsigned int c;
+
+	if (count == 1) {
+		memcpy (dest, channels[0] + offset, frames * sizeof (float));
+		return;
+	}
+
+	for (i = 0; i < frames; i++) {
+		for (c = 0; c < count; c++) {
+			dest[c] = channels[c][offset + i];
+		}
+		dest += count;
+	}
+}
+
+static void
+frame_ringbuffer_deinterleave (float *const *channels, const float *src, unsigned int count, size_t offset, size_t frames)
+{
+	size_t i;
+	unsigned int c;
+
+	if (count == 1) {
+		memcpy (channels[0] + offset, src, frames * sizeof (float));
+		return;
+	}
+
+	for (i = 0; i < frames; i++) {
+		for (c = 0; c < count; c++) {
+			channels[c][offset + i] = src[c];
+		}
+		src += count;
+	}
+}
+
+/* The writers: copy at most `frames' frames to `rb', in at most two
+   segments, then publish them with a single release store. */
+
+LIB_EXPORT size_t
+jack_frame_ringbuffer_write (jack_frame_ringbuffer_t * rb, const float *const *channels, size_t frames)
+{
+	size_t available = frame_ringbuffer_write_space (rb, frames);
+	size_t to_write = frames > available ? available : frames;
+	size_t start = rb->write_index & rb->frames_mask;
+	size_t n1 = rb->frames - start;
+
+	if (to_write == 0) {
+		return 0;
+	}
+	if (n1 > to_write) {
+		n1 = to_write;
+	}
+
+	frame_ringbuffer_interleave (rb->buf + start * rb->channels, channels, rb->channels, 0, n1);
+	if (to_write > n1) {
+		frame_ringbuffer_interleave (rb->buf, channels, rb->channels, n1, to_write - n1);
+	}
+
+	FRAME_RINGBUFFER_STORE_RELEASE (&rb->write_index, rb->write_index + to_write);
+	return to_write;
+}
+
+LIB_EXPORT size_t
+jack_frame_ringbuffer_write_interleaved (jack_frame_ringbuffer_t * rb, const float *src, size_t frames)
+{
+	size_t available = frame_ringbuffer_write_space (rb, frames);
+	size_t to_write = frames > available ? available : frames;
+	size_t start = rb->write_index & rb->frames_mask;
+	size_t n1 = rb->frames - start;
+
+	if (to_write == 0) {
+		return 0;
+	}
+	if (n1 > to_write) {
+		n1 = to_write;
+	}
+
+	memcpy (rb->buf + start * rb->channels, src, n1 * rb->channels * sizeof (float));
+	if (to_write > n1) {
+		memcpy (rb->buf, src + n1 * rb->channels, (to_write - n1) * rb->channels * sizeof (float));
+	}
+
+	FRAME_RINGBUFFER_STORE_RELEASE (&rb->write_index, rb->write_index + to_write);
+	return to_write;
+}
+
+/* The readers: copy at most `frames' frames from `rb', then release the
+   space with a single release store. */
+
+LIB_EXPORT size_t
+jack_frame_ringbuffer_read (jack_frame_ringbuffer_t * rb, float *const *channels, size_t frames)
+{
+	size_t available = frame_ringbuffer_read_space (rb, frames);
+	size_t to_read = frames > available ? available : frames;
+	size_t start = rb->read_index & rb->frames_mask;
+	size_t n1 = rb->frames - start;
+
+	if (to_read == 0) {
+		return 0;
+	}
+	if (n1 > to_read) {
+		n1 = to_read;
+	}
+
+	frame_ringbuffer_deinterleave (channels, rb->buf + start * rb->channels, rb->channels, 0, n1);
+	if (to_read > n1) {
+		frame_ringbuffer_deinterleave (channels, rb->buf, rb->channels, n1, to_read - n1);
+	}
+
+	FRAME_RINGBUFFER_STORE_RELEASE (&rb->read_index, rb->read_index + to_read);
+	return to_read;
+}
+
+LIB_EXPORT size_t
+jack_frame_ringbuffer_read_interleaved (jack_frame_ringbuffer_t * rb, float *dest, size_t frames)
+{
+	size_t available = frame_ringbuffer_read_space (rb, frames);
+	size_t to_read = frames > available ? available : frames;
+	size_t start = rb->read_index & rb->frames_mask;
+	size_t n1 = rb->frames - start;
+
+	if (to_read == 0) {
+		return 0;
+	}
+	if (n1 > to_read) {
+		n1 = to_read;
+	}
+
+	memcpy (dest, rb->buf + start * rb->channels, n1 * rb->channels * sizeof (float));
+	if (to_read > n1) {
+		memcpy (dest + n1 * rb->channels, rb->buf, (to_read - n1) * rb->channels * sizeof (float));
+	}
+
+	FRAME_RINGBUFFER_STORE_RELEASE (&rb->read_index, rb->read_index + to_read);
+	return to_read;
+}
@@ -30,6 +30,7 @@
 #define JACKCTL_H__2EEDAD78_DF4C_4B26_83B7_4FF1A446A47E__INCLUDED
 
 #include <jack/types.h>
+#include <jack/statistics.h>
 #include <jack/jslist.h>
 #include <jack/systemdeps.h>
 #if !defined(sun) && !defined(__sun__)
@@ -323,6 +324,45 @@ bool
 jackctl_server_switch_master(jackctl_server_t * server,
                             jackctl_driver_t * driver);
 
+/**
+ * Call this function to get the CPU the server assigned to the
+ * realtime thread of a client (see the "client-cpus" parameter).
+ *
+ * @param server server object handle
+ * @param client_name name of the client
+ *
+ * @return CPU number, or -1 if the client is unknown or not pinned
+ * (client threads are never pinned with the "sched-deadline" parameter).
+ */
+int
+jackctl_server_get_client_cpu(jackctl_server_t * server,
+                            const char * client_name);
+
+/**
+ * Call this function to get a percentile of a server timing
+ * distribution (see jack_get_cycle_percentile()).
+ *
+ * @param server server object handle
+ * @param type the distribution to read
+ * @param client_name the measured client for JackClientCompute, ignored otherwise
+ * @param percentile the percentile, between 0 and 100
+ *
+ * @return value in usecs, or -1 if the server is not open or the distribution is unknown or empty.
+ */
+float
+jackctl_server_get_cycle_percentile(jackctl_server_t * server,
+                            jack_cycle_histogram_t type,
+                            const char * client_name,
+                            float percentile);
+
+/**
+ * Call this function to reset all server timing distributions.
+ *
+ * @param server server object handle
+ */
+void
+jackctl_server_reset_cycle_histograms(jackctl_server_t * server);
+
 
 /**
  * Call this function to get name of driver.
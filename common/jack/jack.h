@@ -219,6 +219,62 @@ int jack_activate (jack_client_t *client) JACK_OPTIONAL_WEAK_EXPORT;
  */
 int jack_deactivate (jack_client_t *client) JACK_OPTIONAL_WEAK_EXPORT;
 
+/**
+ * Run @a client one cycle behind the other clients. Its process
+ * callback no longer waits for the clients feeding it, nor delays the
+ * clients it feeds : it runs concurrently with the whole graph, which
+ * suits heavy but latency tolerant clients (analysis, recording,
+ * streaming).
+ *
+ * The client gets what the other clients produced in the previous
+ * cycle, and they get what it produced in the previous cycle, so each
+ * of these connections adds one period to the port latencies, which
+ * are reported accordingly. Connections with the hardware ports are
+ * not delayed. The client must still finish within the cycle.
+ *
+ * Its inputs are mixed by the server, so only ports of the built-in
+ * types can be used : ports of a type registered with
+ * jack_port_type_register() are refused.
+ *
+ * @pre The client must not be active. The mode takes effect at the
+ * next jack_activate().
+ *
+ * @return 0 on success, otherwise a non-zero error code
+ */
+int jack_set_pipelined (jack_client_t *client, int onoff) JACK_OPTIONAL_WEAK_EXPORT;
+
+/**
+ * Run @a client every @a multiplier cycles, on blocks of @a multiplier
+ * times the buffer size, so that heavy processing (analysis, FFT based
+ * convolution) gets large blocks without forcing a large period on the
+ * whole server. The process callback (or jack_cycle_wait()) is then
+ * called with the block size as @a nframes, and the port buffers hold
+ * that many frames.
+ *
+ * The client runs out of the graph, like a pipelined client (see
+ * jack_set_pipelined()) for all its connections, drivers included : its
+ * inputs are accumulated over the cycles of a block, and the complete
+ * block is given to the client, which then has @a multiplier periods to
+ * process it while the next block is accumulated. Its outputs are played
+ * over the cycles following that processing time. Inputs add
+ * @a multiplier - 1 periods to the port latencies (one more for inputs
+ * from other clients) and outputs @a multiplier periods, which are
+ * reported accordingly. A block that is not processed in time is lost,
+ * and the outputs are silent for the following block. Clients using the
+ * same multiplier are spread over the cycles.
+ *
+ * Only audio ports can be used, the buffer size must be a multiple of 8
+ * frames, and @a multiplier times the buffer size must not exceed the
+ * maximum buffer size.
+ *
+ * @pre The client must not be active. The multiplier takes effect at
+ * the next jack_activate(). 1, the default, runs the client at each
+ * cycle.
+ *
+ * @return 0 on success, otherwise a non-zero error code
+ */
+int jack_set_block_multiplier (jack_client_t *client, int multiplier) JACK_OPTIONAL_WEAK_EXPORT;
+
 /**
  * @return pid of client. If not available, 0 will be returned.
  */
@@ -439,6 +495,30 @@ int jack_set_buffer_size_callback (jack_client_t *client,
                                    JackBufferSizeCallback bufsize_callback,
                                    void *arg) JACK_OPTIONAL_WEAK_EXPORT;
 
+/**
+ * Tell JACK to call @a prepare_callback before the buffer size changes,
+ * while the @a process_callback is still called with the current size.
+ * The client should allocate whatever the new size requires here, so
+ * that its @a bufsize_callback, which is called afterwards while the
+ * graph is stopped, only has to switch to the prepared resources. This
+ * keeps the audio interruption caused by jack_set_buffer_size() short.
+ *
+ * The @a prepare_callback is received in the non RT notification thread,
+ * concurrently with the @a process_callback.
+ *
+ * NOTE: this function cannot be called while the client is activated
+ * (after jack_activate has been called.)
+ *
+ * @param client pointer to JACK client structure.
+ * @param prepare_callback function to call with the upcoming buffer size.
+ * @param arg argument for @a prepare_callback.
+ *
+ * @return 0 on success, otherwise a non-zero error code
+ */
+int jack_set_buffer_size_prepare_callback (jack_client_t *client,
+                                           JackBufferSizeCallback prepare_callback,
+                                           void *arg) JACK_OPTIONAL_WEAK_EXPORT;
+
 /**
  * Tell the Jack server to call @a srate_callback whenever the system
  * sample rate changes.
@@ -729,7 +809,9 @@ float jack_cpu_load (jack_client_t *client) JACK_OPTIONAL_WEAK_EXPORT;
  *
  * All ports have a type, which may be any non-NULL and non-zero
  * length string, passed as an argument.  Some port types are built
- * into the JACK API, currently only JACK_DEFAULT_AUDIO_TYPE.
+ * into the JACK API, like JACK_DEFAULT_AUDIO_TYPE.  Other types must
+ * first be registered in this process with jack_port_type_register(),
+ * the registration fails otherwise.
  *
  * @param client pointer to JACK client structure.
  * @param port_name non-empty short name for the new port (not
@@ -737,8 +819,8 @@ float jack_cpu_load (jack_client_t *client) JACK_OPTIONAL_WEAK_EXPORT;
  * @param port_type port type name.  If longer than
  * jack_port_type_size(), only that many characters are significant.
  * @param flags @ref JackPortFlags bit mask.
- * @param buffer_size must be non-zero if this is not a built-in @a
- * port_type.  Otherwise, it is ignored.
+ * @param buffer_size ignored for a built-in @a port_type.  For a
+ * registered type, 0 uses the size given to jack_port_type_register().
  *
  * @return jack_port_t pointer on success, otherwise NULL.
  */
@@ -748,6 +830,35 @@ jack_port_t * jack_port_register (jack_client_t *client,
                                   unsigned long flags,
                                   unsigned long buffer_size) JACK_OPTIONAL_WEAK_EXPORT;
 
+/**
+ * Create several ports of the same type and flags at once, as
+ * jack_port_register() would do for each of them, but with a single
+ * request to the server. Either all ports are registered or none of
+ * them. Other clients receive the port registration callbacks of all
+ * new ports together.
+ *
+ * @param client pointer to JACK client structure.
+ * @param port_names array of @a count non-empty short names, all
+ * different and unique among the ports owned by this client.
+ * @param port_type port type name.
+ * @param flags @ref JackPortFlags bit mask.
+ * @param buffer_size ignored for a built-in @a port_type.  For a
+ * registered type, 0 uses the size given to jack_port_type_register().
+ * @param ports array of @a count jack_port_t pointers, filled with the
+ * new ports in the order of @a port_names.
+ * @param count number of ports to create.
+ *
+ * @return 0 on success, otherwise a non-zero error code and no port
+ * is created.
+ */
+int jack_port_register_many (jack_client_t *client,
+                             const char **port_names,
+                             const char *port_type,
+                             unsigned long flags,
+                             unsigned long buffer_size,
+                             jack_port_t **ports,
+                             unsigned int count) JACK_OPTIONAL_WEAK_EXPORT;
+
 /**
  * Remove the port from the client, disconnecting any existing
  * connections.
@@ -977,6 +1088,80 @@ int jack_port_ensure_monitor (jack_port_t *port, int onoff) JACK_OPTIONAL_WEAK_E
  */
 int jack_port_monitoring_input (jack_port_t *port) JACK_OPTIONAL_WEAK_EXPORT;
 
+/**
+ * Turn metering on or off for @a port. When metering is on, the peak
+ * and RMS level of the port are computed in each cycle by the JACK
+ * library and published in the server shared memory, so that any
+ * client can read them with jack_port_get_meter() without having to
+ * process the port itself. An input port is metered as a by-product of
+ * the mix of its connections, when its buffer is got in the cycle. An
+ * output port is metered by its client once its process callback has
+ * returned. The port does not need to belong to the calling client.
+ *
+ * Metering is done in the process of the client owning the port, not
+ * in the server : the meter of an input port is not updated in the
+ * cycles where its client does not call jack_port_get_buffer() on it,
+ * and keeps the levels of the last cycle where it did.
+ *
+ * @return 0 on success, otherwise a non-zero error code (for instance
+ * if the port type cannot be metered).
+ */
+int jack_port_set_metering (jack_port_t *port, int onoff) JACK_OPTIONAL_WEAK_EXPORT;
+
+/**
+ * Read the levels computed for @a port. Reading does not change
+ * them, so any number of clients can read the same port.
+ *
+ * @param peak highest absolute sample value of the last 1/10 to 2/10
+ * second: a peak stays visible for at least 1/10 second.
+ * @param rms RMS level of the last metered cycle.
+ *
+ * @return 0 on success, otherwise a non-zero error code (for instance
+ * if metering is not enabled on the port).
+ */
+int jack_port_get_meter (jack_port_t *port,
+                         jack_default_audio_sample_t *peak,
+                         jack_default_audio_sample_t *rms) JACK_OPTIONAL_WEAK_EXPORT;
+
+/**
+ * Set the gain applied to the signal of the @a source port when it is
+ * mixed into the @a destination input port. The change is applied
+ * with a ramp over the next cycle, and does not reorder the graph.
+ * This function is lock-free and can be used from any thread.
+ *
+ * @pre The ports must be connected. The setting is dropped when they
+ * are disconnected.
+ *
+ * @return 0 on success, otherwise a non-zero error code (for instance
+ * if the port type does not support gain, or if too many connections
+ * of the @a destination port already have a setting).
+ */
+int jack_connection_set_gain (jack_port_t *source,
+                              jack_port_t *destination,
+                              float gain) JACK_OPTIONAL_WEAK_EXPORT;
+
+/**
+ * Mute or unmute the connection from @a source to @a destination,
+ * keeping its gain. Same rules as jack_connection_set_gain().
+ *
+ * @return 0 on success, otherwise a non-zero error code
+ */
+int jack_connection_set_mute (jack_port_t *source,
+                              jack_port_t *destination,
+                              int onoff) JACK_OPTIONAL_WEAK_EXPORT;
+
+/**
+ * Get the gain and mute setting of the connection from @a source to
+ * @a destination.
+ *
+ * @return 0 on success, otherwise a non-zero error code (for instance
+ * if the ports are not connected).
+ */
+int jack_connection_get_gain (jack_port_t *source,
+                              jack_port_t *destination,
+                              float *gain,
+                              int *mute) JACK_OPTIONAL_WEAK_EXPORT;
+
 /**
  * Establish a connection between two ports.
  *
@@ -1049,6 +1234,32 @@ int jack_port_type_size(void) JACK_OPTIONAL_WEAK_EXPORT;
  */
 size_t jack_port_type_get_buffer_size (jack_client_t *client, const char *port_type) JACK_WEAK_EXPORT;
 
+/**
+ * Register a port type, so that ports of this type can be created
+ * with jack_port_register().
+ *
+ * The type is known server wide once the first port of this type is
+ * registered, @a buffer_size being then used for all its ports.
+ * @a init and @a mixdown are only called in this process : each
+ * process creating ports of this type must register it, with the
+ * same @a buffer_size.
+ * Pipelined clients (see jack_set_pipelined()) cannot have ports of
+ * these types.
+ *
+ * @param client pointer to JACK client structure.
+ * @param port_type port type name, at most jack_port_type_size() characters.
+ * @param buffer_size size in bytes of the data carried each cycle.
+ * @param init function that clears a buffer, or NULL.
+ * @param mixdown function that mixes several buffers in one, or NULL.
+ *
+ * @return 0 on success, otherwise a non-zero error code
+ */
+int jack_port_type_register (jack_client_t *client,
+                             const char *port_type,
+                             size_t buffer_size,
+                             JackPortTypeInitCallback init,
+                             JackPortTypeMixdownCallback mixdown) JACK_OPTIONAL_WEAK_EXPORT;
+
 /*@}*/
 
 /**
@@ -55,6 +55,7 @@ typedef struct {
     size_t	size;
     size_t	size_mask;
     int	mlocked;
+    size_t	mirror_size;
 }
 jack_ringbuffer_t ;
 
@@ -70,6 +71,27 @@ jack_ringbuffer_t ;
  */
 jack_ringbuffer_t *jack_ringbuffer_create(size_t sz);
 
+/**
+ * Allocates a mirrored ringbuffer data structure of a specified
+ * size. The data is mapped twice in a row in the virtual address
+ * space, so that the readable data and the writable space are always
+ * one contiguous segment: jack_ringbuffer_get_read_vector() and
+ * jack_ringbuffer_get_write_vector() return a second element with a
+ * zero @a len field, and the returned segments can be passed directly
+ * to functions like writev() or a codec. The ringbuffer is used with
+ * the same API, and must be released with jack_ringbuffer_free().
+ *
+ * The size is rounded up to a multiple of the page size. Mirroring is
+ * not available on every system, callers can fall back on
+ * jack_ringbuffer_create() when this function fails.
+ *
+ * @param sz the ringbuffer size in bytes.
+ *
+ * @return a pointer to a new jack_ringbuffer_t, if successful; NULL
+ * otherwise.
+ */
+jack_ringbuffer_t *jack_ringbuffer_create_mirrored(size_t sz);
+
 /**
  * Frees the ringbuffer data structure allocated by an earlier call to
  * jack_ringbuffer_create().
@@ -195,7 +217,8 @@ void jack_ringbuffer_reset(jack_ringbuffer_t *rb);
 /**
  * Reset the internal "available" size, and read and write pointers, making an empty buffer.
  *
- * This is not thread safe.
+ * This is not thread safe. A mirrored ringbuffer reset to a smaller
+ * size is handled as a non mirrored one.
  *
  * @param rb a pointer to the ringbuffer structure.
  * @param sz the new size, that must be less than allocated size.
@@ -236,6 +259,103 @@ void jack_ringbuffer_write_advance(jack_ringbuffer_t *rb, size_t cnt);
  */
 size_t jack_ringbuffer_write_space(const jack_ringbuffer_t *rb);
 
+/**
+ * @defgroup FrameRingbuffer Multichannel frame ringbuffer
+ *
+ * A single reader / single writer ringbuffer of audio frames, with the
+ * same thread rules as jack_ringbuffer_t. The read and write indices
+ * live in separate cache lines and each side keeps a cached copy of the
+ * other side index, so that a producer and a consumer running on
+ * different cores do not share a cache line on every call. Samples are
+ * 32 bit floats (jack_default_audio_sample_t) and are stored
+ * interleaved, so a whole cycle of all channels is moved in one call.
+ * @{
+ */
+
+typedef struct jack_frame_ringbuffer jack_frame_ringbuffer_t;
+
+/**
+ * Allocates a frame ringbuffer.
+ *
+ * @param channels the number of channels of each frame.
+ * @param frames the capacity in frames, rounded up to the next power of two.
+ *
+ * @return a pointer to a new jack_frame_ringbuffer_t, if successful; NULL
+ * otherwise.
+ */
+jack_frame_ringbuffer_t *jack_frame_ringbuffer_create(unsigned int channels, size_t frames);
+
+/**
+ * Frees a frame ringbuffer allocated by jack_frame_ringbuffer_create().
+ */
+void jack_frame_ringbuffer_free(jack_frame_ringbuffer_t *rb);
+
+/**
+ * Lock the data of the frame ringbuffer in memory.
+ *
+ * @return 0 on success, otherwise a non-zero error code.
+ */
+int jack_frame_ringbuffer_mlock(jack_frame_ringbuffer_t *rb);
+
+/**
+ * Empty the frame ringbuffer. This is not thread safe.
+ */
+void jack_frame_ringbuffer_reset(jack_frame_ringbuffer_t *rb);
+
+/**
+ * @return the number of channels of each frame.
+ */
+unsigned int jack_frame_ringbuffer_channels(const jack_frame_ringbuffer_t *rb);
+
+/**
+ * @return the number of frames available for reading. To be called by the reader.
+ */
+size_t jack_frame_ringbuffer_read_space(jack_frame_ringbuffer_t *rb);
+
+/**
+ * @return the number of frames available for writing. To be called by the writer.
+ */
+size_t jack_frame_ringbuffer_write_space(jack_frame_ringbuffer_t *rb);
+
+/**
+ * Write frames from one buffer per channel, for instance the buffers
+ * returned by jack_port_get_buffer() for each port.
+ *
+ * @param rb a pointer to the frame ringbuffer structure.
+ * @param channels an array of jack_frame_ringbuffer_channels() sample buffers.
+ * @param frames the number of frames to write.
+ *
+ * @return the number of frames written, which may range from 0 to @a frames.
+ */
+size_t jack_frame_ringbuffer_write(jack_frame_ringbuffer_t *rb, const float *const *channels, size_t frames);
+
+/**
+ * Write interleaved frames.
+ *
+ * @return the number of frames written, which may range from 0 to @a frames.
+ */
+size_t jack_frame_ringbuffer_write_interleaved(jack_frame_ringbuffer_t *rb, const float *src, size_t frames);
+
+/**
+ * Read frames into one buffer per channel.
+ *
+ * @param rb a pointer to the frame ringbuffer structure.
+ * @param channels an array of jack_frame_ringbuffer_channels() sample buffers.
+ * @param frames the number of frames to read.
+ *
+ * @return the number of frames read, which may range from 0 to @a frames.
+ */
+size_t jack_frame_ringbuffer_read(jack_frame_ringbuffer_t *rb, float *const *channels, size_t frames);
+
+/**
+ * Read interleaved frames, for instance to write them to a sound file.
+ *
+ * @return the number of frames read, which may range from 0 to @a frames.
+ */
+size_t jack_frame_ringbuffer_read_interleaved(jack_frame_ringbuffer_t *rb, float *dest, size_t frames);
+
+/*@}*/
+
 #ifdef __cplusplus
 }
 #endif
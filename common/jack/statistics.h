@@ -50,6 +50,55 @@ float jack_get_xrun_delayed_usecs (jack_client_t *client);
  */
 void jack_reset_max_delayed_usecs (jack_client_t *client);
 
+/**
+ * Timing distributions maintained by the server.
+ */
+typedef enum {
+    JackCycleDuration = 0,      /**< Server cycle duration: driver wake-up to end of the graph */
+    JackWakeupLateness = 1,     /**< Driver wake-up date minus previous wake-up date plus one period */
+    JackClientCompute = 2       /**< Compute time of a client, from its wake-up to the end of its cycle */
+} jack_cycle_histogram_t;
+
+/**
+ * Get a server timing histogram. Buckets are log-linear: each power of
+ * two of microseconds is split in 8 buckets, so bucket bounds have a
+ * relative resolution of 12.5%.
+ *
+ * @param client pointer to JACK client structure.
+ * @param type the distribution to read.
+ * @param client_name the measured client for @a JackClientCompute, ignored otherwise.
+ * @param upper_bounds array receiving the largest value, in usecs, counted in each bucket.
+ * @param counts array receiving the number of values in each bucket.
+ * @param size the size of @a upper_bounds and @a counts.
+ *
+ * @return the number of buckets filled, up to the last non empty one, or -1
+ * if the histogram does not exist (for instance an unknown client). Call
+ * with a @a size of 0 to get the number of buckets needed.
+ */
+int jack_get_cycle_histogram (jack_client_t *client,
+                              jack_cycle_histogram_t type,
+                              const char *client_name,
+                              jack_time_t *upper_bounds,
+                              uint32_t *counts,
+                              int size);
+
+/**
+ * @return the upper bound, in usecs, of the histogram bucket containing
+ * @a percentile (between 0 and 100) of the values measured since startup
+ * or reset, or -1 if the histogram is unknown or empty. Parameters are
+ * the same as jack_get_cycle_histogram().
+ */
+float jack_get_cycle_percentile (jack_client_t *client,
+                                 jack_cycle_histogram_t type,
+                                 const char *client_name,
+                                 float percentile);
+
+/**
+ * Reset all server timing histograms. The reset is done by the server
+ * realtime thread at the next cycle.
+ */
+void jack_reset_cycle_histograms (jack_client_t *client);
+
 #ifdef __cplusplus
 }
 #endif
@@ -451,6 +451,43 @@ typedef void (*JackInfoShutdownCallback)(jack_status_t code, const char* reason,
 #define JACK_DEFAULT_AUDIO_TYPE "32 bit float mono audio"
 #define JACK_DEFAULT_MIDI_TYPE "8 bit raw midi"
 
+/**
+ * Used for the type argument of jack_port_register() for control
+ * ports : the buffer holds a single jack_default_audio_sample_t value
+ * per cycle, several connections are mixed by averaging their values.
+ */
+#define JACK_DEFAULT_CONTROL_TYPE "32 bit float control"
+
+/**
+ * Used for the type argument of jack_port_register() for control
+ * ports holding a single jack_default_audio_sample_t value per cycle,
+ * like JACK_DEFAULT_CONTROL_TYPE, but where several connections are
+ * mixed by taking the value of the last connected output.
+ */
+#define JACK_LAST_CONTROL_TYPE "32 bit float control last"
+
+/**
+ * Prototype for the initialization function of a port type registered
+ * with jack_port_type_register(), called on the buffers of unconnected
+ * input ports.
+ *
+ * @param buffer buffer to initialize
+ * @param size size of the buffer in bytes, as given at registration
+ */
+typedef void (*JackPortTypeInitCallback)(void* buffer, size_t size);
+
+/**
+ * Prototype for the mixdown function of a port type registered with
+ * jack_port_type_register(), called on the input ports with several
+ * connections.
+ *
+ * @param mix_buffer buffer receiving the mix
+ * @param src_buffers buffers of the connected output ports
+ * @param src_count number of connected output ports, at least 1
+ * @param size size of the buffers in bytes, as given at registration
+ */
+typedef void (*JackPortTypeMixdownCallback)(void* mix_buffer, void** src_buffers, int src_count, size_t size);
+
 /**
  * For convenience, use this typedef if you want to be able to change
  * between float and double. You may want to typedef sample_t to
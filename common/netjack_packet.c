@@ -35,7 +35,7 @@
 #define _DARWIN_C_SOURCE
 #endif
 
-#if HAVE_PPOLL
+#if HAVE_PPOLL || HAVE_RECVMMSG
 #define _GNU_SOURCE
 #endif
 
@@ -175,6 +175,8 @@ packet_cache
     pcache->master_address_valid = 0;
     pcache->last_framecnt_retreived = 0;
     pcache->last_framecnt_retreived_valid = 0;
+    pcache->last_framecnt_released = 0;
+    pcache->last_framecnt_released_valid = 0;
 
     if (pcache->packets == NULL) {
         jack_error ("could not allocate packet cache (2)");
@@ -184,6 +186,7 @@ packet_cache
     for (i = 0; i < num_packets; i++) {
         pcache->packets[i].valid = 0;
         pcache->packets[i].num_fragments = fragment_number;
+        pcache->packets[i].num_fragments_received = 0;
         pcache->packets[i].packet_size = pkt_size;
         pcache->packets[i].mtu = mtu;
         pcache->packets[i].framecnt = 0;
@@ -215,32 +218,33 @@ packet_cache_free (packet_cache *pcache)
     free (pcache);
 }
 
+// Returns the packet of framecnt, or NULL when it is not in the cache.
+static cache_packet
+*packet_cache_find_packet (packet_cache *pcache, jack_nframes_t framecnt)
+{
+    cache_packet *cpack = &(pcache->packets[framecnt % pcache->size]);
+
+    if (cpack->valid && (cpack->framecnt == framecnt))
+        return cpack;
+
+    return NULL;
+}
+
 cache_packet
 *packet_cache_get_packet (packet_cache *pcache, jack_nframes_t framecnt)
 {
-    int i;
-    cache_packet *retval;
+    cache_packet *retval = &(pcache->packets[framecnt % pcache->size]);
 
-    for (i = 0; i < pcache->size; i++) {
-        if (pcache->packets[i].valid && (pcache->packets[i].framecnt == framecnt))
-            return &(pcache->packets[i]);
-    }
+    if (retval->valid) {
+        if (retval->framecnt == framecnt)
+            return retval;
 
-    // The Packet is not in the packet cache.
-    // find a free packet.
-
-    retval = packet_cache_get_free_packet (pcache);
-    if (retval != NULL) {
-        cache_packet_set_framecnt (retval, framecnt);
-        return retval;
+        // The slot holds another packet, which is at least
+        // size frames away : drop it from the cache.
+        //printf( "Dropping %d from Cache :S\n", retval->framecnt );
+        cache_packet_reset (retval);
     }
 
-    // No Free Packet available
-    // Get The Oldest packet and reset it.
-
-    retval = packet_cache_get_oldest_packet (pcache);
-    //printf( "Dropping %d from Cache :S\n", retval->framecnt );
-    cache_packet_reset (retval);
     cache_packet_set_framecnt (retval, framecnt);
 
     return retval;
@@ -284,25 +288,18 @@ cache_packet
 void
 cache_packet_reset (cache_packet *pack)
 {
-    int i;
+    // fragment array is cleared in _set_framecnt()
     pack->valid = 0;
-
-    // XXX: i don't think this is necessary here...
-    //      fragment array is cleared in _set_framecnt()
-
-    for (i = 0; i < pack->num_fragments; i++)
-        pack->fragment_array[i] = 0;
+    pack->num_fragments_received = 0;
 }
 
 void
 cache_packet_set_framecnt (cache_packet *pack, jack_nframes_t framecnt)
 {
-    int i;
-
     pack->framecnt = framecnt;
 
-    for (i = 0; i < pack->num_fragments; i++)
-        pack->fragment_array[i] = 0;
+    memset (pack->fragment_array, 0, pack->num_fragments);
+    pack->num_fragments_received = 0;
 
     pack->valid = 1;
 }
@@ -325,7 +322,10 @@ cache_packet_add_fragment (cache_packet *pack, char *packet_buf, int rcv_len)
 
     if (fragment_nr == 0) {
         memcpy (pack->packet_buf, packet_buf, rcv_len);
-        pack->fragment_array[0] = 1;
+        if (pack->fragment_array[0] == 0) {
+            pack->fragment_array[0] = 1;
+            pack->num_fragments_received++;
+        }
 
         return;
     }
@@ -333,7 +333,10 @@ cache_packet_add_fragment (cache_packet *pack, char *packet_buf, int rcv_len)
     if ((fragment_nr < pack->num_fragments) && (fragment_nr > 0)) {
         if ((fragment_nr * fragment_payload_size + rcv_len - sizeof (jacknet_packet_header)) <= (pack->packet_size - sizeof (jacknet_packet_header))) {
             memcpy (packet_bufX + fragment_nr * fragment_payload_size, dataX, rcv_len - sizeof (jacknet_packet_header));
-            pack->fragment_array[fragment_nr] = 1;
+            if (pack->fragment_array[fragment_nr] == 0) {
+                pack->fragment_array[fragment_nr] = 1;
+                pack->num_fragments_received++;
+            }
         } else
             jack_error ("too long packet received...");
     }
@@ -342,12 +345,7 @@ cache_packet_add_fragment (cache_packet *pack, char *packet_buf, int rcv_len)
 int
 cache_packet_is_complete (cache_packet *pack)
 {
-    int i;
-    for (i = 0; i < pack->num_fragments; i++)
-        if (pack->fragment_array[i] == 0)
-            return 0;
-
-    return 1;
+    return (pack->num_fragments_received == pack->num_fragments);
 }
 
 #ifndef WIN32
@@ -500,24 +498,91 @@ netjack_poll_deadline (int sockfd, jack_time_t deadline)
     return 0;
 }
 #endif
+// Adds one received fragment to the cache.
+
+static void
+packet_cache_add_rx_packet( packet_cache *pcache, char *rx_packet, int rcv_len, struct sockaddr_in *sender_address, socklen_t senderlen )
+{
+    jacknet_packet_header *pkthdr = (jacknet_packet_header *) rx_packet;
+    jack_nframes_t framecnt;
+    cache_packet *cpack;
+
+    if (pcache->master_address_valid) {
+        // Verify its from our master.
+        if (memcmp (sender_address, &(pcache->master_address), senderlen) != 0)
+            return;
+    } else {
+        // Setup this one as master
+        //printf( "setup master...\n" );
+        memcpy ( &(pcache->master_address), sender_address, senderlen );
+        pcache->master_address_valid = 1;
+    }
+
+    framecnt = ntohl (pkthdr->framecnt);
+    if( pcache->last_framecnt_retreived_valid && (framecnt <= pcache->last_framecnt_retreived ))
+        return;
+
+    cpack = packet_cache_get_packet (pcache, framecnt);
+    cache_packet_add_fragment (cpack, rx_packet, rcv_len);
+    cpack->recv_timestamp = jack_get_time();
+}
+
 // This now reads all a socket has into the cache.
 // replacing netjack_recv functions.
 
+#if HAVE_RECVMMSG
+// Fragments read by each system call.
+#define NETJACK_RECV_BATCH 16
+
+void
+packet_cache_drain_socket( packet_cache *pcache, int sockfd )
+{
+    char *rx_packets = alloca (pcache->mtu * NETJACK_RECV_BATCH);
+    struct mmsghdr msgs[NETJACK_RECV_BATCH];
+    struct iovec iovecs[NETJACK_RECV_BATCH];
+    struct sockaddr_in sender_addresses[NETJACK_RECV_BATCH];
+    int i, rcv_num;
+
+    memset (msgs, 0, sizeof (msgs));
+    for (i = 0; i < NETJACK_RECV_BATCH; i++) {
+        iovecs[i].iov_base = rx_packets + i * pcache->mtu;
+        iovecs[i].iov_len = pcache->mtu;
+        msgs[i].msg_hdr.msg_iov = &iovecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &sender_addresses[i];
+    }
+
+    while (1) {
+        for (i = 0; i < NETJACK_RECV_BATCH; i++)
+            msgs[i].msg_hdr.msg_namelen = sizeof( struct sockaddr_in );
+
+        rcv_num = recvmmsg (sockfd, msgs, NETJACK_RECV_BATCH, MSG_DONTWAIT, NULL);
+        if (rcv_num <= 0)
+            return;
+
+        for (i = 0; i < rcv_num; i++)
+            packet_cache_add_rx_packet (pcache, (char *) iovecs[i].iov_base, msgs[i].msg_len,
+                                        &sender_addresses[i], msgs[i].msg_hdr.msg_namelen);
+
+        // The socket was emptied.
+        if (rcv_num < NETJACK_RECV_BATCH)
+            return;
+    }
+}
+
+#else
 void
 packet_cache_drain_socket( packet_cache *pcache, int sockfd )
 {
     char *rx_packet = alloca (pcache->mtu);
-    jacknet_packet_header *pkthdr = (jacknet_packet_header *) rx_packet;
     int rcv_len;
-    jack_nframes_t framecnt;
-    cache_packet *cpack;
     struct sockaddr_in sender_address;
 #ifdef WIN32
     int senderlen = sizeof( struct sockaddr_in );
     u_long parm = 1;
     ioctlsocket( sockfd, FIONBIO, &parm );
 #else
-    unsigned int senderlen = sizeof( struct sockaddr_in );
+    socklen_t senderlen = sizeof( struct sockaddr_in );
 #endif
     while (1) {
 #ifdef WIN32
@@ -530,26 +595,10 @@ packet_cache_drain_socket( packet_cache *pcache, int sockfd )
         if (rcv_len < 0)
             return;
 
-        if (pcache->master_address_valid) {
-            // Verify its from our master.
-            if (memcmp (&sender_address, &(pcache->master_address), senderlen) != 0)
-                continue;
-        } else {
-            // Setup this one as master
-            //printf( "setup master...\n" );
-            memcpy ( &(pcache->master_address), &sender_address, senderlen );
-            pcache->master_address_valid = 1;
-        }
-
-        framecnt = ntohl (pkthdr->framecnt);
-        if( pcache->last_framecnt_retreived_valid && (framecnt <= pcache->last_framecnt_retreived ))
-            continue;
-
-        cpack = packet_cache_get_packet (pcache, framecnt);
-        cache_packet_add_fragment (cpack, rx_packet, rcv_len);
-        cpack->recv_timestamp = jack_get_time();
+        packet_cache_add_rx_packet (pcache, rx_packet, rcv_len, &sender_address, senderlen);
     }
 }
+#endif
 
 void
 packet_cache_reset_master_address( packet_cache *pcache )
@@ -557,33 +606,39 @@ packet_cache_reset_master_address( packet_cache *pcache )
     pcache->master_address_valid = 0;
     pcache->last_framecnt_retreived = 0;
     pcache->last_framecnt_retreived_valid = 0;
+    pcache->last_framecnt_released = 0;
+    pcache->last_framecnt_released_valid = 0;
 }
 
+// Drops the packets older than framecnt. Those older than the previously
+// released one were dropped with it, and the ones received since then are
+// not cached : only the slots of the framecnts in between are checked.
 void
 packet_cache_clear_old_packets (packet_cache *pcache, jack_nframes_t framecnt )
 {
-    int i;
+    jack_nframes_t first = framecnt - pcache->size;
+    jack_nframes_t i;
+    cache_packet *cpack;
 
-    for (i = 0; i < pcache->size; i++) {
-        if (pcache->packets[i].valid && (pcache->packets[i].framecnt < framecnt)) {
-            cache_packet_reset (&(pcache->packets[i]));
+    if (pcache->last_framecnt_released_valid
+        && (framecnt - pcache->last_framecnt_released) <= (jack_nframes_t) pcache->size)
+        first = pcache->last_framecnt_released + 1;
+
+    for (i = first; i != framecnt; i++) {
+        cpack = &(pcache->packets[i % pcache->size]);
+        if (cpack->valid && (cpack->framecnt < framecnt)) {
+            cache_packet_reset (cpack);
         }
     }
+
+    pcache->last_framecnt_released_valid = 1;
+    pcache->last_framecnt_released = framecnt;
 }
 
 int
 packet_cache_retreive_packet_pointer( packet_cache *pcache, jack_nframes_t framecnt, char **packet_buf, int pkt_size, jack_time_t *timestamp )
 {
-    int i;
-    cache_packet *cpack = NULL;
-
-
-    for (i = 0; i < pcache->size; i++) {
-        if (pcache->packets[i].valid && (pcache->packets[i].framecnt == framecnt)) {
-            cpack = &(pcache->packets[i]);
-            break;
-        }
-    }
+    cache_packet *cpack = packet_cache_find_packet (pcache, framecnt);
 
     if( cpack == NULL ) {
         //printf( "retrieve packet: %d....not found\n", framecnt );
@@ -608,16 +663,7 @@ packet_cache_retreive_packet_pointer( packet_cache *pcache, jack_nframes_t frame
 int
 packet_cache_release_packet( packet_cache *pcache, jack_nframes_t framecnt )
 {
-    int i;
-    cache_packet *cpack = NULL;
-
-
-    for (i = 0; i < pcache->size; i++) {
-        if (pcache->packets[i].valid && (pcache->packets[i].framecnt == framecnt)) {
-            cpack = &(pcache->packets[i]);
-            break;
-        }
-    }
+    cache_packet *cpack = packet_cache_find_packet (pcache, framecnt);
 
     if( cpack == NULL ) {
         //printf( "retrieve packet: %d....not found\n", framecnt );
@@ -656,6 +702,14 @@ packet_cache_get_next_available_framecnt( packet_cache *pcache, jack_nframes_t e
     int i;
     jack_nframes_t best_offset = JACK_MAX_FRAMES / 2 - 1;
     int retval = 0;
+    cache_packet *expected = packet_cache_find_packet (pcache, expected_framecnt);
+
+    // Usual case, the expected packet is there.
+    if (expected && cache_packet_is_complete( expected )) {
+        if (framecnt)
+            *framecnt = expected_framecnt;
+        return 1;
+    }
 
     for (i = 0; i < pcache->size; i++) {
         cache_packet *cpack = &(pcache->packets[i]);
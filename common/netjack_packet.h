@@ -76,11 +76,13 @@ extern "C"
     };
 
     // fragment reorder cache.
+    // packets are kept in a ring indexed by framecnt % size.
     typedef struct _cache_packet cache_packet;
 
     struct _cache_packet {
         int		    valid;
         int		    num_fragments;
+        int		    num_fragments_received;
         int		    packet_size;
         int		    mtu;
         jack_time_t	    recv_timestamp;
@@ -99,6 +101,8 @@ extern "C"
         int master_address_valid;
         jack_nframes_t last_framecnt_retreived;
         int last_framecnt_retreived_valid;
+        jack_nframes_t last_framecnt_released;
+        int last_framecnt_released_valid;
     };
 
     // fragment cache function prototypes
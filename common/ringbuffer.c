@@ -25,6 +25,16 @@
 #ifdef USE_MLOCK
 #include <sys/mman.h>
 #endif /* USE_MLOCK */
+#ifndef WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#else
+#include <stdio.h>
+#endif
+#endif /* WIN32 */
 #include "JackCompilerDeps.h"
 
 typedef struct {
@@ -40,10 +50,12 @@ typedef struct {
     size_t	size;
     size_t	size_mask;
     int	mlocked;
+    size_t	mirror_size;
 }
 jack_ringbuffer_t ;
 
 LIB_EXPORT jack_ringbuffer_t *jack_ringbuffer_create(size_t sz);
+LIB_EXPORT jack_ringbuffer_t *jack_ringbuffer_create_mirrored(size_t sz);
 LIB_EXPORT void jack_ringbuffer_free(jack_ringbuffer_t *rb);
 LIB_EXPORT void jack_ringbuffer_get_read_vector(const jack_ringbuffer_t *rb,
                                          jack_ringbuffer_data_t *vec);
@@ -86,10 +98,102 @@ jack_ringbuffer_create (size_t sz)
 		return NULL;
 	}
 	rb->mlocked = 0;
+	rb->mirror_size = 0;
 
 	return rb;
 }
 
+/* The data of a mirrored ringbuffer is mapped twice, the second
+   mapping right after the first one, so that the data starting at any
+   offset can be accessed contiguously up to `size' bytes. */
+
+#ifndef WIN32
+
+static int
+jack_ringbuffer_mirror_fd (size_t size)
+{
+	int fd;
+#ifdef __linux__
+#ifdef __NR_memfd_create
+	fd = syscall (__NR_memfd_create, "jack_ringbuffer", 0);
+#else
+	fd = -1;
+#endif
+#else
+	char name[64];
+	snprintf (name, sizeof (name), "/jack_ringbuffer-%d-%p", (int) getpid (), (void *) &name);
+	if ((fd = shm_open (name, O_RDWR | O_CREAT | O_EXCL, 0600)) >= 0) {
+		shm_unlink (name);
+	}
+#endif
+	if (fd >= 0 && ftruncate (fd, size) != 0) {
+		close (fd);
+		fd = -1;
+	}
+	return fd;
+}
+
+#endif /* WIN32 */
+
+LIB_EXPORT jack_ringbuffer_t *
+jack_ringbuffer_create_mirrored (size_t sz)
+{
+#ifndef WIN32
+	int power_of_two;
+	long page_size;
+	int fd;
+	char *mem;
+	jack_ringbuffer_t *rb;
+
+	/* Both mappings have to start on a page boundary. */
+	if ((page_size = sysconf (_SC_PAGESIZE)) <= 0) {
+		return NULL;
+	}
+	if (sz < (size_t) page_size) {
+		sz = page_size;
+	}
+	for (power_of_two = 1; (size_t) 1 << power_of_two < sz; power_of_two++);
+
+	if ((rb = (jack_ringbuffer_t *) malloc (sizeof (jack_ringbuffer_t))) == NULL) {
+		return NULL;
+	}
+	rb->size = (size_t) 1 << power_of_two;
+	rb->size_mask = rb->size;
+	rb->size_mask -= 1;
+	rb->write_ptr = 0;
+	rb->read_ptr = 0;
+	rb->mlocked = 0;
+
+	if ((fd = jack_ringbuffer_mirror_fd (rb->size)) < 0) {
+		free (rb);
+		return NULL;
+	}
+
+	/* Reserve the address range, then map the data over each half. */
+	mem = (char *) mmap (NULL, 2 * rb->size, PROT_NONE, MAP_PRIVATE | MAP_ANON, -1, 0);
+	if (mem == MAP_FAILED) {
+		close (fd);
+		free (rb);
+		return NULL;
+	}
+	if (mmap (mem, rb->size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+	    || mmap (mem + rb->size, rb->size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+		munmap (mem, 2 * rb->size);
+		close (fd);
+		free (rb);
+		return NULL;
+	}
+
+	/* The mappings keep the memory alive. */
+	close (fd);
+	rb->buf = mem;
+	rb->mirror_size = rb->size;
+	return rb;
+#else
+	return NULL;
+#endif /* WIN32 */
+}
+
 /* Free all data associated with the ringbuffer `rb'. */
 
 LIB_EXPORT void
@@ -100,6 +204,13 @@ jack_ringbuffer_free (jack_ringbuffer_t * rb)
 		munlock (rb->buf, rb->size);
 	}
 #endif /* USE_MLOCK */
+#ifndef WIN32
+	if (rb->mirror_size) {
+		munmap (rb->buf, 2 * rb->mirror_size);
+		free (rb);
+		return;
+	}
+#endif /* WIN32 */
 	free (rb->buf);
 	free (rb);
 }
@@ -135,6 +246,10 @@ jack_ringbuffer_reset (jack_ringbuffer_t * rb)
 LIB_EXPORT void
 jack_ringbuffer_reset_size (jack_ringbuffer_t * rb, size_t sz)
 {
+    /* The data of a mirrored ringbuffer cannot grow. */
+    if (rb->mirror_size && sz > rb->mirror_size) {
+        sz = rb->mirror_size;
+    }
     rb->size = sz;
     rb->size_mask = rb->size;
     rb->size_mask -= 1;
@@ -201,7 +316,7 @@ jack_ringbuffer_read (jack_ringbuffer_t * rb, char *dest, size_t cnt)
 
 	cnt2 = rb->read_ptr + to_read;
 
-	if (cnt2 > rb->size) {
+	if (cnt2 > rb->size && rb->mirror_size != rb->size) {
 		n1 = rb->size - rb->read_ptr;
 		n2 = cnt2 & rb->size_mask;
 	} else {
@@ -243,7 +358,7 @@ jack_ringbuffer_peek (jack_ringbuffer_t * rb, char *dest, size_t cnt)
 
 	cnt2 = tmp_read_ptr + to_read;
 
-	if (cnt2 > rb->size) {
+	if (cnt2 > rb->size && rb->mirror_size != rb->size) {
 		n1 = rb->size - tmp_read_ptr;
 		n2 = cnt2 & rb->size_mask;
 	} else {
@@ -280,7 +395,7 @@ jack_ringbuffer_write (jack_ringbuffer_t * rb, const char *src, size_t cnt)
 
 	cnt2 = rb->write_ptr + to_write;
 
-	if (cnt2 > rb->size) {
+	if (cnt2 > rb->size && rb->mirror_size != rb->size) {
 		n1 = rb->size - rb->write_ptr;
 		n2 = cnt2 & rb->size_mask;
 	} else {
@@ -341,7 +456,9 @@ jack_ringbuffer_get_read_vector (const jack_ringbuffer_t * rb,
 
 	cnt2 = r + free_cnt;
 
-	if (cnt2 > rb->size) {
+	/* A mirrored ringbuffer is always read in one segment. */
+
+	if (cnt2 > rb->size && rb->mirror_size != rb->size) {
 
 		/* Two part vector: the rest of the buffer after the current write
 		   ptr, plus some from the start of the buffer. */
@@ -387,7 +504,9 @@ jack_ringbuffer_get_write_vector (const jack_ringbuffer_t * rb,
 
 	cnt2 = w + free_cnt;
 
-	if (cnt2 > rb->size) {
+	/* A mirrored ringbuffer is always written in one segment. */
+
+	if (cnt2 > rb->size && rb->mirror_size != rb->size) {
 
 		/* Two part vector: the rest of the buffer after the current write
 		   ptr, plus some from the start of the buffer. */
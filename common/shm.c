@@ -429,6 +429,15 @@ char* jack_shm_addr (jack_shm_info_t* si)
 	return (char*)si->ptr.attached_at;
 }
 
+int
+jack_shm_allocator (jack_shm_registry_index_t index)
+{
+	/* PID of the process that published the segment, 0 if unknown */
+	if (jack_shm_registry == NULL || index < 0 || index >= MAX_SHM_ID)
+		return 0;
+	return jack_shm_registry[index].allocator;
+}
+
 void
 jack_destroy_shm (jack_shm_info_t* si)
 {
@@ -194,6 +194,7 @@ extern "C"
                                                jack_shm_registry_index_t*);
     int jack_release_shm_info (jack_shm_registry_index_t);
     char* jack_shm_addr (jack_shm_info_t* si);
+    int jack_shm_allocator (jack_shm_registry_index_t index);
 
     /* here begin the API */
     int jack_register_server (const char *server_name, int new_registry);
@@ -0,0 +1,214 @@
+/** @file block_client.c
+ *
+ * @brief This simple client demonstrates how to run a client on blocks
+ * of several buffers, with jack_set_block_multiplier().
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <signal.h>
+
+#include <jack/jack.h>
+
+jack_port_t *input_port;
+jack_port_t *output_port;
+jack_client_t *client;
+
+int multiplier = 4;
+volatile unsigned long blocks = 0;
+volatile jack_nframes_t block_size = 0;
+volatile sig_atomic_t stopped = 0;
+
+#ifdef WIN32
+#define jack_sleep(val) Sleep((val))
+#else
+#define jack_sleep(val) usleep((val) * 1000)
+#endif
+
+/**
+ * The process callback for this JACK application is called in a
+ * special realtime thread once every 'multiplier' audio cycles, with
+ * a block of 'multiplier' buffers.
+ *
+ * This client does nothing more than copy data from its input
+ * port to its output port. The server adds the block delay to the
+ * latencies of its ports, so it does not need a latency callback.
+ */
+int
+process (jack_nframes_t nframes, void *arg)
+{
+	jack_default_audio_sample_t *in, *out;
+
+	in = jack_port_get_buffer (input_port, nframes);
+	out = jack_port_get_buffer (output_port, nframes);
+
+	memcpy (out, in, sizeof (jack_default_audio_sample_t) * nframes);
+
+	block_size = nframes;
+	blocks++;
+	return 0;
+}
+
+/**
+ * Stop on Ctrl+C, and still print the report.
+ */
+static void
+signal_handler (int sig)
+{
+	stopped = 1;
+}
+
+/**
+ * JACK calls this shutdown_callback if the server ever shuts down or
+ * decides to disconnect the client.
+ */
+void
+jack_shutdown (void *arg)
+{
+	fprintf(stderr, "JACK shut down, exiting ...\n");
+	exit (1);
+}
+
+int
+main (int argc, char *argv[])
+{
+	const char **ports;
+	const char *client_name = "block";
+	const char *server_name = NULL;
+	jack_options_t options = JackNullOption;
+	jack_status_t status;
+	jack_latency_range_t range;
+	int seconds = -1;
+
+	if (argc > 1)
+		multiplier = atoi(argv[1]);
+	if (argc > 2)
+		seconds = atoi(argv[2]);
+
+	/* open a client connection to the JACK server */
+
+	client = jack_client_open (client_name, options, &status, server_name);
+	if (client == NULL) {
+		fprintf (stderr, "jack_client_open() failed, "
+			 "status = 0x%2.0x\n", status);
+		if (status & JackServerFailed) {
+			fprintf (stderr, "Unable to connect to JACK server\n");
+		}
+		exit (1);
+	}
+	if (status & JackServerStarted) {
+		fprintf (stderr, "JACK server started\n");
+	}
+	if (status & JackNameNotUnique) {
+		client_name = jack_get_client_name(client);
+		fprintf (stderr, "unique name `%s' assigned\n", client_name);
+	}
+
+	/* run every 'multiplier' cycles : this must be set before
+	   the client is activated.
+	*/
+
+	if (jack_set_block_multiplier (client, multiplier)) {
+		fprintf (stderr, "cannot use block multiplier = %d\n", multiplier);
+		exit (1);
+	}
+
+	/* tell the JACK server to call `process()' whenever
+	   there is work to be done.
+	*/
+
+	jack_set_process_callback (client, process, 0);
+
+	/* tell the JACK server to call `jack_shutdown()' if
+	   it ever shuts down, either entirely, or if it
+	   just decides to stop calling us.
+	*/
+
+	jack_on_shutdown (client, jack_shutdown, 0);
+
+	/* create two ports */
+
+	input_port = jack_port_register (client, "input",
+					 JACK_DEFAULT_AUDIO_TYPE,
+					 JackPortIsInput, 0);
+	output_port = jack_port_register (client, "output",
+					  JACK_DEFAULT_AUDIO_TYPE,
+					  JackPortIsOutput, 0);
+
+	if ((input_port == NULL) || (output_port == NULL)) {
+		fprintf(stderr, "no more JACK ports available\n");
+		exit (1);
+	}
+
+	/* Tell the JACK server that we are ready to roll.  Our
+	 * process() callback will start running now, once every
+	 * 'multiplier' cycles. */
+
+	if (jack_activate (client)) {
+		fprintf (stderr, "cannot activate client");
+		exit (1);
+	}
+
+	printf ("buffer size: %" PRIu32 ", block size: %" PRIu32 "\n",
+		jack_get_buffer_size (client),
+		jack_get_buffer_size (client) * multiplier);
+
+	/* Connect the ports to the first physical ports */
+
+	ports = jack_get_ports (client, NULL, NULL,
+				JackPortIsPhysical|JackPortIsOutput);
+	if (ports == NULL) {
+		fprintf(stderr, "no physical capture ports\n");
+		exit (1);
+	}
+
+	if (jack_connect (client, ports[0], jack_port_name (input_port))) {
+		fprintf (stderr, "cannot connect input ports\n");
+	}
+
+	free (ports);
+
+	ports = jack_get_ports (client, NULL, NULL,
+				JackPortIsPhysical|JackPortIsInput);
+	if (ports == NULL) {
+		fprintf(stderr, "no physical playback ports\n");
+		exit (1);
+	}
+
+	if (jack_connect (client, jack_port_name (output_port), ports[0])) {
+		fprintf (stderr, "cannot connect output ports\n");
+	}
+
+	free (ports);
+
+	/* install a signal handler to print the report when stopped */
+#ifdef WIN32
+	signal(SIGINT, signal_handler);
+	signal(SIGABRT, signal_handler);
+	signal(SIGTERM, signal_handler);
+#else
+	signal(SIGQUIT, signal_handler);
+	signal(SIGTERM, signal_handler);
+	signal(SIGHUP, signal_handler);
+	signal(SIGINT, signal_handler);
+#endif
+
+	/* keep running until stopped by the user, or for the given time */
+
+	while (!stopped && (seconds < 0 || seconds-- > 0)) {
+		jack_sleep (1000);
+	}
+
+	printf ("%lu blocks of %" PRIu32 " frames processed\n", blocks, block_size);
+	jack_port_get_latency_range (input_port, JackCaptureLatency, &range);
+	printf ("input capture latency: %" PRIu32 " %" PRIu32 "\n", range.min, range.max);
+	jack_port_get_latency_range (output_port, JackPlaybackLatency, &range);
+	printf ("output playback latency: %" PRIu32 " %" PRIu32 "\n", range.min, range.max);
+
+	jack_client_close (client);
+	exit (0);
+}
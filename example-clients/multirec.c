@@ -0,0 +1,646 @@
+/*
+    Copyright (C) 2026
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+    Multichannel recorder for large channel counts: the process thread
+    pushes each period of port buffers into a jack_frame_ringbuffer_t with
+    one lock free call, the disk thread converts the frames and writes
+    them as large aligned blocks, bypassing the page cache when possible,
+    into one interleaved WAV file or one WAV file per channel.
+*/
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <jack/jack.h>
+#include <jack/ringbuffer.h>
+
+/* Alignment of file offsets, sizes and memory for direct I/O. */
+#define ALIGNMENT 4096
+/* The WAV header is padded so that the sample data starts aligned. */
+#define HEADER_SIZE ALIGNMENT
+/* Frames moved from the ringbuffer at once by the disk thread. */
+#define CHUNK_FRAMES 1024
+/* Space reserved ahead of the written data. */
+#define PREALLOCATION (64 * 1024 * 1024)
+
+typedef struct _rec_file {
+	int fd;
+	char path[PATH_MAX];
+	char *buf;                  /* aligned block being filled */
+	size_t fill;                /* bytes in buf */
+	uint64_t offset;            /* file offset of buf */
+	uint64_t allocated;         /* preallocated file size */
+	unsigned int channels;
+} rec_file_t;
+
+typedef struct _rec_info {
+	jack_client_t *client;
+	jack_frame_ringbuffer_t *rb;
+	rec_file_t *files;
+	unsigned int nfiles;
+	unsigned int channels;
+	int bitdepth;               /* 16, 24, 32, or 0 for 32 bit float */
+	int direct;
+	size_t block_size;
+	uint64_t duration;          /* frames, 0 until stopped */
+	uint64_t captured;          /* frames pushed by process() */
+	uint64_t written;           /* frames written by the disk thread */
+	double write_time;          /* seconds spent in write calls */
+	volatile int can_process;
+	volatile int stop;
+	volatile long overruns;
+	int status;
+} rec_info_t;
+
+static jack_port_t **ports;
+static float **in;
+static rec_info_t info;
+
+static void
+signal_handler (int sig)
+{
+	/* The disk thread writes what is queued and completes the files. */
+	info.stop = 1;
+}
+
+static double
+now (void)
+{
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int
+bytes_per_sample (void)
+{
+	return info.bitdepth ? info.bitdepth / 8 : 4;
+}
+
+static void
+put_le16 (unsigned char *p, uint16_t v)
+{
+	p[0] = v & 0xff;
+	p[1] = (v >> 8) & 0xff;
+}
+
+static void
+put_le32 (unsigned char *p, uint32_t v)
+{
+	put_le16 (p, v & 0xffff);
+	put_le16 (p + 2, v >> 16);
+}
+
+static void
+put_le64 (unsigned char *p, uint64_t v)
+{
+	put_le32 (p, v & 0xffffffff);
+	put_le32 (p + 4, v >> 32);
+}
+
+/* WAVE_FORMAT_EXTENSIBLE header of HEADER_SIZE bytes. The JUNK chunk
+ * that pads the header is turned into a ds64 chunk (RF64) when the data
+ * does not fit in 32 bit sizes. */
+static void
+build_header (unsigned char *header, unsigned int channels, jack_nframes_t rate, uint64_t data_size)
+{
+	static const unsigned char guid_tail[14] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+	int bps = bytes_per_sample ();
+	int rf64 = (data_size > 0xffffffffULL - HEADER_SIZE);
+	uint32_t junk_size = HEADER_SIZE - 12 - 8 - 48 - 8;
+	unsigned char *p = header;
+
+	memset (header, 0, HEADER_SIZE);
+
+	memcpy (p, rf64 ? "RF64" : "RIFF", 4);
+	put_le32 (p + 4, rf64 ? 0xffffffff : (uint32_t) (HEADER_SIZE - 8 + data_size));
+	memcpy (p + 8, "WAVE", 4);
+	p += 12;
+
+	memcpy (p, rf64 ? "ds64" : "JUNK", 4);
+	put_le32 (p + 4, junk_size);
+	if (rf64) {
+		put_le64 (p + 8, HEADER_SIZE - 8 + data_size);
+		put_le64 (p + 16, data_size);
+		put_le64 (p + 24, data_size / (bps * channels));
+	}
+	p += 8 + junk_size;
+
+	memcpy (p, "fmt ", 4);
+	put_le32 (p + 4, 40);
+	put_le16 (p + 8, 0xfffe);
+	put_le16 (p + 10, channels);
+	put_le32 (p + 12, rate);
+	put_le32 (p + 16, rate * bps * channels);
+	put_le16 (p + 20, bps * channels);
+	put_le16 (p + 22, bps * 8);
+	put_le16 (p + 24, 22);
+	put_le16 (p + 26, bps * 8);
+	put_le32 (p + 28, 0);
+	put_le16 (p + 32, info.bitdepth ? 1 : 3);   /* PCM or IEEE float sub format */
+	memcpy (p + 34, guid_tail, sizeof (guid_tail));
+	p += 48;
+
+	memcpy (p, "data", 4);
+	put_le32 (p + 4, rf64 ? 0xffffffff : (uint32_t) data_size);
+}
+
+static int
+write_aligned (rec_file_t *file, const char *buf, size_t size, uint64_t offset)
+{
+	double start = now ();
+	size_t done = 0;
+
+	while (done < size) {
+		ssize_t res = pwrite (file->fd, buf + done, size - done, offset + done);
+		if (res < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			fprintf (stderr, "cannot write %s (%s)\n", file->path, strerror (errno));
+			return -1;
+		}
+		done += res;
+	}
+
+	info.write_time += now () - start;
+	return 0;
+}
+
+static void
+preallocate (rec_file_t *file, uint64_t end)
+{
+#ifdef __linux__
+	if (end > file->allocated) {
+		uint64_t size = (end - file->allocated < PREALLOCATION) ? PREALLOCATION : end - file->allocated;
+		/* Keep the size: a file cut by a crash does not end with zeroes. */
+		if (fallocate (file->fd, FALLOC_FL_KEEP_SIZE, file->allocated, size) == 0) {
+			file->allocated += size;
+		} else {
+			/* Not supported by the file system, do not try again. */
+			file->allocated = UINT64_MAX;
+		}
+	}
+#endif
+}
+
+static int
+open_file (rec_file_t *file, unsigned int channels, uint64_t expected_size)
+{
+	int flags = O_WRONLY | O_CREAT | O_TRUNC;
+
+	file->channels = channels;
+	file->fill = 0;
+	file->offset = HEADER_SIZE;
+	file->allocated = 0;
+
+	if (posix_memalign ((void **) &file->buf, ALIGNMENT, info.block_size + CHUNK_FRAMES * channels * 4)) {
+		fprintf (stderr, "cannot allocate memory for %s\n", file->path);
+		return -1;
+	}
+
+#ifdef O_DIRECT
+	if (info.direct) {
+		file->fd = open (file->path, flags | O_DIRECT, 0644);
+		if (file->fd >= 0) {
+			goto opened;
+		}
+		/* tmpfs and some network file systems do not support it */
+		if (errno == EINVAL) {
+			fprintf (stderr, "direct I/O not supported for %s, using buffered writes\n", file->path);
+			info.direct = 0;
+		}
+	}
+#endif
+	file->fd = open (file->path, flags, 0644);
+	if (file->fd < 0) {
+		fprintf (stderr, "cannot open %s (%s)\n", file->path, strerror (errno));
+		return -1;
+	}
+
+#ifdef O_DIRECT
+ opened:
+#endif
+#ifdef F_NOCACHE
+	if (info.direct) {
+		fcntl (file->fd, F_NOCACHE, 1);
+	}
+#endif
+
+	preallocate (file, expected_size ? expected_size : PREALLOCATION);
+
+	/* The header is completed when the file is closed. */
+	build_header ((unsigned char *) file->buf, channels, jack_get_sample_rate (info.client), 0);
+	return write_aligned (file, file->buf, HEADER_SIZE, 0);
+}
+
+/* Write all complete blocks in the buffer. */
+static int
+flush_blocks (rec_file_t *file)
+{
+	size_t size = file->fill - file->fill % info.block_size;
+
+	if (size == 0) {
+		return 0;
+	}
+	preallocate (file, file->offset + size);
+	if (write_aligned (file, file->buf, size, file->offset) < 0) {
+		return -1;
+	}
+	file->offset += size;
+	file->fill -= size;
+	memmove (file->buf, file->buf + size, file->fill);
+	return 0;
+}
+
+static int
+close_file (rec_file_t *file)
+{
+	int res = 0;
+	uint64_t data_size = file->offset + file->fill - HEADER_SIZE;
+
+	/* Direct I/O needs whole blocks, the padding is truncated afterwards. */
+	if (file->fill > 0) {
+		size_t size = (file->fill + ALIGNMENT - 1) & ~((size_t) ALIGNMENT - 1);
+		memset (file->buf + file->fill, 0, size - file->fill);
+		res |= write_aligned (file, file->buf, size, file->offset);
+	}
+	if (ftruncate (file->fd, HEADER_SIZE + data_size) != 0) {
+		fprintf (stderr, "cannot truncate %s (%s)\n", file->path, strerror (errno));
+		res = -1;
+	}
+
+	build_header ((unsigned char *) file->buf, file->channels, jack_get_sample_rate (info.client), data_size);
+	res |= write_aligned (file, file->buf, HEADER_SIZE, 0);
+
+	close (file->fd);
+	free (file->buf);
+	return res;
+}
+
+static void
+convert (char *dst, const float *src, size_t count)
+{
+	size_t i;
+
+	switch (info.bitdepth) {
+		case 0:
+			memcpy (dst, src, count * sizeof (float));
+			break;
+		case 16:
+			for (i = 0; i < count; i++) {
+				float s = src[i] < -1.f ? -1.f : (src[i] > 1.f ? 1.f : src[i]);
+				int16_t v = (int16_t) (s * 32767.f);
+				put_le16 ((unsigned char *) dst + 2 * i, v);
+			}
+			break;
+		case 24:
+			for (i = 0; i < count; i++) {
+				float s = src[i] < -1.f ? -1.f : (src[i] > 1.f ? 1.f : src[i]);
+				int32_t v = (int32_t) (s * 8388607.f);
+				dst[3 * i] = v & 0xff;
+				dst[3 * i + 1] = (v >> 8) & 0xff;
+				dst[3 * i + 2] = (v >> 16) & 0xff;
+			}
+			break;
+		case 32:
+			for (i = 0; i < count; i++) {
+				double s = src[i] < -1.f ? -1. : (src[i] > 1.f ? 1. : src[i]);
+				put_le32 ((unsigned char *) dst + 4 * i, (uint32_t) (int32_t) (s * 2147483647.));
+			}
+			break;
+	}
+}
+
+static void *
+disk_thread (void *arg)
+{
+	unsigned int chn;
+	int bps = bytes_per_sample ();
+	float *interleaved = malloc (CHUNK_FRAMES * info.channels * sizeof (float));
+	float **channels = malloc (info.channels * sizeof (float *));
+	jack_nframes_t rate = jack_get_sample_rate (info.client);
+
+	for (chn = 0; chn < info.channels; chn++) {
+		channels[chn] = malloc (CHUNK_FRAMES * sizeof (float));
+	}
+
+	while (1) {
+		size_t frames = jack_frame_ringbuffer_read_space (info.rb);
+
+		if (frames < CHUNK_FRAMES) {
+			if (info.stop) {
+				/* Everything queued is written, then the loop ends. */
+				if (frames == 0) {
+					break;
+				}
+			} else {
+				/* No lock with process(): wait for about half a chunk. */
+				usleep ((useconds_t) (CHUNK_FRAMES * 500000.0 / rate));
+				continue;
+			}
+		}
+		if (frames > CHUNK_FRAMES) {
+			frames = CHUNK_FRAMES;
+		}
+
+		if (info.nfiles == 1) {
+			rec_file_t *file = &info.files[0];
+			jack_frame_ringbuffer_read_interleaved (info.rb, interleaved, frames);
+			convert (file->buf + file->fill, interleaved, frames * info.channels);
+			file->fill += frames * info.channels * bps;
+			if (flush_blocks (file) < 0) {
+				info.status = EIO;
+				break;
+			}
+		} else {
+			jack_frame_ringbuffer_read (info.rb, channels, frames);
+			for (chn = 0; chn < info.nfiles; chn++) {
+				rec_file_t *file = &info.files[chn];
+				convert (file->buf + file->fill, channels[chn], frames);
+				file->fill += frames * bps;
+				if (flush_blocks (file) < 0) {
+					info.status = EIO;
+					goto done;
+				}
+			}
+		}
+		info.written += frames;
+	}
+
+ done:
+	for (chn = 0; chn < info.channels; chn++) {
+		free (channels[chn]);
+	}
+	free (channels);
+	free (interleaved);
+	return 0;
+}
+
+static int
+process (jack_nframes_t nframes, void *arg)
+{
+	unsigned int chn;
+
+	/* Do nothing until we're ready to begin. */
+	if (!info.can_process || info.stop) {
+		return 0;
+	}
+
+	if (info.duration && info.captured + nframes > info.duration) {
+		nframes = info.duration - info.captured;
+	}
+
+	for (chn = 0; chn < info.channels; chn++) {
+		in[chn] = jack_port_get_buffer (ports[chn], nframes);
+	}
+
+	/* One copy of the whole period, the disk thread does the rest. */
+	if (jack_frame_ringbuffer_write_space (info.rb) < nframes) {
+		info.overruns++;
+		return 0;
+	}
+	jack_frame_ringbuffer_write (info.rb, (const float * const *) in, nframes);
+	info.captured += nframes;
+
+	/* Set once the last frames are queued. */
+	if (info.duration && info.captured >= info.duration) {
+		info.stop = 1;
+	}
+
+	return 0;
+}
+
+static void
+jack_shutdown (void *arg)
+{
+	fprintf (stderr, "JACK shut down, exiting ...\n");
+	exit (1);
+}
+
+static void
+usage (void)
+{
+	fprintf (stderr, "usage: jack_multirec -f filename [ -d seconds ] [ -b 16|24|32|32f ] [ -c channels ] [ -p ]\n"
+			 "                     [ -B ringbuffer_seconds ] [ -s block_KiB ] [ -D ] [ port1 [ port2 ... ] ]\n");
+}
+
+int
+main (int argc, char *argv[])
+{
+	int c;
+	int longopt_index = 0;
+	unsigned int i;
+	unsigned int sources;
+	unsigned int rb_seconds = 4;
+	unsigned int block_kbytes = 0;
+	int per_channel = 0;
+	double seconds = 0.;
+	char *path = NULL;
+	pthread_t thread_id;
+	jack_nframes_t rate;
+	double start, elapsed;
+	uint64_t total_bytes;
+	const char *optstring = "f:d:b:c:pB:s:Dh";
+	struct option long_options[] = {
+		{ "help", 0, 0, 'h' },
+		{ "file", 1, 0, 'f' },
+		{ "duration", 1, 0, 'd' },
+		{ "bitdepth", 1, 0, 'b' },
+		{ "channels", 1, 0, 'c' },
+		{ "per-channel", 0, 0, 'p' },
+		{ "bufsize", 1, 0, 'B' },
+		{ "block", 1, 0, 's' },
+		{ "no-direct", 0, 0, 'D' },
+		{ 0, 0, 0, 0 }
+	};
+
+	memset (&info, 0, sizeof (info));
+	info.bitdepth = 24;
+	info.direct = 1;
+
+	while ((c = getopt_long (argc, argv, optstring, long_options, &longopt_index)) != -1) {
+		switch (c) {
+		case 'f':
+			path = optarg;
+			break;
+		case 'd':
+			seconds = atof (optarg);
+			break;
+		case 'b':
+			info.bitdepth = strcmp (optarg, "32f") ? atoi (optarg) : 0;
+			break;
+		case 'c':
+			info.channels = atoi (optarg);
+			break;
+		case 'p':
+			per_channel = 1;
+			break;
+		case 'B':
+			rb_seconds = atoi (optarg);
+			break;
+		case 's':
+			block_kbytes = atoi (optarg);
+			break;
+		case 'D':
+			info.direct = 0;
+			break;
+		default:
+			usage ();
+			exit (1);
+		}
+	}
+
+	sources = argc - optind;
+	if (info.channels == 0) {
+		info.channels = sources;
+	}
+	if (path == NULL || info.channels == 0 || rb_seconds == 0
+	    || (info.bitdepth != 0 && info.bitdepth != 16 && info.bitdepth != 24 && info.bitdepth != 32)) {
+		usage ();
+		exit (1);
+	}
+
+	/* Blocks are whole alignment units, smaller per file in per channel mode. */
+	if (block_kbytes == 0) {
+		block_kbytes = per_channel ? 256 : 1024;
+	}
+	info.block_size = ((size_t) block_kbytes * 1024 + ALIGNMENT - 1) & ~((size_t) ALIGNMENT - 1);
+
+	if ((info.client = jack_client_open ("jack_multirec", JackNullOption, NULL)) == 0) {
+		fprintf (stderr, "JACK server not running?\n");
+		exit (1);
+	}
+
+	rate = jack_get_sample_rate (info.client);
+	info.duration = (uint64_t) (seconds * rate);
+
+	info.rb = jack_frame_ringbuffer_create (info.channels, (size_t) rb_seconds * rate);
+	if (info.rb == NULL) {
+		fprintf (stderr, "cannot allocate the ringbuffer\n");
+		exit (1);
+	}
+	/* Avoid page faults in process(). */
+	jack_frame_ringbuffer_mlock (info.rb);
+
+	info.nfiles = per_channel ? info.channels : 1;
+	info.files = calloc (info.nfiles, sizeof (rec_file_t));
+	for (i = 0; i < info.nfiles; i++) {
+		rec_file_t *file = &info.files[i];
+		uint64_t expected = info.duration * bytes_per_sample () * (per_channel ? 1 : info.channels);
+		if (per_channel) {
+			const char *ext = strrchr (path, '.');
+			int base = ext ? (int) (ext - path) : (int) strlen (path);
+			snprintf (file->path, sizeof (file->path), "%.*s-%03u%s", base, path, i + 1, ext ? ext : ".wav");
+		} else {
+			snprintf (file->path, sizeof (file->path), "%s", path);
+		}
+		if (open_file (file, per_channel ? 1 : info.channels, expected ? HEADER_SIZE + expected : 0) < 0) {
+			jack_client_close (info.client);
+			exit (1);
+		}
+	}
+
+	ports = malloc (info.channels * sizeof (jack_port_t *));
+	in = calloc (info.channels, sizeof (float *));
+	for (i = 0; i < info.channels; i++) {
+		char name[64];
+		snprintf (name, sizeof (name), "input%u", i + 1);
+		if ((ports[i] = jack_port_register (info.client, name, JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0)) == 0) {
+			fprintf (stderr, "cannot register input port \"%s\"!\n", name);
+			jack_client_close (info.client);
+			exit (1);
+		}
+	}
+
+	jack_set_process_callback (info.client, process, &info);
+	jack_on_shutdown (info.client, jack_shutdown, &info);
+
+	if (jack_activate (info.client)) {
+		fprintf (stderr, "cannot activate client\n");
+		jack_client_close (info.client);
+		exit (1);
+	}
+
+	for (i = 0; i < sources && i < info.channels; i++) {
+		if (jack_connect (info.client, argv[optind + i], jack_port_name (ports[i]))) {
+			fprintf (stderr, "cannot connect input port %s to %s\n", jack_port_name (ports[i]), argv[optind + i]);
+			jack_client_close (info.client);
+			exit (1);
+		}
+	}
+
+#ifndef WIN32
+	signal (SIGQUIT, signal_handler);
+	signal (SIGHUP, signal_handler);
+#endif
+	signal (SIGTERM, signal_handler);
+	signal (SIGINT, signal_handler);
+
+	pthread_create (&thread_id, NULL, disk_thread, &info);
+	start = now ();
+	info.can_process = 1;
+	pthread_join (thread_id, NULL);
+	elapsed = now () - start;
+
+	jack_deactivate (info.client);
+
+	for (i = 0; i < info.nfiles; i++) {
+		if (close_file (&info.files[i]) < 0) {
+			info.status = EIO;
+		}
+	}
+
+	total_bytes = info.written * info.channels * bytes_per_sample ();
+	printf ("%" PRIu64 " frames, %u channels, %.1f MB written in %.2f s (%s I/O)\n",
+		info.written, info.channels, total_bytes / 1e6, elapsed, info.direct ? "direct" : "buffered");
+	if (info.write_time > 0.) {
+		/* What the disk thread could sustain if it did nothing but write. */
+		double rate_mb = total_bytes / 1e6 / info.write_time;
+		printf ("disk write throughput %.1f MB/s, that is %.0f channels at %u Hz\n",
+			rate_mb, rate_mb * 1e6 / (bytes_per_sample () * (double) rate), rate);
+	}
+	if (info.overruns > 0) {
+		fprintf (stderr, "jack_multirec failed with %ld overruns, try a bigger buffer than -B %u.\n",
+			 info.overruns, rb_seconds);
+		info.status = EPIPE;
+	}
+
+	jack_client_close (info.client);
+	jack_frame_ringbuffer_free (info.rb);
+	free (info.files);
+	free (ports);
+	free (in);
+
+	return info.status ? 1 : 0;
+}
@@ -0,0 +1,18 @@
+reset
+set terminal png transparent nocrop enhanced
+set output 'framegraph-256-1.png'
+set title "Frame time evolution during jack_test run"
+set yrange [ 224.00000 : 288.0000 ] noreverse nowriteback
+set xrange [ 0.00000 : 9964.0000 ] noreverse nowriteback
+set ylabel "Frametime evolution (d(ft)/dt)"
+set xlabel "FrameTime"
+set label "| buf.siz:3556 | fr.wl:2244 | rg.ports:7200 | 2nd.client:5696 | trsprt:0 |" at graph 0.01, 0.04
+plot 'framefile-256.dat' using 2 with impulses title "Xruns",'framefile-256.dat' using 1 with line title "Sampletime variation at 256"
+set output 'framegraph-256-2.png'
+set title "Frame time evolution during jack_test run"
+set yrange [ 128.00000 : 544.0000 ] noreverse nowriteback
+set xrange [ 0.00000 : 9964.0000 ] noreverse nowriteback
+set ylabel "Frametime evolution (d(ft)/dt)"
+set xlabel "FrameTime"
+set label "| buf.siz:3556 | fr.wl:2244 | rg.ports:7200 | 2nd.client:5696 | trsprt:0 |" at graph 0.01, 0.04
+plot 'framefile-256.dat' using 2 with impulses title "Xruns",'framefile-256.dat' using 1 with line title "Sampletime variation at 256"
@@ -0,0 +1,401 @@
+/*
+Copyright (C) 2026
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include <string.h>
+#include <errno.h>
+
+#include "JackAlsaAggregateDevice.h"
+#include "JackGraphManager.h"
+#include "JackError.h"
+
+namespace Jack
+{
+
+// Periods queued in the playback device
+#define AGGREGATE_PLAYBACK_PERIODS 2
+// Periods in the device buffers
+#define AGGREGATE_DEVICE_PERIODS 4
+
+JackAlsaAggregateDevice::JackAlsaAggregateDevice(const char* name)
+    :fBufferSize(0), fSampleRate(0)
+{
+    strncpy(fName, name, JACK_CLIENT_NAME_SIZE);
+    fName[JACK_CLIENT_NAME_SIZE] = 0;
+}
+
+JackAlsaAggregateDevice::~JackAlsaAggregateDevice()
+{
+    Close();
+}
+
+int JackAlsaAggregateDevice::OpenStream(JackAlsaAggregateStream* stream, snd_pcm_stream_t direction)
+{
+    static const snd_pcm_format_t formats[] = { SND_PCM_FORMAT_FLOAT_LE, SND_PCM_FORMAT_S32_LE, SND_PCM_FORMAT_S16_LE };
+    const char* stream_name = (direction == SND_PCM_STREAM_CAPTURE) ? "capture" : "playback";
+    snd_pcm_hw_params_t* hw_params;
+    snd_pcm_sw_params_t* sw_params;
+    snd_pcm_uframes_t period = fBufferSize;
+    unsigned int channels;
+    size_t format;
+    int err;
+
+    if ((err = snd_pcm_open(&stream->fHandle, fName, direction, SND_PCM_NONBLOCK)) < 0) {
+        stream->fHandle = NULL;
+        jack_info("ALSA: aggregated device %s has no %s stream (%s)", fName, stream_name, snd_strerror(err));
+        return -1;
+    }
+
+    snd_pcm_hw_params_alloca(&hw_params);
+    snd_pcm_hw_params_any(stream->fHandle, hw_params);
+
+    if ((err = snd_pcm_hw_params_set_access(stream->fHandle, hw_params, SND_PCM_ACCESS_RW_INTERLEAVED)) < 0) {
+        jack_error("ALSA: aggregated device %s does not support interleaved %s (%s)", fName, stream_name, snd_strerror(err));
+        goto error;
+    }
+
+    for (format = 0; format < sizeof(formats) / sizeof(formats[0]); format++) {
+        if (snd_pcm_hw_params_set_format(stream->fHandle, hw_params, formats[format]) == 0) {
+            break;
+        }
+    }
+
+    switch (format) {
+        case 0:
+            stream->fSampleBytes = 4;
+            stream->fReadVia = sample_move_floatLE_sSs;
+            stream->fWriteVia = sample_move_dS_floatLE;
+            break;
+        case 1:
+            stream->fSampleBytes = 4;
+            stream->fReadVia = sample_move_dS_s32u24;
+            stream->fWriteVia = sample_move_d32u24_sS;
+            break;
+        case 2:
+            stream->fSampleBytes = 2;
+            stream->fReadVia = sample_move_dS_s16;
+            stream->fWriteVia = sample_move_d16_sS;
+            break;
+        default:
+            jack_error("ALSA: aggregated device %s has no supported %s sample format", fName, stream_name);
+            goto error;
+    }
+
+    // Same channel defaults as the driver itself
+    snd_pcm_hw_params_get_channels_max(hw_params, &channels);
+    if (channels > 1024) {
+        channels = 2;
+    }
+    if ((err = snd_pcm_hw_params_set_channels(stream->fHandle, hw_params, channels)) < 0) {
+        jack_error("ALSA: aggregated device %s cannot set %u %s channels (%s)", fName, channels, stream_name, snd_strerror(err));
+        goto error;
+    }
+
+    // Only the drift is compensated, not a different nominal rate
+    if ((err = snd_pcm_hw_params_set_rate(stream->fHandle, hw_params, fSampleRate, 0)) < 0) {
+        jack_error("ALSA: aggregated device %s cannot run %s at %u Hz (%s)", fName, stream_name, fSampleRate, snd_strerror(err));
+        goto error;
+    }
+
+    snd_pcm_hw_params_set_period_size_near(stream->fHandle, hw_params, &period, 0);
+    stream->fDeviceFrames = period * AGGREGATE_DEVICE_PERIODS;
+    snd_pcm_hw_params_set_buffer_size_near(stream->fHandle, hw_params, &stream->fDeviceFrames);
+
+    if ((err = snd_pcm_hw_params(stream->fHandle, hw_params)) < 0) {
+        jack_error("ALSA: aggregated device %s cannot set %s hardware parameters (%s)", fName, stream_name, snd_strerror(err));
+        goto error;
+    }
+
+    // The device may have chosen other sizes than the requested ones
+    snd_pcm_hw_params_get_period_size(hw_params, &period, 0);
+    snd_pcm_hw_params_get_buffer_size(hw_params, &stream->fDeviceFrames);
+
+    // Streams are started explicitly, and never wait for the device
+    snd_pcm_sw_params_alloca(&sw_params);
+    snd_pcm_sw_params_current(stream->fHandle, sw_params);
+    snd_pcm_sw_params_set_start_threshold(stream->fHandle, sw_params, stream->fDeviceFrames + 1);
+    snd_pcm_sw_params_set_avail_min(stream->fHandle, sw_params, period);
+    if ((err = snd_pcm_sw_params(stream->fHandle, sw_params)) < 0) {
+        jack_error("ALSA: aggregated device %s cannot set %s software parameters (%s)", fName, stream_name, snd_strerror(err));
+        goto error;
+    }
+
+    // Frames enter or leave the FIFO by device periods, the driver consumes or produces its own period
+    stream->fBurstFrames = (period > fBufferSize) ? period : fBufferSize;
+    stream->fQueueFrames = AGGREGATE_PLAYBACK_PERIODS * stream->fBurstFrames;
+    if (stream->fQueueFrames > stream->fDeviceFrames) {
+        stream->fQueueFrames = stream->fDeviceFrames;
+    }
+
+    // Capture : half a period of margin on top of the largest burst
+    // Playback : measured after the period is queued, one burst of margin
+    stream->fTarget = (direction == SND_PCM_STREAM_CAPTURE)
+        ? stream->fBurstFrames + fBufferSize / 2
+        : fBufferSize + stream->fBurstFrames;
+
+    stream->fChannels = channels;
+    stream->fDeviceBuffer = new char[stream->fDeviceFrames * channels * stream->fSampleBytes];
+    stream->fFrames = new jack_default_audio_sample_t[stream->fDeviceFrames * channels];
+    stream->fBuffers.resize(channels);
+    // Room for the target level plus a full device buffer, when a late cycle reads all of it
+    stream->fResampler = new JackMultiChannelResampler(channels, stream->fTarget + stream->fDeviceFrames + stream->fBurstFrames);
+    stream->fPIControler = new JackPIControler(1., 256);
+
+    jack_info("ALSA: aggregated device %s %s %u channels, %d bits", fName, stream_name, channels, stream->fSampleBytes * 8);
+    return 0;
+
+error:
+    snd_pcm_close(stream->fHandle);
+    stream->fHandle = NULL;
+    return -1;
+}
+
+void JackAlsaAggregateDevice::CloseStream(JackAlsaAggregateStream* stream)
+{
+    if (stream->fHandle) {
+        snd_pcm_close(stream->fHandle);
+        stream->fHandle = NULL;
+    }
+    delete[] stream->fDeviceBuffer;
+    delete[] stream->fFrames;
+    delete stream->fResampler;
+    delete stream->fPIControler;
+    stream->fDeviceBuffer = NULL;
+    stream->fFrames = NULL;
+    stream->fResampler = NULL;
+    stream->fPIControler = NULL;
+    stream->fChannels = 0;
+}
+
+int JackAlsaAggregateDevice::Open(bool capturing, bool playing, jack_nframes_t buffer_size, jack_nframes_t sample_rate)
+{
+    fBufferSize = buffer_size;
+    fSampleRate = sample_rate;
+
+    if (capturing) {
+        OpenStream(&fCapture, SND_PCM_STREAM_CAPTURE);
+    }
+    if (playing) {
+        OpenStream(&fPlayback, SND_PCM_STREAM_PLAYBACK);
+    }
+
+    if (!fCapture.fHandle && !fPlayback.fHandle) {
+        jack_error("ALSA: cannot open aggregated device %s", fName);
+        return -1;
+    }
+    return 0;
+}
+
+void JackAlsaAggregateDevice::Close()
+{
+    CloseStream(&fCapture);
+    CloseStream(&fPlayback);
+}
+
+int JackAlsaAggregateDevice::SetBufferSize(jack_nframes_t buffer_size)
+{
+    bool capturing = (fCapture.fHandle != NULL);
+    bool playing = (fPlayback.fHandle != NULL);
+
+    Close();
+    return Open(capturing, playing, buffer_size, fSampleRate);
+}
+
+int JackAlsaAggregateDevice::StartStream(JackAlsaAggregateStream* stream)
+{
+    int err;
+
+    if (!stream->fHandle) {
+        return 0;
+    }
+
+    snd_pcm_drop(stream->fHandle);
+    if ((err = snd_pcm_prepare(stream->fHandle)) < 0) {
+        jack_error("ALSA: cannot prepare aggregated device %s (%s)", fName, snd_strerror(err));
+        return -1;
+    }
+
+    // Restart from the nominal ratio, with FIFOs at their target level
+    stream->fPIControler->Init(1.);
+    stream->fPIControler->offset_integral = 0.;
+
+    if (stream == &fCapture) {
+        stream->fResampler->Reset(stream->fTarget);
+    } else {
+        stream->fResampler->Reset(stream->fTarget - fBufferSize);
+        // Silence is all zeros in the supported formats
+        memset(stream->fDeviceBuffer, 0, stream->fQueueFrames * stream->fChannels * stream->fSampleBytes);
+        snd_pcm_writei(stream->fHandle, stream->fDeviceBuffer, stream->fQueueFrames);
+    }
+
+    if ((err = snd_pcm_start(stream->fHandle)) < 0) {
+        jack_error("ALSA: cannot start aggregated device %s (%s)", fName, snd_strerror(err));
+        return -1;
+    }
+    return 0;
+}
+
+int JackAlsaAggregateDevice::Start()
+{
+    return (StartStream(&fCapture) == 0 && StartStream(&fPlayback) == 0) ? 0 : -1;
+}
+
+int JackAlsaAggregateDevice::Stop()
+{
+    if (fCapture.fHandle) {
+        snd_pcm_drop(fCapture.fHandle);
+    }
+    if (fPlayback.fHandle) {
+        snd_pcm_drop(fPlayback.fHandle);
+    }
+    return 0;
+}
+
+void JackAlsaAggregateDevice::Recover(JackAlsaAggregateStream* stream, int err)
+{
+    jack_error("ALSA: aggregated device %s %s xrun (%s), restarting", fName,
+               (stream == &fCapture) ? "capture" : "playback", snd_strerror(err));
+    StartStream(stream);
+}
+
+void JackAlsaAggregateDevice::Read(JackGraphManager* manager, jack_nframes_t frames)
+{
+    JackAlsaAggregateStream* stream = &fCapture;
+    if (!stream->fHandle) {
+        return;
+    }
+
+    // Queue everything the device has captured since the previous cycle
+    snd_pcm_sframes_t avail = snd_pcm_avail_update(stream->fHandle);
+    if (avail < 0) {
+        Recover(stream, avail);
+        avail = 0;
+    }
+
+    while (avail > 0) {
+        snd_pcm_uframes_t chunk = ((snd_pcm_uframes_t)avail < stream->fDeviceFrames) ? avail : stream->fDeviceFrames;
+        if (chunk > stream->fResampler->WriteSpace()) {
+            jack_error("ALSA: aggregated device %s capture overflow", fName);
+            stream->fResampler->Reset(stream->fTarget);
+            if (chunk > stream->fResampler->WriteSpace()) {
+                chunk = stream->fResampler->WriteSpace();
+            }
+        }
+        jack_default_audio_sample_t* dst = (chunk > 0) ? stream->fResampler->GetWriteBuffer(chunk) : NULL;
+        if (!dst) {
+            // Frames are still read to keep the device running, but dropped
+            chunk = ((snd_pcm_uframes_t)avail < stream->fDeviceFrames) ? avail : stream->fDeviceFrames;
+        }
+        snd_pcm_sframes_t read = snd_pcm_readi(stream->fHandle, stream->fDeviceBuffer, chunk);
+        if (read < 0) {
+            if (read != -EAGAIN) {
+                Recover(stream, read);
+            }
+            break;
+        }
+        if (dst) {
+            stream->fReadVia(dst, stream->fDeviceBuffer, read * stream->fChannels, stream->fSampleBytes);
+            stream->fResampler->WriteAdvance(read);
+        }
+        avail -= read;
+    }
+
+    double ratio = stream->fPIControler->GetRatio(int(stream->fResampler->ReadSpace()) - int(stream->fTarget));
+
+    for (int i = 0; i < stream->fChannels; i++) {
+        stream->fBuffers[i] = (manager->GetConnectionsNum(stream->fPorts[i]) > 0)
+            ? (jack_default_audio_sample_t*)manager->GetBuffer(stream->fPorts[i], frames)
+            : NULL;
+    }
+
+    jack_nframes_t resampled = stream->fResampler->ReadResample(&stream->fBuffers[0], frames, ratio);
+    if (resampled < frames) {
+        jack_error("ALSA: aggregated device %s capture underrun", fName);
+        for (int i = 0; i < stream->fChannels; i++) {
+            if (stream->fBuffers[i]) {
+                memset(stream->fBuffers[i] + resampled, 0, sizeof(jack_default_audio_sample_t) * (frames - resampled));
+            }
+        }
+        stream->fResampler->Reset(stream->fTarget);
+    }
+}
+
+void JackAlsaAggregateDevice::Write(JackGraphManager* manager, jack_nframes_t frames)
+{
+    JackAlsaAggregateStream* stream = &fPlayback;
+    if (!stream->fHandle) {
+        return;
+    }
+
+    for (int i = 0; i < stream->fChannels; i++) {
+        stream->fBuffers[i] = (manager->GetConnectionsNum(stream->fPorts[i]) > 0)
+            ? (jack_default_audio_sample_t*)manager->GetBuffer(stream->fPorts[i], frames)
+            : NULL;
+    }
+
+    if (stream->fResampler->Write(&stream->fBuffers[0], frames) < frames) {
+        jack_error("ALSA: aggregated device %s playback overflow", fName);
+        stream->fResampler->Reset(stream->fTarget - frames);
+        return;
+    }
+
+    // Refill the device up to its target level, at the device clock
+    snd_pcm_sframes_t delay;
+    int err = snd_pcm_delay(stream->fHandle, &delay);
+    if (err < 0) {
+        Recover(stream, err);
+        return;
+    }
+
+    snd_pcm_sframes_t wanted = (snd_pcm_sframes_t)stream->fQueueFrames - delay;
+    if (wanted <= 0) {
+        return;
+    }
+    if ((snd_pcm_uframes_t)wanted > stream->fDeviceFrames) {
+        wanted = stream->fDeviceFrames;
+    }
+
+    double ratio = stream->fPIControler->GetRatio(int(stream->fResampler->ReadSpace()) - int(stream->fTarget));
+
+    unsigned int resampled = stream->fResampler->ReadResample(stream->fFrames, wanted, ratio);
+    if (resampled < (unsigned int)wanted) {
+        jack_error("ALSA: aggregated device %s playback underrun", fName);
+        memset(stream->fFrames + resampled * stream->fChannels, 0, sizeof(jack_default_audio_sample_t) * (wanted - resampled) * stream->fChannels);
+        stream->fResampler->Reset(stream->fTarget - frames);
+    }
+
+    stream->fWriteVia(stream->fDeviceBuffer, stream->fFrames, wanted * stream->fChannels, stream->fSampleBytes, &stream->fDither);
+    snd_pcm_sframes_t written = snd_pcm_writei(stream->fHandle, stream->fDeviceBuffer, wanted);
+    if (written < 0 && written != -EAGAIN) {
+        Recover(stream, written);
+    }
+}
+
+jack_nframes_t JackAlsaAggregateDevice::GetCaptureLatency()
+{
+    // Frames waiting in the FIFO, on top of the driver capture latency
+    return fCapture.fTarget;
+}
+
+jack_nframes_t JackAlsaAggregateDevice::GetPlaybackLatency()
+{
+    // Frames left in the FIFO once the device is refilled, plus the device queue, on top of the driver playback latency
+    return (fPlayback.fTarget - fBufferSize) + fPlayback.fQueueFrames;
+}
+
+} // end of namespace
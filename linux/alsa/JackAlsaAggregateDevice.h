@@ -0,0 +1,141 @@
+/*
+Copyright (C) 2026
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __JackAlsaAggregateDevice__
+#define __JackAlsaAggregateDevice__
+
+#include <alsa/asoundlib.h>
+#include <string.h>
+#include <vector>
+
+#include "JackConstants.h"
+#include "JackFilters.h"
+#include "JackMultiChannelResampler.h"
+#include "memops.h"
+#include "types.h"
+
+namespace Jack
+{
+
+class JackGraphManager;
+
+/*!
+\brief One direction of an aggregated device.
+*/
+
+struct JackAlsaAggregateStream
+{
+    snd_pcm_t* fHandle;
+    int fChannels;
+    int fSampleBytes;
+    snd_pcm_uframes_t fDeviceFrames;        // device buffer size
+    snd_pcm_uframes_t fBurstFrames;         // largest of the device period and the driver period
+    snd_pcm_uframes_t fQueueFrames;         // playback frames kept in the device
+    jack_nframes_t fTarget;                 // FIFO level kept by the PI controler
+    char* fDeviceBuffer;
+    jack_default_audio_sample_t* fFrames;   // interleaved frames, playback only
+    std::vector<jack_default_audio_sample_t*> fBuffers;
+    std::vector<jack_port_id_t> fPorts;
+    JackMultiChannelResampler* fResampler;
+    JackPIControler* fPIControler;
+    void (*fReadVia)(jack_default_audio_sample_t* dst, char* src, unsigned long nsamples, unsigned long src_skip);
+    void (*fWriteVia)(char* dst, jack_default_audio_sample_t* src, unsigned long nsamples, unsigned long dst_skip, dither_state_t* state);
+    dither_state_t fDither;
+
+    JackAlsaAggregateStream()
+        :fHandle(NULL), fChannels(0), fSampleBytes(0), fDeviceFrames(0), fBurstFrames(0), fQueueFrames(0), fTarget(0),
+        fDeviceBuffer(NULL), fFrames(NULL), fResampler(NULL), fPIControler(NULL), fReadVia(NULL), fWriteVia(NULL)
+    {
+        memset(&fDither, 0, sizeof(fDither));
+    }
+};
+
+/*!
+\brief A secondary ALSA device driven by the cycle of the ALSA driver.
+
+The device runs on its own clock : captured frames are queued and resampled to the driver
+clock, playback frames are resampled to the device clock and queued, in the driver thread.
+A PI controler keeps the FIFOs at a fixed level, so the added latency stays constant.
+*/
+
+class JackAlsaAggregateDevice
+{
+
+    private:
+
+        char fName[JACK_CLIENT_NAME_SIZE+1];
+        jack_nframes_t fBufferSize;
+        jack_nframes_t fSampleRate;
+        JackAlsaAggregateStream fCapture;
+        JackAlsaAggregateStream fPlayback;
+
+        int OpenStream(JackAlsaAggregateStream* stream, snd_pcm_stream_t direction);
+        void CloseStream(JackAlsaAggregateStream* stream);
+        int StartStream(JackAlsaAggregateStream* stream);
+        void Recover(JackAlsaAggregateStream* stream, int err);
+
+    public:
+
+        JackAlsaAggregateDevice(const char* name);
+        ~JackAlsaAggregateDevice();
+
+        int Open(bool capturing, bool playing, jack_nframes_t buffer_size, jack_nframes_t sample_rate);
+        void Close();
+
+        // Reopens the streams that were open, the device has to be stopped
+        int SetBufferSize(jack_nframes_t buffer_size);
+
+        int Start();
+        int Stop();
+
+        // Called in the driver cycle, after the driver read and before the driver write
+        void Read(JackGraphManager* manager, jack_nframes_t frames);
+        void Write(JackGraphManager* manager, jack_nframes_t frames);
+
+        const char* GetName()
+        {
+            return fName;
+        }
+
+        int GetCaptureChannels()
+        {
+            return fCapture.fChannels;
+        }
+        int GetPlaybackChannels()
+        {
+            return fPlayback.fChannels;
+        }
+
+        std::vector<jack_port_id_t>& GetCapturePorts()
+        {
+            return fCapture.fPorts;
+        }
+        std::vector<jack_port_id_t>& GetPlaybackPorts()
+        {
+            return fPlayback.fPorts;
+        }
+
+        jack_nframes_t GetCaptureLatency();
+        jack_nframes_t GetPlaybackLatency();
+
+};
+
+} // end of namespace
+
+#endif
@@ -89,6 +89,9 @@ int JackAlsaDriver::SetBufferSize(jack_nframes_t buffer_size)
     if (res == 0) { // update fEngineControl and fGraphManager
         JackAudioDriver::SetBufferSize(buffer_size);  // Generic change, never fails
         // ALSA specific
+        for (size_t i = 0; i < fAggregateDevices.size(); i++) {
+            fAggregateDevices[i]->SetBufferSize(buffer_size);
+        }
         UpdateLatencies();
     } else {
         // Restore old values
@@ -112,7 +115,11 @@ void JackAlsaDriver::UpdateLatencies()
 
     for (int i = 0; i < fPlaybackChannels; i++) {
         // Add one buffer more latency if "async" mode is used...
-        range.min = range.max = (alsa_driver->frames_per_cycle * (alsa_driver->user_nperiods - 1)) +
+        // With timer wakeups, the buffer is only filled up to the headroom
+        jack_nframes_t queued = (alsa_driver->timer_wakeup)
+            ? alsa_driver_timer_headroom(alsa_driver)
+            : alsa_driver->frames_per_cycle * (alsa_driver->user_nperiods - 1);
+        range.min = range.max = queued +
                          ((fEngineControl->fSyncMode) ? 0 : fEngineControl->fBufferSize) + alsa_driver->playback_frame_latency;
         fGraphManager->GetPort(fPlaybackPortList[i])->SetLatencyRange(JackPlaybackLatency, &range);
         // Monitor port
@@ -121,6 +128,21 @@ void JackAlsaDriver::UpdateLatencies()
             fGraphManager->GetPort(fMonitorPortList[i])->SetLatencyRange(JackCaptureLatency, &range);
         }
     }
+
+    // Aggregated devices add their FIFO level
+    for (size_t i = 0; i < fAggregateDevices.size(); i++) {
+        JackAlsaAggregateDevice* device = fAggregateDevices[i];
+        std::vector<jack_port_id_t>& capture_ports = device->GetCapturePorts();
+        std::vector<jack_port_id_t>& playback_ports = device->GetPlaybackPorts();
+        for (size_t j = 0; j < capture_ports.size(); j++) {
+            range.min = range.max = alsa_driver->frames_per_cycle + device->GetCaptureLatency();
+            fGraphManager->GetPort(capture_ports[j])->SetLatencyRange(JackCaptureLatency, &range);
+        }
+        for (size_t j = 0; j < playback_ports.size(); j++) {
+            range.min = range.max = ((fEngineControl->fSyncMode) ? 0 : fEngineControl->fBufferSize) + device->GetPlaybackLatency();
+            fGraphManager->GetPort(playback_ports[j])->SetLatencyRange(JackPlaybackLatency, &range);
+        }
+    }
 }
 
 int JackAlsaDriver::Attach()
@@ -184,6 +206,40 @@ int JackAlsaDriver::Attach()
         }
     }
 
+    // Aggregated devices ports follow the ones of the main device
+    int capture_index = fCaptureChannels;
+    int playback_index = fPlaybackChannels;
+
+    for (size_t i = 0; i < fAggregateDevices.size(); i++) {
+        JackAlsaAggregateDevice* device = fAggregateDevices[i];
+        std::vector<jack_port_id_t>& capture_ports = device->GetCapturePorts();
+        std::vector<jack_port_id_t>& playback_ports = device->GetPlaybackPorts();
+        capture_ports.clear();
+        playback_ports.clear();
+
+        for (int j = 0; j < device->GetCaptureChannels(); j++) {
+            snprintf(alias, sizeof(alias), "%s:%s:out%d", fAliasName, device->GetName(), j + 1);
+            snprintf(name, sizeof(name), "%s:capture_%d", fClientControl.fName, ++capture_index);
+            if (fEngine->PortRegister(fClientControl.fRefNum, name, JACK_DEFAULT_AUDIO_TYPE, CaptureDriverFlags, fEngineControl->fBufferSize, &port_index) < 0) {
+                jack_error("driver: cannot register port for %s", name);
+                return -1;
+            }
+            fGraphManager->GetPort(port_index)->SetAlias(alias);
+            capture_ports.push_back(port_index);
+        }
+
+        for (int j = 0; j < device->GetPlaybackChannels(); j++) {
+            snprintf(alias, sizeof(alias), "%s:%s:in%d", fAliasName, device->GetName(), j + 1);
+            snprintf(name, sizeof(name), "%s:playback_%d", fClientControl.fName, ++playback_index);
+            if (fEngine->PortRegister(fClientControl.fRefNum, name, JACK_DEFAULT_AUDIO_TYPE, PlaybackDriverFlags, fEngineControl->fBufferSize, &port_index) < 0) {
+                jack_error("driver: cannot register port for %s", name);
+                return -1;
+            }
+            fGraphManager->GetPort(port_index)->SetAlias(alias);
+            playback_ports.push_back(port_index);
+        }
+    }
+
     UpdateLatencies();
 
     if (alsa_driver->midi) {
@@ -201,6 +257,19 @@ int JackAlsaDriver::Detach()
     if (alsa_driver->midi)
         (alsa_driver->midi->detach)(alsa_driver->midi);
 
+    for (size_t i = 0; i < fAggregateDevices.size(); i++) {
+        std::vector<jack_port_id_t>& capture_ports = fAggregateDevices[i]->GetCapturePorts();
+        std::vector<jack_port_id_t>& playback_ports = fAggregateDevices[i]->GetPlaybackPorts();
+        for (size_t j = 0; j < capture_ports.size(); j++) {
+            fEngine->PortUnRegister(fClientControl.fRefNum, capture_ports[j]);
+        }
+        for (size_t j = 0; j < playback_ports.size(); j++) {
+            fEngine->PortUnRegister(fClientControl.fRefNum, playback_ports[j]);
+        }
+        capture_ports.clear();
+        playback_ports.clear();
+    }
+
     return JackAudioDriver::Detach();
 }
 
@@ -291,7 +360,10 @@ int JackAlsaDriver::Open(jack_nframes_t nframes,
                          const char* playback_driver_name,
                          jack_nframes_t capture_latency,
                          jack_nframes_t playback_latency,
-                         const char* midi_driver_name)
+                         const char* midi_driver_name,
+                         bool timer_wakeup,
+                         jack_nframes_t timer_headroom,
+                         const char* aggregate_names)
 {
     // Generic JackAudioDriver Open
     if (JackAudioDriver::Open(nframes, samplerate, capturing, playing,
@@ -351,7 +423,9 @@ int JackAlsaDriver::Open(jack_nframes_t nframes,
                                shorts_first,
                                capture_latency,
                                playback_latency,
-                               midi);
+                               midi,
+                               timer_wakeup,
+                               timer_headroom);
     if (!fDriver) {
         Close();
         return -1;
@@ -360,6 +434,11 @@ int JackAlsaDriver::Open(jack_nframes_t nframes,
     // ALSA driver may have changed the in/out values
     fCaptureChannels = ((alsa_driver_t *)fDriver)->capture_nchannels;
     fPlaybackChannels = ((alsa_driver_t *)fDriver)->playback_nchannels;
+
+    if (OpenAggregateDevices(aggregate_names, capturing, playing) != 0) {
+        Close();
+        return -1;
+    }
     if (JackServerGlobals::on_device_reservation_loop != NULL) {
         device_reservation_loop_running = true;
         if (JackPosixThread::StartImp(&fReservationLoopThread, 0, 0, on_device_reservation_loop, NULL) != 0) {
@@ -370,11 +449,47 @@ int JackAlsaDriver::Open(jack_nframes_t nframes,
     return 0;
 }
 
+int JackAlsaDriver::OpenAggregateDevices(const char* aggregate_names, bool capturing, bool playing)
+{
+    alsa_driver_t* alsa_driver = (alsa_driver_t*)fDriver;
+
+    if (!aggregate_names || strcmp(aggregate_names, "none") == 0) {
+        return 0;
+    }
+
+    char* names = strdup(aggregate_names);
+    char* save_ptr;
+    int res = 0;
+
+    for (char* name = strtok_r(names, ",", &save_ptr); name; name = strtok_r(NULL, ",", &save_ptr)) {
+        JackAlsaAggregateDevice* device = new JackAlsaAggregateDevice(name);
+        fAggregateDevices.push_back(device);
+        if (device->Open(capturing, playing, alsa_driver->frames_per_cycle, alsa_driver->frame_rate) != 0) {
+            res = -1;
+            break;
+        }
+        jack_info("ALSA: device %s aggregated", name);
+    }
+
+    free(names);
+    return res;
+}
+
+void JackAlsaDriver::CloseAggregateDevices()
+{
+    for (size_t i = 0; i < fAggregateDevices.size(); i++) {
+        delete fAggregateDevices[i];
+    }
+    fAggregateDevices.clear();
+}
+
 int JackAlsaDriver::Close()
 {
     // Generic audio driver close
     int res = JackAudioDriver::Close();
 
+    CloseAggregateDevices();
+
     if (fDriver) {
         alsa_driver_delete((alsa_driver_t*)fDriver);
     }
@@ -410,6 +525,11 @@ int JackAlsaDriver::Start()
         res = alsa_driver_start((alsa_driver_t *)fDriver);
         if (res < 0) {
             JackAudioDriver::Stop();
+        } else {
+            // A failing aggregated device is restarted by its next cycles
+            for (size_t i = 0; i < fAggregateDevices.size(); i++) {
+                fAggregateDevices[i]->Start();
+            }
         }
     }
     return res;
@@ -417,6 +537,9 @@ int JackAlsaDriver::Start()
 
 int JackAlsaDriver::Stop()
 {
+    for (size_t i = 0; i < fAggregateDevices.size(); i++) {
+        fAggregateDevices[i]->Stop();
+    }
     int res = alsa_driver_stop((alsa_driver_t *)fDriver);
     if (JackAudioDriver::Stop() < 0) {
         res = -1;
@@ -453,12 +576,23 @@ retry:
     // Has to be done before read
     JackDriver::CycleIncTime();
 
-    return alsa_driver_read((alsa_driver_t *)fDriver, fEngineControl->fBufferSize);
+    int res = alsa_driver_read((alsa_driver_t *)fDriver, fEngineControl->fBufferSize);
+
+    // Aggregated devices are resampled to the cycle of the main device
+    for (size_t i = 0; i < fAggregateDevices.size(); i++) {
+        fAggregateDevices[i]->Read(fGraphManager, fEngineControl->fBufferSize);
+    }
+    return res;
 }
 
 int JackAlsaDriver::Write()
 {
-    return alsa_driver_write((alsa_driver_t *)fDriver, fEngineControl->fBufferSize);
+    int res = alsa_driver_write((alsa_driver_t *)fDriver, fEngineControl->fBufferSize);
+
+    for (size_t i = 0; i < fAggregateDevices.size(); i++) {
+        fAggregateDevices[i]->Write(fGraphManager, fEngineControl->fBufferSize);
+    }
+    return res;
 }
 
 void JackAlsaDriver::ReadInputAux(jack_nframes_t orig_nframes, snd_pcm_sframes_t contiguous, snd_pcm_sframes_t nread)
@@ -765,6 +899,16 @@ SERVER_EXPORT const jack_driver_desc_t* driver_get_descriptor ()
     jack_driver_descriptor_add_parameter(desc, &filler, "input-latency", 'I', JackDriverParamUInt, &value, NULL, "Extra input latency (frames)", NULL);
     jack_driver_descriptor_add_parameter(desc, &filler, "output-latency", 'O', JackDriverParamUInt, &value, NULL, "Extra output latency (frames)", NULL);
 
+    value.i = FALSE;
+    jack_driver_descriptor_add_parameter(desc, &filler, "timer", 'T', JackDriverParamBool, &value, NULL, "Wake up on a timer instead of the period interrupts",
+        "Wake up on a high resolution timer, predicted from the hardware position, instead of the period interrupts. The playback buffer is then only filled up to the headroom.");
+    value.ui = 0;
+    jack_driver_descriptor_add_parameter(desc, &filler, "headroom", 'E', JackDriverParamUInt, &value, NULL, "Playback headroom with timer wakeups (frames, 0 for nperiods - 1 periods)", NULL);
+
+    strcpy(value.str, "none");
+    jack_driver_descriptor_add_parameter(desc, &filler, "aggregate", 'A', JackDriverParamString, &value, NULL, "Comma separated list of devices to aggregate",
+        "Comma separated list of ALSA devices driven by the cycle of the main device. Their drift is compensated by resampling in the driver, their ports follow the ones of the main device.");
+
     strcpy(value.str, "none");
     jack_driver_descriptor_add_parameter(
         desc,
@@ -806,6 +950,9 @@ SERVER_EXPORT Jack::JackDriverClientInterface* driver_initialize(Jack::JackLocke
     const JSList * node;
     const jack_driver_param_t * param;
     const char *midi_driver = "none";
+    int timer_wakeup = FALSE;
+    jack_nframes_t timer_headroom = 0;
+    const char *aggregate_names = "none";
 
     for (node = params; node; node = jack_slist_next (node)) {
         param = (const jack_driver_param_t *) node->data;
@@ -904,6 +1051,19 @@ SERVER_EXPORT Jack::JackDriverClientInterface* driver_initialize(Jack::JackLocke
             case 'X':
                 midi_driver = strdup(param->value.str);
                 break;
+
+            case 'T':
+                timer_wakeup = param->value.i;
+                break;
+
+            case 'E':
+                timer_headroom = param->value.ui;
+                break;
+
+            case 'A':
+                // Copied by OpenAggregateDevices
+                aggregate_names = param->value.str;
+                break;
         }
     }
 
@@ -918,7 +1078,7 @@ SERVER_EXPORT Jack::JackDriverClientInterface* driver_initialize(Jack::JackLocke
     // Special open for ALSA driver...
     if (g_alsa_driver->Open(frames_per_interrupt, user_nperiods, srate, hw_monitoring, hw_metering, capture, playback, dither, soft_mode, monitor,
                           user_capture_nchnls, user_playback_nchnls, shorts_first, capture_pcm_name, playback_pcm_name,
-                          systemic_input_latency, systemic_output_latency, midi_driver) == 0) {
+                          systemic_input_latency, systemic_output_latency, midi_driver, timer_wakeup, timer_headroom, aggregate_names) == 0) {
         return threaded_driver;
     } else {
         delete threaded_driver; // Delete the decorated driver
@@ -24,7 +24,9 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #include "JackAudioDriver.h"
 #include "JackThreadedDriver.h"
 #include "JackTime.h"
+#include "JackAlsaAggregateDevice.h"
 #include "alsa_driver.h"
+#include <vector>
 
 namespace Jack
 {
@@ -40,8 +42,11 @@ class JackAlsaDriver : public JackAudioDriver
 
         jack_driver_t* fDriver;
         jack_native_thread_t fReservationLoopThread;
+        std::vector<JackAlsaAggregateDevice*> fAggregateDevices;
 
         void UpdateLatencies();
+        int OpenAggregateDevices(const char* aggregate_names, bool capturing, bool playing);
+        void CloseAggregateDevices();
 
     public:
 
@@ -68,7 +73,10 @@ class JackAlsaDriver : public JackAudioDriver
                  const char* playback_driver_name,
                  jack_nframes_t capture_latency,
                  jack_nframes_t playback_latency,
-                 const char* midi_driver_name);
+                 const char* midi_driver_name,
+                 bool timer_wakeup,
+                 jack_nframes_t timer_headroom,
+                 const char* aggregate_names);
 
         int Close();
         int Attach();
@@ -33,6 +33,7 @@
 #include <sys/types.h>
 #include <sys/time.h>
 #include <string.h>
+#include <time.h>
 
 #include "alsa_driver.h"
 #include "hammerfall.h"
@@ -530,6 +531,17 @@ alsa_driver_configure_stream (alsa_driver_t *driver, char *device_name,
 		return -1;
 	}
 
+#if SND_LIB_VERSION >= 0x010018
+	if (driver->timer_wakeup) {
+		/* woken by a timer, the period interrupts are not needed
+		   (when the device can do without them) */
+		if ((err = snd_pcm_hw_params_set_period_wakeup (handle, hw_params, 0)) < 0) {
+			jack_info ("ALSA: cannot disable period wakeups for %s (%s)",
+				   stream_name, snd_strerror (err));
+		}
+	}
+#endif
+
 	if ((err = snd_pcm_hw_params (handle, hw_params)) < 0) {
 		jack_error ("ALSA: cannot set hardware parameters for %s",
 			    stream_name);
@@ -985,11 +997,12 @@ int
 alsa_driver_start (alsa_driver_t *driver)
 {
 	int err;
-	snd_pcm_uframes_t poffset, pavail;
+	snd_pcm_uframes_t poffset, pavail, prefill;
 	channel_t chn;
 
 	driver->poll_last = 0;
 	driver->poll_next = 0;
+	driver->timer_locked = 0;
 
 	if (driver->playback_handle) {
 		if ((err = snd_pcm_prepare (driver->playback_handle)) < 0) {
@@ -1076,16 +1089,17 @@ alsa_driver_start (alsa_driver_t *driver)
 		   buffer.
 		*/
 
+		/* with timer wakeups, the first period is ready when the
+		   buffer has drained to the headroom */
+		prefill = (driver->timer_wakeup)
+			? alsa_driver_timer_headroom (driver) + driver->frames_per_cycle
+			: driver->user_nperiods * driver->frames_per_cycle;
+
 		for (chn = 0; chn < driver->playback_nchannels; chn++) {
-			alsa_driver_silence_on_channel (
-				driver, chn,
-				driver->user_nperiods
-				* driver->frames_per_cycle);
+			alsa_driver_silence_on_channel (driver, chn, prefill);
 		}
 
-		snd_pcm_mmap_commit (driver->playback_handle, poffset,
-				     driver->user_nperiods
-				     * driver->frames_per_cycle);
+		snd_pcm_mmap_commit (driver->playback_handle, poffset, prefill);
 
 		if ((err = snd_pcm_start (driver->playback_handle)) < 0) {
 			jack_error ("ALSA: could not start playback (%s)",
@@ -1280,6 +1294,175 @@ alsa_driver_set_clock_sync_status (alsa_driver_t *driver, channel_t chn,
 
 static int under_gdb = FALSE;
 
+/* Timer scheduled wakeups: instead of sleeping in poll() until a period
+ * interrupt, the driver sleeps until the date the next period is predicted
+ * to be ready, that is when a period has been captured and the playback
+ * buffer has drained to the headroom. Latency is then set by the headroom,
+ * not by the number of periods. The prediction is a delay locked loop fed
+ * with the hardware position and its timestamp, so that it follows the
+ * actual sample rate of the device.
+ */
+
+#define TIMER_DLL_BANDWIDTH 1.0     /* Hz */
+#define TIMER_WAKEUP_MARGIN 100     /* usecs before the predicted date */
+#define TIMER_MAX_SLEEPS    8
+
+jack_nframes_t
+alsa_driver_timer_headroom (alsa_driver_t *driver)
+{
+	jack_nframes_t buffer_frames;
+	jack_nframes_t headroom;
+
+	if (!driver->playback_handle) {
+		return 0;
+	}
+
+	buffer_frames = driver->frames_per_cycle * driver->playback_nperiods;
+	headroom = (driver->timer_headroom > 0)
+		? driver->timer_headroom
+		: driver->frames_per_cycle * (driver->user_nperiods - 1);
+
+	/* there must be room to write a period */
+	if (headroom > buffer_frames - driver->frames_per_cycle) {
+		headroom = buffer_frames - driver->frames_per_cycle;
+	}
+	return headroom;
+}
+
+static void
+alsa_driver_timer_sleep_until (jack_time_t date)
+{
+	jack_time_t now = jack_get_microseconds ();
+	struct timespec delay;
+
+	if (date <= now) {
+		return;
+	}
+
+	delay.tv_sec = (date - now) / 1000000;
+	delay.tv_nsec = ((date - now) % 1000000) * 1000;
+	while (clock_nanosleep (CLOCK_MONOTONIC, 0, &delay, &delay) == EINTR) {
+	}
+}
+
+/* Frames still to be played or captured before the next period is ready
+ * (zero or negative when it is), and the date of the hardware position.
+ */
+static int
+alsa_driver_timer_missing (alsa_driver_t *driver, snd_pcm_sframes_t *missing,
+			   jack_time_t *date)
+{
+	snd_pcm_t *handles[2] = { driver->playback_handle, driver->capture_handle };
+	snd_pcm_sframes_t ready[2];
+	int found = FALSE;
+	int i;
+
+	ready[0] = driver->frames_per_cycle * driver->playback_nperiods
+		- alsa_driver_timer_headroom (driver);
+	ready[1] = driver->frames_per_cycle;
+	*missing = 0;
+	*date = jack_get_microseconds ();
+
+	for (i = 0; i < 2; i++) {
+		snd_pcm_sframes_t avail;
+		snd_pcm_uframes_t hw_avail;
+		snd_htimestamp_t tstamp;
+		jack_time_t position_date = jack_get_microseconds ();
+
+		if (!handles[i]) {
+			continue;
+		}
+
+		/* updates the hardware position */
+		if ((avail = snd_pcm_avail (handles[i])) < 0) {
+			return avail;
+		}
+
+		if (snd_pcm_htimestamp (handles[i], &hw_avail, &tstamp) == 0
+		    && (tstamp.tv_sec != 0 || tstamp.tv_nsec != 0)) {
+			/* the timestamp is in the ALSA clock, only its age is used */
+			struct timespec now;
+			int64_t age;
+
+			clock_gettime (CLOCK_MONOTONIC, &now);
+			age = (int64_t) (now.tv_sec - tstamp.tv_sec) * 1000000
+				+ (now.tv_nsec - tstamp.tv_nsec) / 1000;
+			if (age >= 0 && age < (int64_t) driver->period_usecs) {
+				position_date -= age;
+				avail = hw_avail;
+			}
+		}
+
+		/* the last stream to be ready decides */
+		if (!found || ready[i] - avail > *missing) {
+			*missing = ready[i] - avail;
+			*date = position_date;
+			found = TRUE;
+		}
+	}
+
+	return 0;
+}
+
+/* Sleeps until the next period is ready and returns 0 with the wakeup
+ * date, -EPIPE (or -ESTRPIPE) on xrun, -ETIMEDOUT when the device does not
+ * progress.
+ */
+static int
+alsa_driver_timer_wait (alsa_driver_t *driver, jack_time_t *wakeup)
+{
+	double usecs_per_frame;
+	double ready_date;
+	snd_pcm_sframes_t missing;
+	jack_time_t date;
+	int sleeps;
+	int err;
+
+	if (driver->timer_locked) {
+		alsa_driver_timer_sleep_until ((jack_time_t) driver->timer_next
+					       - TIMER_WAKEUP_MARGIN);
+		usecs_per_frame = driver->timer_period / driver->frames_per_cycle;
+	} else {
+		usecs_per_frame = 1000000.0 / driver->frame_rate;
+	}
+
+	/* woken up early, or the prediction is not ready yet */
+	for (sleeps = 0; ; sleeps++) {
+		if ((err = alsa_driver_timer_missing (driver, &missing, &date)) < 0) {
+			return err;
+		}
+		if (missing <= 0) {
+			break;
+		}
+		if (sleeps == TIMER_MAX_SLEEPS) {
+			return -ETIMEDOUT;
+		}
+		alsa_driver_timer_sleep_until (date + (jack_time_t) (missing * usecs_per_frame) + 1);
+	}
+
+	/* date the period actually got ready */
+	ready_date = (double) date + missing * usecs_per_frame;
+
+	if (!driver->timer_locked
+	    || fabs (ready_date - driver->timer_next) > driver->period_usecs) {
+		/* (re)start the loop at the nominal rate */
+		double omega = 2.0 * M_PI * TIMER_DLL_BANDWIDTH
+			* driver->period_usecs / 1000000.0;
+		driver->timer_b = M_SQRT2 * omega;
+		driver->timer_c = omega * omega;
+		driver->timer_period = driver->period_usecs;
+		driver->timer_next = ready_date + driver->timer_period;
+		driver->timer_locked = 1;
+	} else {
+		double error = ready_date - driver->timer_next;
+		driver->timer_next += driver->timer_b * error + driver->timer_period;
+		driver->timer_period += driver->timer_c * error;
+	}
+
+	*wakeup = jack_get_microseconds ();
+	return 0;
+}
+
 jack_nframes_t
 alsa_driver_wait (alsa_driver_t *driver, int extra_fd, int *status, float
 		  *delayed_usecs)
@@ -1308,6 +1491,44 @@ alsa_driver_wait (alsa_driver_t *driver, int extra_fd, int *status, float
 
   again:
 
+	if (driver->timer_wakeup && extra_fd < 0
+	    && (need_playback || need_capture)) {
+
+		int timer_result = alsa_driver_timer_wait (driver, &poll_ret);
+
+		if (timer_result == -ETIMEDOUT) {
+			retry_cnt++;
+			if (retry_cnt > MAX_RETRY_COUNT) {
+				jack_error ("ALSA: device does not progress, reached max retry cnt = %d, Exiting",
+					    MAX_RETRY_COUNT);
+				*status = -5;
+				return 0;
+			}
+			jack_error ("ALSA: device does not progress, Retrying with a recovery, retry cnt = %d",
+				    retry_cnt);
+			*status = alsa_driver_xrun_recovery (driver, delayed_usecs);
+			if (*status != 0) {
+				jack_error ("ALSA: timer wait, recovery failed with status = %d", *status);
+				return 0;
+			}
+			goto again;
+		} else if (timer_result < 0) {
+			xrun_detected = TRUE;
+		} else {
+			// JACK2
+			SetTime (poll_ret);
+
+			if (driver->poll_next && poll_ret > driver->poll_next) {
+				*delayed_usecs = poll_ret - driver->poll_next;
+			}
+			driver->poll_last = poll_ret;
+			driver->poll_next = poll_ret + driver->period_usecs;
+		}
+
+		need_playback = 0;
+		need_capture = 0;
+	}
+
 	while ((need_playback || need_capture) && !xrun_detected) {
 
 		int poll_result;
@@ -1553,6 +1774,11 @@ alsa_driver_wait (alsa_driver_t *driver, int extra_fd, int *status, float
 
 	bitset_copy (driver->channels_not_done, driver->channels_done);
 
+	/* the timer wakes up for one period, what is beyond is headroom */
+	if (driver->timer_wakeup && avail >= driver->frames_per_cycle) {
+		return driver->frames_per_cycle;
+	}
+
 	/* constrain the available count to the nearest (round down) number of
 	   periods.
 	*/
@@ -1997,7 +2223,9 @@ alsa_driver_new (char *name, char *playback_alsa_device,
 		 int shorts_first,
 		 jack_nframes_t capture_latency,
 		 jack_nframes_t playback_latency,
-		 alsa_midi_t *midi_driver
+		 alsa_midi_t *midi_driver,
+		 int timer_wakeup,
+		 jack_nframes_t timer_headroom
 		 )
 {
 	int err;
@@ -2084,6 +2312,10 @@ alsa_driver_new (char *name, char *playback_alsa_device,
 	driver->midi = midi_driver;
 	driver->xrun_recovery = 0;
 
+	driver->timer_wakeup = timer_wakeup;
+	driver->timer_headroom = timer_headroom;
+	driver->timer_locked = 0;
+
 	if (alsa_driver_check_card_type (driver)) {
 		alsa_driver_delete (driver);
 		return NULL;
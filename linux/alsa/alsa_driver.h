@@ -145,6 +145,15 @@ typedef struct _alsa_driver {
     alsa_midi_t *midi;
     int xrun_recovery;
 
+    /* timer scheduled wakeups (see alsa_driver_timer_wait) */
+    int            timer_wakeup;
+    jack_nframes_t timer_headroom;  /* playback fill level to process at, 0 for (nperiods - 1) periods */
+    int            timer_locked;
+    double         timer_next;      /* predicted date of the next ready period (usecs) */
+    double         timer_period;    /* measured period duration (usecs) */
+    double         timer_b;
+    double         timer_c;
+
 } alsa_driver_t;
 
 static inline void
@@ -247,7 +256,9 @@ alsa_driver_new (char *name, char *playback_alsa_device,
 		 int shorts_first,
 		 jack_nframes_t capture_latency,
 		 jack_nframes_t playback_latency,
-		 alsa_midi_t *midi_driver
+		 alsa_midi_t *midi_driver,
+		 int timer_wakeup,
+		 jack_nframes_t timer_headroom
 		 );
 void
 alsa_driver_delete (alsa_driver_t *driver);
@@ -268,6 +279,9 @@ alsa_driver_read (alsa_driver_t *driver, jack_nframes_t nframes);
 int
 alsa_driver_write (alsa_driver_t* driver, jack_nframes_t nframes);
 
+jack_nframes_t
+alsa_driver_timer_headroom (alsa_driver_t *driver);
+
 jack_time_t jack_get_microseconds(void);
 
 // Code implemented in JackAlsaDriver.cpp
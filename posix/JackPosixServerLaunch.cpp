@@ -245,8 +245,11 @@ static int server_connect(char* server_name)
     JackClientChannel channel;
     int res = channel.ServerCheck(server_name);
     channel.Close();
-    JackSleep(2000); // Added by JE - 02-01-2009 (gives
-                     // the channel some time to close)
+    // The server polls its sockets and handles this close independently from the next connection,
+    // so only wait when it is not there yet (it may be starting)
+    if (res < 0) {
+        JackSleep(2000);
+    }
     return res;
 }
 
@@ -32,6 +32,28 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 # define SCHED_RESET_ON_FORK 0x40000000
 #endif
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#ifndef SCHED_DEADLINE
+# define SCHED_DEADLINE 6
+#endif
+#ifndef SCHED_FLAG_RESET_ON_FORK
+# define SCHED_FLAG_RESET_ON_FORK 0x01
+#endif
+
+// Not exposed by all libc versions
+struct jack_sched_attr {
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;
+    uint64_t sched_deadline;
+    uint64_t sched_period;
+};
+#endif
+
 namespace Jack
 {
 
@@ -89,11 +111,15 @@ int JackPosixThread::StartSync()
         fStatus = kIdle;
         return -1;
     } else {
-        int count = 0;
-        while (fStatus == kStarting && ++count < 1000) {
-            JackSleep(1000);
+        // The thread usually starts in a few usecs: poll with a growing delay, up to 1 sec in total
+        int waited = 0;
+        int delay = 10;
+        while (fStatus == kStarting && waited < 1000000) {
+            JackSleep(delay);
+            waited += delay;
+            delay = (delay < 1000) ? delay * 2 : 1000;
         }
-        return (count == 1000) ? -1 : 0;
+        return (fStatus == kStarting) ? -1 : 0;
     }
 }
 
@@ -280,6 +306,68 @@ int JackPosixThread::DropRealTimeImp(jack_native_thread_t thread)
     return 0;
 }
 
+int JackPosixThread::AcquireSelfAffinity(const int* cpus, int count)
+{
+    return AcquireAffinityImp(pthread_self(), cpus, count);
+}
+
+int JackPosixThread::AcquireAffinityImp(jack_native_thread_t thread, const int* cpus, int count)
+{
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    int res;
+    CPU_ZERO(&cpu_set);
+    for (int i = 0; i < count; i++) {
+        if (cpus[i] >= 0 && cpus[i] < CPU_SETSIZE) {
+            CPU_SET(cpus[i], &cpu_set);
+        }
+    }
+
+    jack_log("JackPosixThread::AcquireAffinityImp count = %d first = %d", count, (count > 0) ? cpus[0] : -1);
+
+    if (CPU_COUNT(&cpu_set) == 0) {
+        jack_error("Cannot set CPU affinity: empty CPU set");
+        return -1;
+    }
+
+    if ((res = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set)) != 0) {
+        jack_error("Cannot set CPU affinity (%d: %s)", res, strerror(res));
+        return -1;
+    }
+    return 0;
+#else
+    jack_log("JackPosixThread::AcquireAffinityImp : CPU affinity not supported on this platform");
+    return -1;
+#endif
+}
+
+int JackPosixThread::AcquireSelfDeadline(UInt64 runtime, UInt64 deadline, UInt64 period)
+{
+#if defined(__linux__) && defined(SYS_sched_setattr)
+    struct jack_sched_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.sched_policy = SCHED_DEADLINE;
+    attr.sched_flags = SCHED_FLAG_RESET_ON_FORK;
+    attr.sched_runtime = runtime;
+    attr.sched_deadline = deadline;
+    attr.sched_period = period;
+
+    jack_log("JackPosixThread::AcquireSelfDeadline runtime = %lld deadline = %lld period = %lld",
+             (long long)runtime, (long long)deadline, (long long)period);
+
+    if (syscall(SYS_sched_setattr, 0, &attr, 0) != 0) {
+        // EBUSY means the deadline admission control refused the bandwidth
+        jack_error("Cannot use SCHED_DEADLINE scheduling (%d: %s)", errno, strerror(errno));
+        return -1;
+    }
+    return 0;
+#else
+    jack_log("JackPosixThread::AcquireSelfDeadline : SCHED_DEADLINE not supported on this platform");
+    return -1;
+#endif
+}
+
 jack_native_thread_t JackPosixThread::GetThreadID()
 {
     return fThread;
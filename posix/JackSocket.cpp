@@ -26,6 +26,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include <stdio.h>
 #include <pthread.h>
 #include <fcntl.h>
+#include <algorithm>
 
 namespace Jack
 {
@@ -41,14 +42,14 @@ static void BuildName(const char* client_name, char* res, const char* dir, int w
     }
 }
 
-JackClientSocket::JackClientSocket(): JackClientRequestInterface(), fSocket(-1), fTimeOut(0)
+JackClientSocket::JackClientSocket(): JackClientRequestInterface(), fSocket(-1), fTimeOut(0), fReadPos(0), fReadSize(0)
 {
     const char* promiscuous = getenv("JACK_PROMISCUOUS_SERVER");
     fPromiscuous = (promiscuous != NULL);
     fPromiscuousGid = jack_group2gid(promiscuous);
 }
 
-JackClientSocket::JackClientSocket(int socket): JackClientRequestInterface(), fSocket(socket),fTimeOut(0), fPromiscuous(false), fPromiscuousGid(-1)
+JackClientSocket::JackClientSocket(int socket): JackClientRequestInterface(), fSocket(socket),fTimeOut(0), fPromiscuous(false), fPromiscuousGid(-1), fReadPos(0), fReadSize(0)
 {}
 
 #if defined(__sun__) || defined(sun)
@@ -154,6 +155,7 @@ int JackClientSocket::Connect(const char* dir, const char* name, int which) // A
 int JackClientSocket::Close()
 {
     jack_log("JackClientSocket::Close");
+    fReadPos = fReadSize = 0;
     if (fSocket > 0) {
         shutdown(fSocket, SHUT_RDWR);
         close(fSocket);
@@ -164,7 +166,7 @@ int JackClientSocket::Close()
     }
 }
 
-int JackClientSocket::Read(void* data, int len)
+int JackClientSocket::ReadAux(void* data, int len)
 {
     int res;
 
@@ -193,23 +195,44 @@ int JackClientSocket::Read(void* data, int len)
     }
 #endif
 
-    if ((res = read(fSocket, data, len)) != len) {
-        if (errno == EWOULDBLOCK || errno == EAGAIN) {
+    // Returns the number of bytes actually read (at least one, up to 'len'), 0 on time out
+    if ((res = read(fSocket, data, len)) <= 0) {
+        if (res < 0 && (errno == EWOULDBLOCK || errno == EAGAIN)) {
             jack_error("JackClientSocket::Read time out");
             return 0;  // For a non blocking socket, a read failure is not considered as an error
-        } else if (res != 0) {
-            jack_error("Cannot read socket fd = %d err = %s", fSocket, strerror(errno));
-            //return 0;
-            return -1;
         } else {
             jack_error("Cannot read socket fd = %d err = %s", fSocket, strerror(errno));
             return -1;
         }
     } else {
-        return 0;
+        return res;
     }
 }
 
+int JackClientSocket::Read(void* data, int len)
+{
+    char* dst = static_cast<char*>(data);
+
+    while (len > 0) {
+        // Refill the receive buffer : a whole request or result is usually received at once
+        if (fReadPos == fReadSize) {
+            int res = ReadAux(fReadBuffer, sizeof(fReadBuffer));
+            if (res <= 0) {
+                return res;
+            }
+            fReadPos = 0;
+            fReadSize = res;
+        }
+        int size = std::min(len, fReadSize - fReadPos);
+        memcpy(dst, fReadBuffer + fReadPos, size);
+        fReadPos += size;
+        dst += size;
+        len -= size;
+    }
+
+    return 0;
+}
+
 int JackClientSocket::Write(void* data, int len)
 {
     int res;
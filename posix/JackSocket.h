@@ -47,6 +47,11 @@ class JackClientSocket : public detail::JackClientRequestInterface
         int fTimeOut;
         bool fPromiscuous;
         int fPromiscuousGid;
+        char fReadBuffer[JACK_SOCKET_BUFFER_SIZE];
+        int fReadPos;
+        int fReadSize;
+
+        int ReadAux(void* data, int len);
 
     public:
 
@@ -61,6 +66,11 @@ class JackClientSocket : public detail::JackClientRequestInterface
         {
             return fSocket;
         }
+        // True when received data is waiting in the buffer (poll will not report it)
+        bool IsReadPending()
+        {
+            return fReadPos < fReadSize;
+        }
         void SetReadTimeOut(long sec);
         void SetWriteTimeOut(long sec);
 
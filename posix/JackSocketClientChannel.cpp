@@ -21,6 +21,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackRequest.h"
 #include "JackClient.h"
 #include "JackGlobals.h"
+#include "JackTools.h"
 #include "JackError.h"
 
 namespace Jack
@@ -31,6 +32,8 @@ JackSocketClientChannel::JackSocketClientChannel()
 {
     fRequest = new JackClientSocket();
     fNotificationSocket = NULL;
+    fSharedEngine = fSharedClient = fSharedGraph = -1;
+    fOpenResult = -1;
 }
 
 JackSocketClientChannel::~JackSocketClientChannel()
@@ -55,26 +58,39 @@ int JackSocketClientChannel::Open(const char* server_name, const char* name, jac
     // OK so server is there...
     JackGlobals::fServerRunning = true;
 
-    // Check name in server
-    ClientCheck(name, uuid, name_res, JACK_PROTOCOL_VERSION, (int)options, (int*)status, &result, true);
+    // The client name is only known once checked: listen for notifications under a provisional name unique to this channel
+    char notify_name[JACK_CLIENT_NAME_SIZE+1];
+    snprintf(notify_name, sizeof(notify_name), "notify-%d-%lx", JackTools::GetPID(), (unsigned long)this);
+    if (fNotificationListenSocket.Bind(jack_client_dir, notify_name, 0) < 0) {
+        jack_error("Cannot bind socket");
+        goto error;
+    }
+
+    // The server connects to the notification socket while opening the client
+    if (Start() < 0) {
+        goto error;
+    }
+
+    // Check name and open client in a single request
+    ClientCheckOpen(name, notify_name, JackTools::GetPID(), uuid, name_res, JACK_PROTOCOL_VERSION, (int)options, (int*)status,
+                    &fSharedEngine, &fSharedClient, &fSharedGraph, &result);
+    fOpenResult = result;
     if (result < 0) {
         int status1 = *status;
         if (status1 & JackVersionError) {
             jack_error("JACK protocol mismatch %d", JACK_PROTOCOL_VERSION);
-        } else {
+        } else if (status1 & JackFailure) {
             jack_error("Client name = %s conflits with another running client", name);
+        } else {
+            jack_error("Cannot open %s client", name_res);
         }
         goto error;
     }
 
-    if (fNotificationListenSocket.Bind(jack_client_dir, name_res, 0) < 0) {
-        jack_error("Cannot bind socket");
-        goto error;
-    }
-    
     return 0;
 
 error:
+    Stop();
     fRequest->Close();
     fNotificationListenSocket.Close();
     return -1;
@@ -95,7 +111,10 @@ int JackSocketClientChannel::Start()
     /*
      To be sure notification thread is started before ClientOpen is called.
     */
-    if (fThread.StartSync() != 0) {
+    if (fThread.GetStatus() != JackThread::kIdle) {
+        // Already started by Open
+        return 0;
+    } else if (fThread.StartSync() != 0) {
         jack_error("Cannot start Jack client listener");
         return -1;
     } else {
@@ -103,6 +122,15 @@ int JackSocketClientChannel::Start()
     }
 }
 
+void JackSocketClientChannel::ClientOpen(const char* name, int pid, jack_uuid_t uuid, int* shared_engine, int* shared_client, int* shared_graph, int* result)
+{
+    // Already done by Open with the name check
+    *shared_engine = fSharedEngine;
+    *shared_client = fSharedClient;
+    *shared_graph = fSharedGraph;
+    *result = fOpenResult;
+}
+
 void JackSocketClientChannel::Stop()
 {
     jack_log("JackSocketClientChannel::Stop");
@@ -135,7 +163,9 @@ bool JackSocketClientChannel::Execute()
     JackClientNotification event;
     JackResult res;
 
-    if (event.Read(fNotificationSocket) < 0) {
+    detail::JackFramedTransaction frame(fNotificationSocket);
+
+    if (event.Read(&frame) < 0) {
         jack_error("JackSocketClientChannel read fail");
         goto error;
     }
@@ -143,7 +173,7 @@ bool JackSocketClientChannel::Execute()
     res.fResult = fClient->ClientNotify(event.fRefNum, event.fName, event.fNotify, event.fSync, event.fMessage, event.fValue1, event.fValue2);
 
     if (event.fSync) {
-        if (res.Write(fNotificationSocket) < 0) {
+        if (res.Write(&frame) < 0 || frame.Flush() < 0) {
             jack_error("JackSocketClientChannel write fail");
             goto error;
         }
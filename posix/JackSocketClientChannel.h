@@ -43,6 +43,10 @@ class JackSocketClientChannel : public JackGenericClientChannel, public JackRunn
         JackClientSocket* fNotificationSocket;      // Socket for server notification
         JackThread fThread;                         // Thread to execute the event loop
         JackClient* fClient;
+        int fSharedEngine;                          // Result of the combined check and open request
+        int fSharedClient;
+        int fSharedGraph;
+        int fOpenResult;
 
     public:
 
@@ -55,6 +59,8 @@ class JackSocketClientChannel : public JackGenericClientChannel, public JackRunn
         int Start();
         void Stop();
 
+        void ClientOpen(const char* name, int pid, jack_uuid_t uuid, int* shared_engine, int* shared_client, int* shared_graph, int* result);
+
         // JackRunnableInterface interface
         bool Init();
         bool Execute();
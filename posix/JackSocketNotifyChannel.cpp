@@ -44,16 +44,64 @@ int JackSocketNotifyChannel::Open(const char* name)
 void JackSocketNotifyChannel::Close()
 {
     jack_log("JackSocketNotifyChannel::Close");
+    fBatch.fBuffer.clear();
+    fBatchLevel = 0;
     fNotifySocket.Close();
 }
 
+// Notifications are framed one after the other : the client reads them as if they had been sent separately
+int JackSocketNotifyChannel::BatchFlush()
+{
+    if (fBatch.fBuffer.size() == 0) {
+        return 0;
+    }
+    int res = fNotifySocket.Write(&fBatch.fBuffer[0], fBatch.fBuffer.size());
+    fBatch.fBuffer.clear();
+    if (res < 0) {
+        jack_error("Could not write notifications");
+    }
+    return res;
+}
+
+void JackSocketNotifyChannel::BatchStart()
+{
+    fBatchLevel++;
+}
+
+void JackSocketNotifyChannel::BatchStop()
+{
+    if (fBatchLevel > 0 && --fBatchLevel == 0) {
+        BatchFlush();
+    }
+}
+
 void JackSocketNotifyChannel::ClientNotify(int refnum, const char* name, int notify, int sync, const char* message, int value1, int value2, int* result)
 {
     JackClientNotification event(name, refnum, notify, sync, message, value1, value2);
     JackResult res;
 
+    if (fBatchLevel > 0 && !sync) {
+        detail::JackFramedTransaction batch_frame(&fBatch);
+        if (event.Write(&batch_frame) < 0 || batch_frame.Flush() < 0) {
+            jack_error("Could not write notification");
+            *result = -1;
+            return;
+        }
+        // Keep a batch well below the socket buffer size, so that its write does not block on a busy client
+        *result = (fBatch.fBuffer.size() >= NOTIFY_BATCH_SIZE) ? BatchFlush() : 0;
+        return;
+    }
+
+    // Notifications are delivered in order : the ones waiting have to go first
+    if (BatchFlush() < 0) {
+        *result = -1;
+        return;
+    }
+
+    detail::JackFramedTransaction frame(&fNotifySocket);
+
     // Send notification
-    if (event.Write(&fNotifySocket) < 0) {
+    if (event.Write(&frame) < 0 || frame.Flush() < 0) {
         jack_error("Could not write notification");
         *result = -1;
         return;
@@ -62,7 +110,7 @@ void JackSocketNotifyChannel::ClientNotify(int refnum, const char* name, int not
     // Read the result in "synchronous" mode only
     if (sync) {
         // Get result : use a time out
-        if (res.Read(&fNotifySocket) < 0) {
+        if (res.Read(&frame) < 0) {
             jack_error("Could not read notification result");
             *result = -1;
         } else {
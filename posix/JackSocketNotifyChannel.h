@@ -22,10 +22,35 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 
 #include "JackChannel.h"
 #include "JackSocket.h"
+#include <vector>
 
 namespace Jack
 {
 
+/*!
+\brief Gathers written frames in memory, to be sent later with a single write.
+*/
+
+class JackSocketNotifyBatch : public detail::JackChannelTransactionInterface
+{
+
+    public:
+
+        std::vector<char> fBuffer;
+
+        int Read(void* data, int len)
+        {
+            return -1;
+        }
+
+        int Write(void* data, int len)
+        {
+            fBuffer.insert(fBuffer.end(), (char*)data, (char*)data + len);
+            return 0;
+        }
+
+};
+
 /*!
 \brief JackNotifyChannel using sockets.
 */
@@ -36,16 +61,23 @@ class JackSocketNotifyChannel
     private:
 
         JackClientSocket fNotifySocket;    // Socket to communicate with the server : from server to client
+        JackSocketNotifyBatch fBatch;      // Asynchronous notifications waiting to be sent
+        int fBatchLevel;                   // Nested BatchStart calls
+
+        int BatchFlush();
 
     public:
 
-        JackSocketNotifyChannel()
+        JackSocketNotifyChannel(): fBatchLevel(0)
         {}
 
         int Open(const char* name);		// Open the Server/Client connection
         void Close();					// Close the Server/Client connection
 
         void ClientNotify(int refnum, const char* name, int notify, int sync, const char* message, int value1, int value2, int* result);
+
+        void BatchStart();
+        void BatchStop();
 };
 
 } // end of namespace
@@ -125,12 +125,19 @@ int JackSocketServerChannel::GetFd(JackClientSocket* socket_aux)
     return -1;
 }
 
+static JackClientSocket* GetSocket(detail::JackChannelTransactionInterface* socket_aux)
+{
+    // Requests are decoded from a frame on the client socket
+    detail::JackFramedTransaction* frame = dynamic_cast<detail::JackFramedTransaction*>(socket_aux);
+    return dynamic_cast<JackClientSocket*>((frame) ? frame->GetChannel() : socket_aux);
+}
+
 void JackSocketServerChannel::ClientAdd(detail::JackChannelTransactionInterface* socket_aux, JackClientOpenRequest* req, JackClientOpenResult *res)
 {
     int refnum = -1;
-    res->fResult = fServer->GetEngine()->ClientExternalOpen(req->fName, req->fPID, req->fUUID, &refnum, &res->fSharedEngine, &res->fSharedClient, &res->fSharedGraph);
+    res->fResult = fServer->GetEngine()->ClientExternalOpen(req->fName, req->GetNotifyName(), req->fPID, req->fUUID, &refnum, &res->fSharedEngine, &res->fSharedClient, &res->fSharedGraph);
     if (res->fResult == 0) {
-        JackClientSocket* socket = dynamic_cast<JackClientSocket*>(socket_aux);
+        JackClientSocket* socket = GetSocket(socket_aux);
         assert(socket);
         int fd = GetFd(socket);
         assert(fd >= 0);
@@ -150,7 +157,7 @@ void JackSocketServerChannel::ClientAdd(detail::JackChannelTransactionInterface*
 
 void JackSocketServerChannel::ClientRemove(detail::JackChannelTransactionInterface* socket_aux, int refnum)
 {
-    JackClientSocket* socket = dynamic_cast<JackClientSocket*>(socket_aux);
+    JackClientSocket* socket = GetSocket(socket_aux);
     assert(socket);
     int fd = GetFd(socket);
     assert(fd >= 0);
@@ -234,16 +241,22 @@ bool JackSocketServerChannel::Execute()
                     ClientKill(fd);
                 } else if (fPollTable[i].revents & POLLIN) {
                     JackClientSocket* socket = fSocketTable[fd].second;
-                    // Decode header
-                    JackRequest header;
-                    if (header.Read(socket) < 0) {
-                        jack_log("JackSocketServerChannel::Execute : cannot decode header");
-                        ClientKill(fd);
-                    // Decode request
-                    } else {
-                        // Result is not needed here
-                        fDecoder->HandleRequest(socket, header.fType);
-                    }
+                    // Several requests may have been received at once (from the server notification channel)
+                    do {
+                        detail::JackFramedTransaction frame(socket);
+                        // Decode header
+                        JackRequest header;
+                        if (header.Read(&frame) < 0) {
+                            jack_log("JackSocketServerChannel::Execute : cannot decode header");
+                            ClientKill(fd);
+                            break;
+                        // Decode request
+                        } else if (fDecoder->HandleRequest(&frame, header.fType) < 0) {
+                            // Client has been removed
+                            break;
+                        }
+                        frame.Flush();
+                    } while (socket->IsReadPending());
                 }
             }
 
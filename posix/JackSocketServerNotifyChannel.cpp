@@ -51,7 +51,8 @@ A non blocking write operation should be used : check if write can succeed, and
 void JackSocketServerNotifyChannel::Notify(int refnum, int notify, int value)
 {
     JackClientNotificationRequest req(refnum, notify, value);
-    if (req.Write(&fRequestSocket) < 0) {
+    detail::JackFramedTransaction frame(&fRequestSocket);
+    if (req.Write(&frame) < 0 || frame.Flush() < 0) {
         jack_error("Could not write notification ref = %d notify = %d", refnum, notify);
     }
 }
@@ -0,0 +1,468 @@
+/*
+    Copyright (C) 2026
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file bench.cpp
+ *
+ * @brief Headless engine benchmark: starts a server on the dummy driver, runs a graph of
+ * synthetic clients (chain, fan or diamond) and reports the graph scheduling overhead.
+ *
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <vector>
+#include <algorithm>
+#include <jack/jack.h>
+#include <jack/control.h>
+
+enum BenchTopology { kChain, kFan, kDiamond };
+
+struct BenchClient
+{
+    jack_client_t* fClient;
+    jack_port_t* fInput;
+    jack_port_t* fOutput;
+    std::vector<int> fPreds;    // Upstream clients, empty when fed by the driver
+    std::vector<jack_time_t> fWake;     // Driver wake-up date of each measured cycle
+    std::vector<jack_time_t> fStart;
+    std::vector<jack_time_t> fEnd;
+};
+
+static std::vector<BenchClient*> gClients;
+static jack_nframes_t gPeriod = 256;
+static jack_nframes_t gRate = 48000;
+static jack_time_t gWorkUsecs = 50;
+static int gCycles = 1000;
+static volatile long gBaseCycle = -1;       // First measured cycle, -1 while warming up
+static volatile int gXRuns = 0;
+static bool gVerbose = false;
+
+static void usage()
+{
+    fprintf(stderr, "\n"
+                    "usage: jack_bench \n"
+                    "              [ --topology OR -t chain | fan | diamond ]\n"
+                    "              [ --clients OR -n number_of_clients ]\n"
+                    "              [ --work OR -w busy_work_per_client (in usecs) ]\n"
+                    "              [ --cycles OR -c measured_cycles ]\n"
+                    "              [ --period OR -p frames_per_period ]\n"
+                    "              [ --rate OR -r sample_rate ]\n"
+                    "              [ --max OR -m ] search the max sustainable client count\n"
+                    "              [ --no-realtime OR -N ]\n"
+                    "              [ --sync OR -S ]\n"
+                    "              [ --verbose OR -v ]\n"
+    );
+}
+
+static jackctl_driver_t* get_driver(jackctl_server_t* server, const char* driver_name)
+{
+    const JSList* node_ptr = jackctl_server_get_drivers_list(server);
+
+    while (node_ptr) {
+        if (strcmp(jackctl_driver_get_name((jackctl_driver_t*)node_ptr->data), driver_name) == 0) {
+            return (jackctl_driver_t*)node_ptr->data;
+        }
+        node_ptr = jack_slist_next(node_ptr);
+    }
+
+    return NULL;
+}
+
+static void set_parameter(const JSList* parameters, const char* name, jackctl_parameter_value value)
+{
+    while (parameters) {
+        jackctl_parameter_t* parameter = (jackctl_parameter_t*)parameters->data;
+        if (strcmp(jackctl_parameter_get_name(parameter), name) == 0) {
+            jackctl_parameter_set_value(parameter, &value);
+            return;
+        }
+        parameters = jack_slist_next(parameters);
+    }
+    fprintf(stderr, "Unknown parameter %s\n", name);
+}
+
+static int xrun(void* arg)
+{
+    if (gBaseCycle >= 0) {
+        gXRuns++;
+    }
+    return 0;
+}
+
+static int process(jack_nframes_t nframes, void* arg)
+{
+    BenchClient* bench = (BenchClient*)arg;
+    jack_time_t start = jack_get_time();
+
+    jack_default_audio_sample_t* in = (jack_default_audio_sample_t*)jack_port_get_buffer(bench->fInput, nframes);
+    jack_default_audio_sample_t* out = (jack_default_audio_sample_t*)jack_port_get_buffer(bench->fOutput, nframes);
+    memcpy(out, in, sizeof(jack_default_audio_sample_t) * nframes);
+
+    // Synthetic load
+    while (jack_get_time() - start < gWorkUsecs) {}
+
+    long cycle = long(jack_last_frame_time(bench->fClient) / gPeriod) - gBaseCycle;
+    if (gBaseCycle >= 0 && cycle >= 0 && cycle < gCycles) {
+        jack_nframes_t current_frames;
+        jack_time_t current_usecs;
+        jack_time_t next_usecs;
+        float period_usecs;
+        jack_get_cycle_times(bench->fClient, &current_frames, &current_usecs, &next_usecs, &period_usecs);
+        bench->fWake[cycle] = current_usecs;
+        bench->fStart[cycle] = start;
+        bench->fEnd[cycle] = jack_get_time();
+    }
+    return 0;
+}
+
+static void close_clients()
+{
+    for (size_t i = 0; i < gClients.size(); i++) {
+        jack_client_close(gClients[i]->fClient);
+        delete gClients[i];
+    }
+    gClients.clear();
+}
+
+/*
+Clients are created in topological order so that predecessors always have a lower index.
+*/
+static bool open_clients(BenchTopology topology, int count)
+{
+    char name[64];
+
+    for (int i = 0; i < count; i++) {
+        BenchClient* bench = new BenchClient();
+        snprintf(name, sizeof(name), "bench-%d", i);
+        if ((bench->fClient = jack_client_open(name, JackNullOption, NULL)) == NULL) {
+            fprintf(stderr, "Cannot open client %s\n", name);
+            delete bench;
+            return false;
+        }
+        gClients.push_back(bench);
+        bench->fInput = jack_port_register(bench->fClient, "in", JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0);
+        bench->fOutput = jack_port_register(bench->fClient, "out", JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
+        if (!bench->fInput || !bench->fOutput) {
+            fprintf(stderr, "Cannot register ports of %s\n", name);
+            return false;
+        }
+        bench->fWake.assign(gCycles, 0);
+        bench->fStart.assign(gCycles, 0);
+        bench->fEnd.assign(gCycles, 0);
+
+        switch (topology) {
+            case kChain:
+                if (i > 0) {
+                    bench->fPreds.push_back(i - 1);
+                }
+                break;
+            case kFan:
+                break;
+            case kDiamond:
+                if (i > 0 && (i < count - 1 || count == 2)) {
+                    bench->fPreds.push_back(0);
+                } else if (i > 0) {
+                    for (int j = 1; j < count - 1; j++) {
+                        bench->fPreds.push_back(j);
+                    }
+                }
+                break;
+        }
+
+        jack_set_process_callback(bench->fClient, process, bench);
+        if (i == 0) {
+            jack_set_xrun_callback(bench->fClient, xrun, NULL);
+        }
+        if (jack_activate(bench->fClient) != 0) {
+            fprintf(stderr, "Cannot activate client %s\n", name);
+            return false;
+        }
+    }
+
+    // Connections: roots are fed by the driver, sinks go to the driver
+    std::vector<bool> is_pred(count, false);
+    for (int i = 0; i < count; i++) {
+        BenchClient* bench = gClients[i];
+        if (bench->fPreds.empty()) {
+            jack_connect(bench->fClient, "system:capture_1", jack_port_name(bench->fInput));
+        }
+        for (size_t j = 0; j < bench->fPreds.size(); j++) {
+            jack_connect(bench->fClient, jack_port_name(gClients[bench->fPreds[j]]->fOutput), jack_port_name(bench->fInput));
+            is_pred[bench->fPreds[j]] = true;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        if (!is_pred[i]) {
+            jack_connect(gClients[i]->fClient, jack_port_name(gClients[i]->fOutput), "system:playback_1");
+        }
+    }
+
+    return true;
+}
+
+struct BenchStats
+{
+    std::vector<double> fSpan;      // From driver wake-up to the end of the last client
+    std::vector<double> fOverhead;  // Span minus the critical path of measured client work
+    std::vector<double> fHandoff;   // From the end of the last predecessor (or wake-up) to the start of a client
+};
+
+static double percentile(std::vector<double>& values, double p)
+{
+    if (values.empty()) {
+        return 0.;
+    }
+    size_t index = std::min(values.size() - 1, size_t(p * values.size() / 100.));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static bool run(BenchTopology topology, int count, BenchStats& stats)
+{
+    gXRuns = 0;
+    gBaseCycle = -1;
+
+    if (!open_clients(topology, count)) {
+        close_clients();
+        return false;
+    }
+
+    // Warm up for one second, then measure
+    usleep(1000000);
+    gBaseCycle = long(jack_frame_time(gClients[0]->fClient) / gPeriod) + 2;
+
+    jack_time_t period_usecs = (jack_time_t(gPeriod) * 1000000) / gRate;
+    useconds_t wait_usecs = useconds_t((gCycles + 4) * period_usecs) + 500000;
+    usleep(wait_usecs);
+
+    for (int cycle = 0; cycle < gCycles; cycle++) {
+        std::vector<jack_time_t> finish(count, 0);
+        jack_time_t span_end = 0;
+        jack_time_t critical = 0;
+        jack_time_t wake = gClients[0]->fWake[cycle];
+        bool complete = (wake != 0);
+
+        // Cycles where the frame time was reset by an xrun may mix several graph executions: they are skipped
+        for (int i = 0; i < count && complete; i++) {
+            if (gClients[i]->fWake[cycle] != wake || gClients[i]->fStart[cycle] < wake) {
+                complete = false;
+            }
+        }
+
+        for (int i = 0; i < count && complete; i++) {
+            BenchClient* bench = gClients[i];
+            jack_time_t ready = wake;
+            jack_time_t pred_finish = 0;
+            for (size_t j = 0; j < bench->fPreds.size(); j++) {
+                ready = std::max(ready, gClients[bench->fPreds[j]]->fEnd[cycle]);
+                pred_finish = std::max(pred_finish, finish[bench->fPreds[j]]);
+            }
+            finish[i] = pred_finish + (bench->fEnd[cycle] - bench->fStart[cycle]);
+            critical = std::max(critical, finish[i]);
+            span_end = std::max(span_end, bench->fEnd[cycle]);
+            stats.fHandoff.push_back(double(bench->fStart[cycle]) - double(ready));
+        }
+
+        if (complete) {
+            double span = double(span_end) - double(wake);
+            stats.fSpan.push_back(span);
+            stats.fOverhead.push_back(span - double(critical));
+        }
+    }
+
+    close_clients();
+    return true;
+}
+
+static void print_line(const char* name, std::vector<double>& values)
+{
+    printf("%-14s %9.1f %9.1f %9.1f %9.1f %9.1f\n", name,
+           percentile(values, 50.), percentile(values, 90.), percentile(values, 99.), percentile(values, 99.9),
+           values.empty() ? 0. : *std::max_element(values.begin(), values.end()));
+}
+
+static const char* topology_name(BenchTopology topology)
+{
+    switch (topology) {
+        case kChain: return "chain";
+        case kFan: return "fan";
+        case kDiamond: return "diamond";
+    }
+    return "";
+}
+
+int main(int argc, char* argv[])
+{
+    jackctl_server_t* server;
+    jackctl_driver_t* driver;
+    jackctl_parameter_value value;
+    BenchTopology topology = kChain;
+    int count = 8;
+    bool search_max = false;
+    bool realtime = true;
+    bool sync = false;
+    int opt, option_index;
+
+    const char* options = "t:n:w:c:p:r:mNSvh";
+    struct option long_options[] = {
+        {"topology", 1, 0, 't'},
+        {"clients", 1, 0, 'n'},
+        {"work", 1, 0, 'w'},
+        {"cycles", 1, 0, 'c'},
+        {"period", 1, 0, 'p'},
+        {"rate", 1, 0, 'r'},
+        {"max", 0, 0, 'm'},
+        {"no-realtime", 0, 0, 'N'},
+        {"sync", 0, 0, 'S'},
+        {"verbose", 0, 0, 'v'},
+        {"help", 0, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    while ((opt = getopt_long(argc, argv, options, long_options, &option_index)) != -1) {
+        switch (opt) {
+            case 't':
+                if (strcmp(optarg, "chain") == 0) {
+                    topology = kChain;
+                } else if (strcmp(optarg, "fan") == 0) {
+                    topology = kFan;
+                } else if (strcmp(optarg, "diamond") == 0) {
+                    topology = kDiamond;
+                } else {
+                    usage();
+                    return 1;
+                }
+                break;
+            case 'n':
+                count = atoi(optarg);
+                break;
+            case 'w':
+                gWorkUsecs = atoi(optarg);
+                break;
+            case 'c':
+                gCycles = atoi(optarg);
+                break;
+            case 'p':
+                gPeriod = atoi(optarg);
+                break;
+            case 'r':
+                gRate = atoi(optarg);
+                break;
+            case 'm':
+                search_max = true;
+                break;
+            case 'N':
+                realtime = false;
+                break;
+            case 'S':
+                sync = true;
+                break;
+            case 'v':
+                gVerbose = true;
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (count < 1 || gCycles < 1 || gPeriod < 1 || gRate < 1) {
+        usage();
+        return 1;
+    }
+
+    server = jackctl_server_create2(NULL, NULL, NULL);
+    if (server == NULL) {
+        fprintf(stderr, "Cannot create server\n");
+        return 1;
+    }
+
+    const JSList* parameters = jackctl_server_get_parameters(server);
+    strcpy(value.str, "bench");
+    set_parameter(parameters, "name", value);
+    value.b = realtime;
+    set_parameter(parameters, "realtime", value);
+    value.b = sync;
+    set_parameter(parameters, "sync", value);
+    value.b = gVerbose;
+    set_parameter(parameters, "verbose", value);
+
+    if ((driver = get_driver(server, "dummy")) == NULL) {
+        fprintf(stderr, "Cannot find dummy driver\n");
+        jackctl_server_destroy(server);
+        return 1;
+    }
+    value.ui = gPeriod;
+    set_parameter(jackctl_driver_get_parameters(driver), "period", value);
+    value.ui = gRate;
+    set_parameter(jackctl_driver_get_parameters(driver), "rate", value);
+
+    if (!jackctl_server_open(server, driver) || !jackctl_server_start(server)) {
+        fprintf(stderr, "Cannot start server\n");
+        jackctl_server_destroy(server);
+        return 1;
+    }
+
+    setenv("JACK_DEFAULT_SERVER", "bench", 1);
+    double period_usecs = (double(gPeriod) * 1000000.) / gRate;
+    int result = 0;
+
+    if (search_max) {
+        // Double the client count until the graph does not fit in the period anymore, then bisect
+        int good = 0, bad = 0;
+        int n = count;
+        while (bad == 0 || bad - good > 1) {
+            BenchStats stats;
+            bool ok = run(topology, n, stats) && gXRuns == 0 && !stats.fSpan.empty() && percentile(stats.fSpan, 99.) < period_usecs;
+            printf("clients = %4d : %s (xruns = %d, p99 span = %.1f usec)\n", n, ok ? "sustained" : "failed", gXRuns, percentile(stats.fSpan, 99.));
+            if (ok) {
+                good = n;
+            } else {
+                bad = n;
+            }
+            n = (bad == 0) ? n * 2 : (good + bad) / 2;
+            if (n == good) {
+                break;
+            }
+        }
+        printf("\ntopology = %s work = %ld usec period = %u frames (%.0f usec) : max sustainable clients = %d\n",
+               topology_name(topology), long(gWorkUsecs), gPeriod, period_usecs, good);
+    } else {
+        BenchStats stats;
+        if (!run(topology, count, stats)) {
+            result = 1;
+        } else {
+            printf("topology = %s clients = %d work = %ld usec period = %u frames (%.0f usec) cycles = %d measured = %d xruns = %d\n\n",
+                   topology_name(topology), count, long(gWorkUsecs), gPeriod, period_usecs, gCycles, int(stats.fSpan.size()), gXRuns);
+            printf("%-14s %9s %9s %9s %9s %9s   (usec)\n", "", "p50", "p90", "p99", "p99.9", "max");
+            print_line("cycle span", stats.fSpan);
+            print_line("overhead", stats.fOverhead);
+            print_line("handoff", stats.fHandoff);
+        }
+    }
+
+    jackctl_server_stop(server);
+    jackctl_server_close(server);
+    jackctl_server_destroy(server);
+    return result;
+}
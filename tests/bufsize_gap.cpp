@@ -0,0 +1,315 @@
+/*
+    Copyright (C) 2026
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file bufsize_gap.cpp
+ *
+ * @brief Measures the audio interruption caused by a buffer size change: starts a server on the
+ * dummy driver, runs clients that reallocate memory for the new size, either in their buffer size
+ * callback (legacy) or in their prepare callback (staged), and reports the largest interval
+ * between two process calls around the change.
+ *
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <vector>
+#include <jack/jack.h>
+#include <jack/control.h>
+
+#define MAX_DATES 100000
+
+struct GapClient
+{
+    jack_client_t* fClient;
+    char* fMemory;          // Memory used at the current buffer size
+    char* fPrepared;        // Memory allocated for the upcoming buffer size
+};
+
+static std::vector<GapClient*> gClients;
+static jack_nframes_t gPeriod = 256;
+static jack_nframes_t gNewPeriod = 1024;
+static jack_nframes_t gRate = 48000;
+static size_t gMemory = 32;      // MBytes reallocated by each client
+static jack_time_t gDates[MAX_DATES];
+static volatile int gDateCount = 0;
+static bool gVerbose = false;
+
+static void usage()
+{
+    fprintf(stderr, "\n"
+                    "usage: jack_bufsize_gap \n"
+                    "              [ --clients OR -n number_of_clients ]\n"
+                    "              [ --memory OR -m MBytes_reallocated_per_client ]\n"
+                    "              [ --period OR -p frames_per_period ]\n"
+                    "              [ --new-period OR -P new_frames_per_period ]\n"
+                    "              [ --rate OR -r sample_rate ]\n"
+                    "              [ --verbose OR -v ]\n"
+    );
+}
+
+static jackctl_driver_t* get_driver(jackctl_server_t* server, const char* driver_name)
+{
+    const JSList* node_ptr = jackctl_server_get_drivers_list(server);
+
+    while (node_ptr) {
+        if (strcmp(jackctl_driver_get_name((jackctl_driver_t*)node_ptr->data), driver_name) == 0) {
+            return (jackctl_driver_t*)node_ptr->data;
+        }
+        node_ptr = jack_slist_next(node_ptr);
+    }
+
+    return NULL;
+}
+
+static void set_parameter(const JSList* parameters, const char* name, jackctl_parameter_value value)
+{
+    while (parameters) {
+        jackctl_parameter_t* parameter = (jackctl_parameter_t*)parameters->data;
+        if (strcmp(jackctl_parameter_get_name(parameter), name) == 0) {
+            jackctl_parameter_set_value(parameter, &value);
+            return;
+        }
+        parameters = jack_slist_next(parameters);
+    }
+    fprintf(stderr, "Unknown parameter %s\n", name);
+}
+
+// Simulates the reallocation of the client internal buffers: memory is allocated and touched
+static char* allocate()
+{
+    size_t size = gMemory * 1024 * 1024;
+    char* memory = (char*)malloc(size);
+    if (memory) {
+        memset(memory, 0, size);
+    }
+    return memory;
+}
+
+static int process(jack_nframes_t nframes, void* arg)
+{
+    // Only the first client keeps the dates, all clients are activated at each cycle
+    if (arg == gClients[0] && gDateCount < MAX_DATES) {
+        gDates[gDateCount] = jack_get_time();
+        gDateCount = gDateCount + 1;
+    }
+    return 0;
+}
+
+static int buffer_size_prepare(jack_nframes_t nframes, void* arg)
+{
+    GapClient* client = (GapClient*)arg;
+    free(client->fPrepared);
+    client->fPrepared = allocate();
+    return 0;
+}
+
+static int buffer_size(jack_nframes_t nframes, void* arg)
+{
+    GapClient* client = (GapClient*)arg;
+    free(client->fMemory);
+    if (client->fPrepared) {
+        // Staged: only switch to the prepared memory
+        client->fMemory = client->fPrepared;
+        client->fPrepared = NULL;
+    } else {
+        client->fMemory = allocate();
+    }
+    return 0;
+}
+
+static void close_clients()
+{
+    for (size_t i = 0; i < gClients.size(); i++) {
+        jack_client_close(gClients[i]->fClient);
+        free(gClients[i]->fMemory);
+        free(gClients[i]->fPrepared);
+        delete gClients[i];
+    }
+    gClients.clear();
+}
+
+static bool open_clients(int count, bool staged)
+{
+    char name[64];
+
+    for (int i = 0; i < count; i++) {
+        GapClient* client = new GapClient();
+        snprintf(name, sizeof(name), "gap-%d", i);
+        if ((client->fClient = jack_client_open(name, JackNullOption, NULL)) == NULL) {
+            fprintf(stderr, "Cannot open client %s\n", name);
+            delete client;
+            return false;
+        }
+        client->fMemory = allocate();
+        client->fPrepared = NULL;
+        gClients.push_back(client);
+
+        jack_set_process_callback(client->fClient, process, client);
+        jack_set_buffer_size_callback(client->fClient, buffer_size, client);
+        if (staged) {
+            jack_set_buffer_size_prepare_callback(client->fClient, buffer_size_prepare, client);
+        }
+        if (jack_activate(client->fClient) != 0) {
+            fprintf(stderr, "Cannot activate client %s\n", name);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+Returns the largest interval between two process calls, in usecs, or -1 on failure.
+*/
+static long run(int count, bool staged, jack_nframes_t from, jack_nframes_t to)
+{
+    long gap = -1;
+
+    if (open_clients(count, staged)) {
+        if (jack_set_buffer_size(gClients[0]->fClient, from) == 0) {
+            usleep(500000);
+            gDateCount = 0;
+            usleep(200000);
+            jack_time_t request = jack_get_time();
+            if (jack_set_buffer_size(gClients[0]->fClient, to) == 0) {
+                jack_time_t done = jack_get_time();
+                usleep(500000);
+                gap = 0;
+                for (int i = 1; i < gDateCount; i++) {
+                    long interval = long(gDates[i] - gDates[i - 1]);
+                    gap = (interval > gap) ? interval : gap;
+                }
+                if (gVerbose) {
+                    printf("%s: jack_set_buffer_size took %ld usecs\n", staged ? "staged" : "legacy", long(done - request));
+                }
+            }
+        }
+    }
+
+    close_clients();
+    return gap;
+}
+
+int main(int argc, char* argv[])
+{
+    jackctl_server_t* server;
+    jackctl_driver_t* driver;
+    jackctl_parameter_value value;
+    int count = 4;
+    int option_index = 0;
+    int opt;
+    const char* options = "n:m:p:P:r:vh";
+    struct option long_options[] = {
+        {"clients", 1, 0, 'n'},
+        {"memory", 1, 0, 'm'},
+        {"period", 1, 0, 'p'},
+        {"new-period", 1, 0, 'P'},
+        {"rate", 1, 0, 'r'},
+        {"verbose", 0, 0, 'v'},
+        {"help", 0, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    while ((opt = getopt_long(argc, argv, options, long_options, &option_index)) != -1) {
+        switch (opt) {
+            case 'n':
+                count = atoi(optarg);
+                break;
+            case 'm':
+                gMemory = atoi(optarg);
+                break;
+            case 'p':
+                gPeriod = atoi(optarg);
+                break;
+            case 'P':
+                gNewPeriod = atoi(optarg);
+                break;
+            case 'r':
+                gRate = atoi(optarg);
+                break;
+            case 'v':
+                gVerbose = true;
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (count < 1 || gPeriod < 1 || gNewPeriod < 1 || gPeriod == gNewPeriod || gRate < 1) {
+        usage();
+        return 1;
+    }
+
+    server = jackctl_server_create2(NULL, NULL, NULL);
+    if (server == NULL) {
+        fprintf(stderr, "Cannot create server\n");
+        return 1;
+    }
+
+    const JSList* parameters = jackctl_server_get_parameters(server);
+    strcpy(value.str, "bufsize_gap");
+    set_parameter(parameters, "name", value);
+    value.b = gVerbose;
+    set_parameter(parameters, "verbose", value);
+
+    if ((driver = get_driver(server, "dummy")) == NULL) {
+        fprintf(stderr, "Cannot find dummy driver\n");
+        jackctl_server_destroy(server);
+        return 1;
+    }
+    value.ui = gPeriod;
+    set_parameter(jackctl_driver_get_parameters(driver), "period", value);
+    value.ui = gRate;
+    set_parameter(jackctl_driver_get_parameters(driver), "rate", value);
+
+    if (!jackctl_server_open(server, driver) || !jackctl_server_start(server)) {
+        fprintf(stderr, "Cannot start server\n");
+        jackctl_server_destroy(server);
+        return 1;
+    }
+
+    setenv("JACK_DEFAULT_SERVER", "bufsize_gap", 1);
+    long period_usecs = long((double(gPeriod) * 1000000.) / gRate);
+    long new_period_usecs = long((double(gNewPeriod) * 1000000.) / gRate);
+    long longest = (period_usecs > new_period_usecs) ? period_usecs : new_period_usecs;
+    int result = 0;
+
+    printf("clients = %d memory = %ld MBytes period = %u -> %u frames (%ld -> %ld usec)\n\n",
+           count, long(gMemory), gPeriod, gNewPeriod, period_usecs, new_period_usecs);
+
+    for (int staged = 0; staged < 2; staged++) {
+        long gap = run(count, staged, gPeriod, gNewPeriod);
+        if (gap < 0) {
+            fprintf(stderr, "Cannot change buffer size\n");
+            result = 1;
+            break;
+        }
+        printf("%-8s largest process interval = %7ld usec, interruption = %7ld usec\n",
+               staged ? "staged" : "legacy", gap, (gap > longest) ? gap - longest : 0);
+    }
+
+    jackctl_server_stop(server);
+    jackctl_server_close(server);
+    jackctl_server_destroy(server);
+    return result;
+}
@@ -0,0 +1,232 @@
+/*
+    Copyright (C) 2026
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file latency_bench.cpp
+ *
+ * @brief Latency computation benchmark: builds a chain of clients on a running server (the server
+ * needs a port maximum large enough, like jackd -p 4096), each output port of a client being
+ * connected to several input ports of the next one, then measures jack_recompute_total_latencies
+ * (latency ranges and callbacks) and jack_port_get_total_latency on all ports.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+#include <string>
+#include <jack/jack.h>
+
+static int gClients = 8;
+static int gPorts = 256;
+static int gFanOut = 2;
+static int gCallbacks = 4;
+static int gLoops = 20;
+static jack_nframes_t gInternalLatency = 64;
+static volatile int gLatencyCallbacks = 0;
+
+struct BenchClient
+{
+    jack_client_t* fClient;
+    std::vector<jack_port_t*> fInputs;
+    std::vector<jack_port_t*> fOutputs;
+};
+
+static void usage()
+{
+    fprintf(stderr, "\n"
+                    "usage: jack_latency_bench \n"
+                    "              [ --clients OR -c number_of_clients ]\n"
+                    "              [ --ports OR -p input_and_output_ports_per_client ]\n"
+                    "              [ --fan-out OR -f connections_per_output_port ]\n"
+                    "              [ --callbacks OR -l clients_with_a_latency_callback ]\n"
+                    "              [ --loops OR -n number_of_computations ]\n"
+    );
+}
+
+// jack_get_time() needs an open client
+static double now_usecs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) * 1000000. + double(ts.tv_nsec) / 1000.;
+}
+
+static int process(jack_nframes_t nframes, void* arg)
+{
+    return 0;
+}
+
+// A client with an internal latency, like a plugin host
+static void latency(jack_latency_callback_mode_t mode, void* arg)
+{
+    BenchClient* client = (BenchClient*)arg;
+    std::vector<jack_port_t*>& from = (mode == JackCaptureLatency) ? client->fInputs : client->fOutputs;
+    std::vector<jack_port_t*>& to = (mode == JackCaptureLatency) ? client->fOutputs : client->fInputs;
+    jack_latency_range_t range = { 0, 0 };
+
+    gLatencyCallbacks++;
+    for (size_t i = 0; i < from.size(); i++) {
+        jack_latency_range_t other;
+        jack_port_get_latency_range(from[i], mode, &other);
+        range.min = (i == 0 || other.min < range.min) ? other.min : range.min;
+        range.max = (other.max > range.max) ? other.max : range.max;
+    }
+    range.min += gInternalLatency;
+    range.max += gInternalLatency;
+    for (size_t i = 0; i < to.size(); i++) {
+        jack_port_set_latency_range(to[i], mode, &range);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int option_index = 0;
+    int opt;
+    const char* options = "c:p:f:l:n:h";
+    struct option long_options[] = {
+        {"clients", 1, 0, 'c'},
+        {"ports", 1, 0, 'p'},
+        {"fan-out", 1, 0, 'f'},
+        {"callbacks", 1, 0, 'l'},
+        {"loops", 1, 0, 'n'},
+        {"help", 0, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    while ((opt = getopt_long(argc, argv, options, long_options, &option_index)) != -1) {
+        switch (opt) {
+            case 'c':
+                gClients = atoi(optarg);
+                break;
+            case 'p':
+                gPorts = atoi(optarg);
+                break;
+            case 'f':
+                gFanOut = atoi(optarg);
+                break;
+            case 'l':
+                gCallbacks = atoi(optarg);
+                break;
+            case 'n':
+                gLoops = atoi(optarg);
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (gClients < 1 || gPorts < 1 || gFanOut < 0 || gFanOut > gPorts || gCallbacks < 0 || gLoops < 1) {
+        usage();
+        return 1;
+    }
+
+    std::vector<BenchClient> clients(gClients);
+    std::vector<std::string> port_names(gPorts);
+    std::vector<const char*> names(gPorts);
+
+    for (int c = 0; c < gClients; c++) {
+        char name[64];
+        snprintf(name, sizeof(name), "latency-%d", c);
+        clients[c].fClient = jack_client_open(name, JackNoStartServer, NULL);
+        if (!clients[c].fClient) {
+            fprintf(stderr, "Cannot open client, is the server running?\n");
+            return 1;
+        }
+        clients[c].fInputs.resize(gPorts);
+        clients[c].fOutputs.resize(gPorts);
+        for (int d = 0; d < 2; d++) {
+            for (int p = 0; p < gPorts; p++) {
+                snprintf(name, sizeof(name), "%s%d", (d == 0) ? "in" : "out", p);
+                port_names[p] = name;
+                names[p] = port_names[p].c_str();
+            }
+            if (jack_port_register_many(clients[c].fClient, &names[0], JACK_DEFAULT_AUDIO_TYPE,
+                                        (d == 0) ? JackPortIsInput : JackPortIsOutput, 0,
+                                        (d == 0) ? &clients[c].fInputs[0] : &clients[c].fOutputs[0], gPorts) != 0) {
+                fprintf(stderr, "Cannot register ports, is the server port maximum large enough?\n");
+                return 1;
+            }
+        }
+        // Only real time clients are part of the graph order
+        jack_set_process_callback(clients[c].fClient, process, NULL);
+        if (c < gCallbacks) {
+            jack_set_latency_callback(clients[c].fClient, latency, &clients[c]);
+        }
+        if (jack_activate(clients[c].fClient) != 0) {
+            fprintf(stderr, "Cannot activate client\n");
+            return 1;
+        }
+    }
+
+    // Output port p of a client feeds inputs p .. p + fan_out - 1 of the next one
+    for (int c = 0; c + 1 < gClients; c++) {
+        for (int p = 0; p < gPorts; p++) {
+            for (int f = 0; f < gFanOut; f++) {
+                jack_connect(clients[c].fClient, jack_port_name(clients[c].fOutputs[p]),
+                             jack_port_name(clients[c + 1].fInputs[(p + f) % gPorts]));
+            }
+        }
+    }
+
+    // Let the graph changes settle
+    usleep(500000);
+
+    jack_client_t* client = clients[0].fClient;
+    double start = now_usecs();
+    gLatencyCallbacks = 0;
+    for (int i = 0; i < gLoops; i++) {
+        jack_recompute_total_latencies(client);
+    }
+    double ranges = (now_usecs() - start) / gLoops;
+    int callbacks = gLatencyCallbacks;
+
+    start = now_usecs();
+    jack_nframes_t max_latency = 0;
+    for (int c = 0; c < gClients; c++) {
+        for (int p = 0; p < gPorts; p++) {
+            // jack_port_get_total_latency is deprecated, its cost is measured on purpose
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+            jack_nframes_t in_latency = jack_port_get_total_latency(client, clients[c].fInputs[p]);
+            jack_nframes_t out_latency = jack_port_get_total_latency(client, clients[c].fOutputs[p]);
+#pragma GCC diagnostic pop
+            max_latency = (in_latency > max_latency) ? in_latency : max_latency;
+            max_latency = (out_latency > max_latency) ? out_latency : max_latency;
+        }
+    }
+    double total = now_usecs() - start;
+
+    jack_latency_range_t range;
+    jack_port_get_latency_range(clients[gClients - 1].fOutputs[0], JackCaptureLatency, &range);
+
+    printf("clients = %d ports = %d fan-out = %d latency callbacks = %d\n\n", gClients, 2 * gClients * gPorts, gFanOut, gCallbacks);
+    printf("jack_recompute_total_latencies       %10.1f usec  (%.1f latency callbacks)\n", ranges, double(callbacks) / gLoops);
+    printf("jack_port_get_total_latency, all     %10.1f usec\n", total);
+    printf("\nlast client capture latency = [%u %u], max total latency = %u\n", range.min, range.max, max_latency);
+
+    for (int c = 0; c < gClients; c++) {
+        jack_client_close(clients[c].fClient);
+    }
+    return 0;
+}
@@ -0,0 +1,216 @@
+/*
+    Copyright (C) 2026
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file open_bench.cpp
+ *
+ * @brief Client life cycle benchmark: opens, activates and closes short lived clients on a
+ * running server, the way analysis hosts do, and reports the duration of each step and the
+ * number of complete cycles per second. Ports are registered one by one, or all at once with
+ * jack_port_register_many.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <jack/jack.h>
+
+static int gCount = 200;
+static int gPorts = 2;
+static int gResident = 0;
+static bool gActivate = true;
+static bool gMany = false;
+static volatile int gRegistrations = 0;
+
+static void usage()
+{
+    fprintf(stderr, "\n"
+                    "usage: jack_open_bench \n"
+                    "              [ --count OR -n number_of_clients ]\n"
+                    "              [ --ports OR -p ports_per_client ]\n"
+                    "              [ --resident OR -r clients_kept_open_meanwhile ]\n"
+                    "              [ --no-activate OR -A ]\n"
+                    "              [ --many OR -m ] (register all ports at once)\n"
+    );
+}
+
+// jack_get_time() needs an open client
+static double now_usecs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) * 1000000. + double(ts.tv_nsec) / 1000.;
+}
+
+static int process(jack_nframes_t nframes, void* arg)
+{
+    return 0;
+}
+
+// Resident clients are notified of each port of each new client
+static void port_registration(jack_port_id_t port, int onoff, void* arg)
+{
+    gRegistrations++;
+}
+
+static void report(const char* name, std::vector<double>& values)
+{
+    if (values.size() == 0) {
+        return;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0.;
+    for (size_t i = 0; i < values.size(); i++) {
+        sum += values[i];
+    }
+    printf("%-12s mean = %9.1f usec  median = %9.1f usec  max = %9.1f usec\n",
+           name, sum / values.size(), values[values.size() / 2], values.back());
+}
+
+int main(int argc, char* argv[])
+{
+    int option_index = 0;
+    int opt;
+    const char* options = "n:p:r:Amh";
+    struct option long_options[] = {
+        {"count", 1, 0, 'n'},
+        {"ports", 1, 0, 'p'},
+        {"resident", 1, 0, 'r'},
+        {"no-activate", 0, 0, 'A'},
+        {"many", 0, 0, 'm'},
+        {"help", 0, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    while ((opt = getopt_long(argc, argv, options, long_options, &option_index)) != -1) {
+        switch (opt) {
+            case 'n':
+                gCount = atoi(optarg);
+                break;
+            case 'p':
+                gPorts = atoi(optarg);
+                break;
+            case 'r':
+                gResident = atoi(optarg);
+                break;
+            case 'A':
+                gActivate = false;
+                break;
+            case 'm':
+                gMany = true;
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (gCount < 1 || gPorts < 0 || gResident < 0) {
+        usage();
+        return 1;
+    }
+
+    // Clients that stay open, they are notified of each new client
+    std::vector<jack_client_t*> resident;
+    for (int i = 0; i < gResident; i++) {
+        char name[64];
+        snprintf(name, sizeof(name), "resident-%d", i);
+        jack_client_t* client = jack_client_open(name, JackNoStartServer, NULL);
+        if (!client) {
+            fprintf(stderr, "Cannot open client, is the server running?\n");
+            return 1;
+        }
+        jack_set_process_callback(client, process, NULL);
+        jack_set_port_registration_callback(client, port_registration, NULL);
+        jack_activate(client);
+        resident.push_back(client);
+    }
+
+    std::vector<double> open_times, register_times, activate_times, close_times;
+    std::vector<std::string> port_names(gPorts);
+    std::vector<const char*> names(gPorts);
+    std::vector<jack_port_t*> ports(gPorts);
+    for (int p = 0; p < gPorts; p++) {
+        char name[64];
+        snprintf(name, sizeof(name), "in%d", p);
+        port_names[p] = name;
+        names[p] = port_names[p].c_str();
+    }
+    double start = now_usecs();
+
+    for (int i = 0; i < gCount; i++) {
+        double t0 = now_usecs();
+        jack_client_t* client = jack_client_open("open_bench", JackNoStartServer, NULL);
+        if (!client) {
+            fprintf(stderr, "Cannot open client, is the server running?\n");
+            return 1;
+        }
+        double t1 = now_usecs();
+        open_times.push_back(t1 - t0);
+
+        t0 = now_usecs();
+        if (gMany) {
+            if (gPorts > 0 && jack_port_register_many(client, &names[0], JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0, &ports[0], gPorts) != 0) {
+                fprintf(stderr, "Cannot register ports\n");
+                return 1;
+            }
+        } else {
+            for (int p = 0; p < gPorts; p++) {
+                if (!(ports[p] = jack_port_register(client, names[p], JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0))) {
+                    fprintf(stderr, "Cannot register port\n");
+                    return 1;
+                }
+            }
+        }
+        register_times.push_back(now_usecs() - t0);
+
+        if (gActivate) {
+            jack_set_process_callback(client, process, NULL);
+            t0 = now_usecs();
+            jack_activate(client);
+            activate_times.push_back(now_usecs() - t0);
+        }
+
+        t0 = now_usecs();
+        jack_client_close(client);
+        close_times.push_back(now_usecs() - t0);
+    }
+
+    double duration = now_usecs() - start;
+
+    printf("clients = %d ports = %d resident = %d%s\n\n", gCount, gPorts, gResident, (gMany) ? " (ports registered at once)" : "");
+    report("open", open_times);
+    report("register", register_times);
+    report("activate", activate_times);
+    report("close", close_times);
+    printf("\n%.1f clients per second\n", (gCount * 1000000.) / duration);
+    if (gResident > 0) {
+        printf("%d port registration callbacks received by resident clients\n", gRegistrations);
+    }
+
+    for (size_t i = 0; i < resident.size(); i++) {
+        jack_client_close(resident[i]);
+    }
+    return 0;
+}
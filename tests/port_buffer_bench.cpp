@@ -0,0 +1,201 @@
+/*
+    Copyright (C) 2026
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file port_buffer_bench.cpp
+ *
+ * @brief jack_port_get_buffer benchmark: a source client feeds a sink client whose input ports
+ * have one connection, two connections (mixed) or none, and the sink calls jack_port_get_buffer
+ * several times per cycle on each of them, like plugin hosts do. Reports the cost of the first
+ * and of the following calls for each kind of input, and checks the buffer contents.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+#include <jack/jack.h>
+
+enum InputKind { kSingle, kMixed, kSilent, kKinds };
+
+static int gPorts = 64;
+static int gCalls = 4;
+static int gCycles = 1000;
+
+static std::vector<jack_port_t*> gOutputs;
+static std::vector<jack_port_t*> gInputs[kKinds];
+static double gFirstTime[kKinds];
+static double gNextTime[kKinds];
+static volatile int gCycle = 0;
+static int gErrors = 0;
+
+static void usage()
+{
+    fprintf(stderr, "\n"
+                    "usage: jack_port_buffer_bench \n"
+                    "              [ --ports OR -p input_ports_of_each_kind ]\n"
+                    "              [ --calls OR -r calls_per_port_and_cycle ]\n"
+                    "              [ --cycles OR -n number_of_cycles ]\n"
+    );
+}
+
+// jack_get_time() resolution is the microsecond
+static double now_nsecs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) * 1000000000. + double(ts.tv_nsec);
+}
+
+static int source_process(jack_nframes_t nframes, void* arg)
+{
+    for (size_t i = 0; i < gOutputs.size(); i++) {
+        jack_default_audio_sample_t* buffer = (jack_default_audio_sample_t*)jack_port_get_buffer(gOutputs[i], nframes);
+        for (jack_nframes_t j = 0; j < nframes; j++) {
+            buffer[j] = 1.f;
+        }
+    }
+    return 0;
+}
+
+static int sink_process(jack_nframes_t nframes, void* arg)
+{
+    // Skip the first cycles, the graph may not be complete yet
+    if (gCycle++ < 8 || gCycle > gCycles + 8) {
+        return 0;
+    }
+
+    const jack_default_audio_sample_t expected[kKinds] = { 1.f, 2.f, 0.f };
+
+    for (int kind = kSingle; kind < kKinds; kind++) {
+        for (int call = 0; call < gCalls; call++) {
+            double start = now_nsecs();
+            for (int i = 0; i < gPorts; i++) {
+                jack_default_audio_sample_t* buffer = (jack_default_audio_sample_t*)jack_port_get_buffer(gInputs[kind][i], nframes);
+                if (buffer[nframes - 1] != expected[kind]) {
+                    gErrors++;
+                }
+            }
+            double duration = now_nsecs() - start;
+            if (call == 0) {
+                gFirstTime[kind] += duration;
+            } else {
+                gNextTime[kind] += duration;
+            }
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    int option_index = 0;
+    int opt;
+    const char* options = "p:r:n:h";
+    struct option long_options[] = {
+        {"ports", 1, 0, 'p'},
+        {"calls", 1, 0, 'r'},
+        {"cycles", 1, 0, 'n'},
+        {"help", 0, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    while ((opt = getopt_long(argc, argv, options, long_options, &option_index)) != -1) {
+        switch (opt) {
+            case 'p':
+                gPorts = atoi(optarg);
+                break;
+            case 'r':
+                gCalls = atoi(optarg);
+                break;
+            case 'n':
+                gCycles = atoi(optarg);
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (gPorts < 1 || gCalls < 1 || gCycles < 1) {
+        usage();
+        return 1;
+    }
+
+    jack_client_t* source = jack_client_open("buffer-source", JackNoStartServer, NULL);
+    jack_client_t* sink = jack_client_open("buffer-sink", JackNoStartServer, NULL);
+    if (!source || !sink) {
+        fprintf(stderr, "Cannot open client, is the server running?\n");
+        return 1;
+    }
+
+    const char* kind_names[kKinds] = { "single", "mixed", "silent" };
+    char name[64];
+
+    for (int i = 0; i < 2 * gPorts; i++) {
+        snprintf(name, sizeof(name), "out%d", i);
+        gOutputs.push_back(jack_port_register(source, name, JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0));
+    }
+    for (int kind = kSingle; kind < kKinds; kind++) {
+        for (int i = 0; i < gPorts; i++) {
+            snprintf(name, sizeof(name), "%s%d", kind_names[kind], i);
+            gInputs[kind].push_back(jack_port_register(sink, name, JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0));
+        }
+    }
+
+    jack_set_process_callback(source, source_process, NULL);
+    jack_set_process_callback(sink, sink_process, NULL);
+    if (jack_activate(source) != 0 || jack_activate(sink) != 0) {
+        fprintf(stderr, "Cannot activate clients\n");
+        return 1;
+    }
+
+    for (int i = 0; i < gPorts; i++) {
+        jack_connect(source, jack_port_name(gOutputs[i]), jack_port_name(gInputs[kSingle][i]));
+        jack_connect(source, jack_port_name(gOutputs[i]), jack_port_name(gInputs[kMixed][i]));
+        jack_connect(source, jack_port_name(gOutputs[gPorts + i]), jack_port_name(gInputs[kMixed][i]));
+    }
+
+    // The sink counts the cycles from the connection
+    gCycle = 0;
+    while (gCycle <= gCycles + 8) {
+        usleep(10000);
+    }
+
+    jack_deactivate(sink);
+    jack_deactivate(source);
+
+    printf("ports = %d calls = %d cycles = %d buffer size = %u\n\n", gPorts, gCalls, gCycles, jack_get_buffer_size(sink));
+    printf("%-10s %16s %16s\n", "input", "first call", "next calls");
+    for (int kind = kSingle; kind < kKinds; kind++) {
+        double first = gFirstTime[kind] / (double(gCycles) * gPorts);
+        double next = (gCalls > 1) ? gNextTime[kind] / (double(gCycles) * gPorts * (gCalls - 1)) : 0.;
+        printf("%-10s %11.1f nsec %11.1f nsec\n", kind_names[kind], first, next);
+    }
+    if (gErrors > 0) {
+        printf("\n%d buffers with unexpected contents\n", gErrors);
+    }
+
+    jack_client_close(sink);
+    jack_client_close(source);
+    return (gErrors > 0) ? 1 : 0;
+}
@@ -0,0 +1,312 @@
+/*
+    Copyright (C) 2026
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file ringbuffer_bench.cpp
+ *
+ * @brief Ringbuffer throughput benchmark: a producer thread pushes periods of deinterleaved
+ * channels the way a process callback does, a consumer thread pulls interleaved blocks the way
+ * a disk writer does, through jack_ringbuffer_t (one write per sample or one per period), through
+ * a mirrored jack_ringbuffer_t read in place, and through jack_frame_ringbuffer_t.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <vector>
+#include <jack/jack.h>
+#include <jack/ringbuffer.h>
+
+enum BenchMode { kSample, kPeriod, kMirrored, kFrame };
+
+static unsigned int gChannels = 2;
+static size_t gPeriod = 256;
+static size_t gBlock = 4096;
+static size_t gCapacity = 65536;
+static size_t gFrames = 20000000;
+static int gProducerCPU = -1;
+static int gConsumerCPU = -1;
+
+struct BenchContext
+{
+    BenchMode fMode;
+    jack_ringbuffer_t* fRing;
+    jack_frame_ringbuffer_t* fFrameRing;
+    double fChecksum;
+};
+
+static void usage()
+{
+    fprintf(stderr, "\n"
+                    "usage: jack_ringbuffer_bench \n"
+                    "              [ --channels OR -c channels ]\n"
+                    "              [ --period OR -p frames_per_write ]\n"
+                    "              [ --block OR -b frames_per_read ]\n"
+                    "              [ --capacity OR -s ringbuffer_capacity_in_frames ]\n"
+                    "              [ --frames OR -n frames_to_transfer ]\n"
+                    "              [ --producer-cpu OR -P cpu ]\n"
+                    "              [ --consumer-cpu OR -C cpu ]\n"
+    );
+}
+
+// jack_get_time() needs an open client
+static double now_usecs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) * 1000000. + double(ts.tv_nsec) / 1000.;
+}
+
+static void pin(int cpu)
+{
+#ifdef __linux__
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            fprintf(stderr, "Cannot pin thread on CPU %d\n", cpu);
+        }
+    }
+#endif
+}
+
+static void* producer(void* arg)
+{
+    BenchContext* context = (BenchContext*)arg;
+    std::vector<std::vector<float> > channels(gChannels, std::vector<float>(gPeriod));
+    std::vector<const float*> pointers(gChannels);
+    std::vector<float> interleaved(gPeriod * gChannels);
+    size_t frame_size = gChannels * sizeof(float);
+
+    pin(gProducerCPU);
+    for (unsigned int c = 0; c < gChannels; c++) {
+        pointers[c] = &channels[c][0];
+    }
+
+    for (size_t sent = 0; sent < gFrames; sent += gPeriod) {
+        // New "port buffers"
+        for (unsigned int c = 0; c < gChannels; c++) {
+            for (size_t i = 0; i < gPeriod; i++) {
+                channels[c][i] = float(sent + i) + c;
+            }
+        }
+
+        switch (context->fMode) {
+
+            case kSample:
+                // What capture_client.c does
+                while (jack_ringbuffer_write_space(context->fRing) < gPeriod * frame_size) {
+                    sched_yield();
+                }
+                for (size_t i = 0; i < gPeriod; i++) {
+                    for (unsigned int c = 0; c < gChannels; c++) {
+                        jack_ringbuffer_write(context->fRing, (const char*)&channels[c][i], sizeof(float));
+                    }
+                }
+                break;
+
+            case kPeriod:
+            case kMirrored:
+                for (size_t i = 0; i < gPeriod; i++) {
+                    for (unsigned int c = 0; c < gChannels; c++) {
+                        interleaved[i * gChannels + c] = channels[c][i];
+                    }
+                }
+                while (jack_ringbuffer_write_space(context->fRing) < gPeriod * frame_size) {
+                    sched_yield();
+                }
+                jack_ringbuffer_write(context->fRing, (const char*)&interleaved[0], gPeriod * frame_size);
+                break;
+
+            case kFrame:
+                while (jack_frame_ringbuffer_write_space(context->fFrameRing) < gPeriod) {
+                    sched_yield();
+                }
+                jack_frame_ringbuffer_write(context->fFrameRing, &pointers[0], gPeriod);
+                break;
+        }
+    }
+
+    return NULL;
+}
+
+static void* consumer(void* arg)
+{
+    BenchContext* context = (BenchContext*)arg;
+    std::vector<float> block(gBlock * gChannels);
+    size_t frame_size = gChannels * sizeof(float);
+    size_t received = 0;
+    double checksum = 0.;
+
+    pin(gConsumerCPU);
+
+    while (received < gFrames) {
+        size_t frames;
+        const float* data = &block[0];
+        if (context->fMode == kFrame) {
+            frames = jack_frame_ringbuffer_read_interleaved(context->fFrameRing, &block[0], gBlock);
+        } else if (context->fMode == kMirrored) {
+            // Zero copy: the readable data is one segment
+            jack_ringbuffer_data_t vec[2];
+            jack_ringbuffer_get_read_vector(context->fRing, vec);
+            frames = vec[0].len / frame_size;
+            frames = (frames < gBlock) ? frames : gBlock;
+            data = (const float*)vec[0].buf;
+        } else {
+            // Whole frames only
+            frames = jack_ringbuffer_read_space(context->fRing) / frame_size;
+            frames = (frames < gBlock) ? frames : gBlock;
+            jack_ringbuffer_read(context->fRing, (char*)&block[0], frames * frame_size);
+        }
+        if (frames == 0) {
+            sched_yield();
+        } else {
+            // Read the data like a file writer would, the sum of the first channel checks the transfer
+            for (size_t i = 0; i < frames; i++) {
+                checksum += data[i * gChannels];
+            }
+            if (context->fMode == kMirrored) {
+                jack_ringbuffer_read_advance(context->fRing, frames * frame_size);
+            }
+            received += frames;
+        }
+    }
+
+    context->fChecksum = checksum;
+    return NULL;
+}
+
+static double run(BenchMode mode, double* checksum)
+{
+    BenchContext context;
+    pthread_t threads[2];
+
+    context.fMode = mode;
+    if (mode == kMirrored) {
+        context.fRing = jack_ringbuffer_create_mirrored(gCapacity * gChannels * sizeof(float));
+        if (!context.fRing) {
+            return -1.;
+        }
+    } else {
+        context.fRing = jack_ringbuffer_create(gCapacity * gChannels * sizeof(float));
+    }
+    context.fFrameRing = jack_frame_ringbuffer_create(gChannels, gCapacity);
+    context.fChecksum = 0.;
+
+    double start = now_usecs();
+    pthread_create(&threads[1], NULL, consumer, &context);
+    pthread_create(&threads[0], NULL, producer, &context);
+    pthread_join(threads[0], NULL);
+    pthread_join(threads[1], NULL);
+    double duration = now_usecs() - start;
+
+    jack_ringbuffer_free(context.fRing);
+    jack_frame_ringbuffer_free(context.fFrameRing);
+    *checksum = context.fChecksum;
+    return duration;
+}
+
+int main(int argc, char* argv[])
+{
+    int option_index = 0;
+    int opt;
+    const char* options = "c:p:b:s:n:P:C:h";
+    struct option long_options[] = {
+        {"channels", 1, 0, 'c'},
+        {"period", 1, 0, 'p'},
+        {"block", 1, 0, 'b'},
+        {"capacity", 1, 0, 's'},
+        {"frames", 1, 0, 'n'},
+        {"producer-cpu", 1, 0, 'P'},
+        {"consumer-cpu", 1, 0, 'C'},
+        {"help", 0, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    while ((opt = getopt_long(argc, argv, options, long_options, &option_index)) != -1) {
+        switch (opt) {
+            case 'c':
+                gChannels = atoi(optarg);
+                break;
+            case 'p':
+                gPeriod = atol(optarg);
+                break;
+            case 'b':
+                gBlock = atol(optarg);
+                break;
+            case 's':
+                gCapacity = atol(optarg);
+                break;
+            case 'n':
+                gFrames = atol(optarg);
+                break;
+            case 'P':
+                gProducerCPU = atoi(optarg);
+                break;
+            case 'C':
+                gConsumerCPU = atoi(optarg);
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (gChannels < 1 || gPeriod < 1 || gBlock < 1 || gCapacity < 2 * gPeriod || gFrames < gPeriod) {
+        usage();
+        return 1;
+    }
+
+    // Whole periods only
+    gFrames -= gFrames % gPeriod;
+
+    printf("channels = %u period = %ld block = %ld capacity = %ld frames = %ld\n\n",
+           gChannels, long(gPeriod), long(gBlock), long(gCapacity), long(gFrames));
+    printf("%-30s %10s %12s\n", "", "MB/s", "Mframes/s");
+
+    const char* names[] = { "jack_ringbuffer per sample", "jack_ringbuffer per period",
+                            "jack_ringbuffer mirrored", "jack_frame_ringbuffer" };
+    double reference = 0.;
+    int result = 0;
+
+    for (int mode = kSample; mode <= kFrame; mode++) {
+        double checksum;
+        double usecs = run(BenchMode(mode), &checksum);
+        if (usecs < 0.) {
+            printf("%-30s %10s\n", names[mode], "unavailable");
+            continue;
+        }
+        if (mode == kSample) {
+            reference = checksum;
+        } else if (checksum != reference) {
+            fprintf(stderr, "%s: transferred data differs\n", names[mode]);
+            result = 1;
+        }
+        printf("%-30s %10.1f %12.2f\n", names[mode],
+               (double(gFrames) * gChannels * sizeof(float)) / usecs,
+               double(gFrames) / usecs);
+    }
+
+    return result;
+}
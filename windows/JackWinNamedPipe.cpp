@@ -22,6 +22,7 @@
 #include "JackError.h"
 #include <assert.h>
 #include <stdio.h>
+#include <algorithm>
 
 #define BUFSIZE 4096
 
@@ -30,14 +31,27 @@ namespace Jack
 
 int JackWinNamedPipeAux::ReadAux(void* data, int len)
 {
-    DWORD read;
-    BOOL res = ReadFile(fNamedPipe, data, len, &read, NULL);
-    if (res && read == (DWORD)len) {
-        return 0;
-    } else {
-        jack_log("Cannot read named pipe name = %s err = %ld", fName, GetLastError());
-        return -1;
+    char* dst = (char*)data;
+    while (len > 0) {
+        if (fReadPos == fReadSize) {
+            DWORD read;
+            BOOL res = ReadFile(fNamedPipe, fReadBuffer, sizeof(fReadBuffer), &read, NULL);
+            // ERROR_MORE_DATA : the message is bigger than the buffer, the next ReadFile returns the remaining part
+            if ((!res && GetLastError() != ERROR_MORE_DATA) || read == 0) {
+                jack_log("Cannot read named pipe name = %s err = %ld", fName, GetLastError());
+                fReadPos = fReadSize = 0;
+                return -1;
+            }
+            fReadPos = 0;
+            fReadSize = read;
+        }
+        int size = std::min(len, fReadSize - fReadPos);
+        memcpy(dst, fReadBuffer + fReadPos, size);
+        fReadPos += size;
+        dst += size;
+        len -= size;
     }
+    return 0;
 }
 
 int JackWinNamedPipeAux::WriteAux(void* data, int len)
@@ -127,6 +141,7 @@ int JackWinNamedPipeClient::Connect(const char* dir, const char* name, int which
 
 int JackWinNamedPipeClient::Close()
 {
+    fReadPos = fReadSize = 0;
     if (fNamedPipe != INVALID_HANDLE_VALUE) {
         CloseHandle(fNamedPipe);
         fNamedPipe = INVALID_HANDLE_VALUE;
@@ -345,6 +360,7 @@ JackWinNamedPipeClient* JackWinNamedPipeServer::AcceptClient()
 int JackWinNamedPipeServer::Close()
 {
     jack_log("JackWinNamedPipeServer::Close");
+    fReadPos = fReadSize = 0;
 
     if (fNamedPipe != INVALID_HANDLE_VALUE) {
         DisconnectNamedPipe(fNamedPipe);
@@ -38,15 +38,19 @@ class JackWinNamedPipeAux
 
         HANDLE fNamedPipe;
         char fName[256];
+        // Pipes are in message mode : a frame is received with a single ReadFile, then read field by field
+        char fReadBuffer[JACK_SOCKET_BUFFER_SIZE];
+        int fReadPos;
+        int fReadSize;
 
         int ReadAux(void* data, int len);
         int WriteAux(void* data, int len);
 
     public:
 
-        JackWinNamedPipeAux(): fNamedPipe(INVALID_HANDLE_VALUE)
+        JackWinNamedPipeAux(): fNamedPipe(INVALID_HANDLE_VALUE), fReadPos(0), fReadSize(0)
         {}
-        JackWinNamedPipeAux(HANDLE pipe): fNamedPipe(pipe)
+        JackWinNamedPipeAux(HANDLE pipe): fNamedPipe(pipe), fReadPos(0), fReadSize(0)
         {}
         virtual ~JackWinNamedPipeAux()
         {}
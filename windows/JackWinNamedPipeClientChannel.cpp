@@ -136,7 +136,9 @@ bool JackWinNamedPipeClientChannel::Execute()
     JackClientNotification event;
     JackResult res;
 
-    if (event.Read(&fNotificationListenPipe) < 0) {
+    detail::JackFramedTransaction frame(&fNotificationListenPipe);
+
+    if (event.Read(&frame) < 0) {
         jack_error("JackWinNamedPipeClientChannel read fail");
         goto error;
     }
@@ -144,7 +146,7 @@ bool JackWinNamedPipeClientChannel::Execute()
     res.fResult = fClient->ClientNotify(event.fRefNum, event.fName, event.fNotify, event.fSync, event.fMessage, event.fValue1, event.fValue2);
 
     if (event.fSync) {
-        if (res.Write(&fNotificationListenPipe) < 0) {
+        if (res.Write(&frame) < 0 || frame.Flush() < 0) {
             jack_error("JackWinNamedPipeClientChannel write fail");
             goto error;
         }
@@ -52,8 +52,10 @@ void JackWinNamedPipeNotifyChannel::ClientNotify(int refnum, const char* name, i
     JackClientNotification event(name, refnum, notify, sync, message, value1, value2);
     JackResult res;
 
+    detail::JackFramedTransaction frame(&fNotifyPipe);
+
     // Send notification
-    if (event.Write(&fNotifyPipe) < 0) {
+    if (event.Write(&frame) < 0 || frame.Flush() < 0) {
         jack_error("Could not write notification");
         *result = -1;
         return;
@@ -62,7 +64,7 @@ void JackWinNamedPipeNotifyChannel::ClientNotify(int refnum, const char* name, i
     // Read the result in "synchronous" mode only
     if (sync) {
         // Get result : use a time out
-        if (res.Read(&fNotifyPipe) < 0) {
+        if (res.Read(&frame) < 0) {
             jack_error("Could not read result");
             *result = -1;
         } else {
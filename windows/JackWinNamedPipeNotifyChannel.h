@@ -46,6 +46,12 @@ class JackWinNamedPipeNotifyChannel
         void Close();					// Close the Server/Client connection
 
         void ClientNotify(int refnum, const char* name, int notify, int sync, const char* message, int value1, int value2, int* result);
+
+        // Notifications are sent one by one
+        void BatchStart()
+        {}
+        void BatchStop()
+        {}
 };
 
 } // end of namespace
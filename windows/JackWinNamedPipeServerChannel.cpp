@@ -83,8 +83,9 @@ bool JackClientPipeThread::Execute()
     try {
 
         jack_log("JackClientPipeThread::Execute %x", this);
+        detail::JackFramedTransaction frame(fPipe);
         JackRequest header;
-        int res = header.Read(fPipe);
+        int res = header.Read(&frame);
         bool ret = true;
 
         // Lock the global mutex
@@ -98,8 +99,10 @@ bool JackClientPipeThread::Execute()
             ClientKill();
             ret = false;
         // Decode request
-        } else if (fDecoder->HandleRequest(fPipe, header.fType) < 0) {
+        } else if (fDecoder->HandleRequest(&frame, header.fType) < 0) {
             ret = false;
+        } else {
+            frame.Flush();
         }
 
         // Unlock the global mutex
@@ -118,7 +121,7 @@ void JackClientPipeThread::ClientAdd(detail::JackChannelTransactionInterface* so
 {
     jack_log("JackClientPipeThread::ClientAdd %x %s", this, req->fName);
     fRefNum = -1;
-    res->fResult = fServer->GetEngine()->ClientExternalOpen(req->fName, req->fPID, req->fUUID, &fRefNum, &res->fSharedEngine, &res->fSharedClient, &res->fSharedGraph);
+    res->fResult = fServer->GetEngine()->ClientExternalOpen(req->fName, req->GetNotifyName(), req->fPID, req->fUUID, &fRefNum, &res->fSharedEngine, &res->fSharedClient, &res->fSharedGraph);
 }
 
 void JackClientPipeThread::ClientRemove(detail::JackChannelTransactionInterface* socket_aux, int refnum)
@@ -50,7 +50,8 @@ A non blocking write operation should be used : check if write can succeed, and
 void JackWinNamedPipeServerNotifyChannel::Notify(int refnum, int notify, int value)
 {
     JackClientNotificationRequest req(refnum, notify, value);
-    if (req.Write(&fRequestPipe) < 0) {
+    detail::JackFramedTransaction frame(&fRequestPipe);
+    if (req.Write(&frame) < 0 || frame.Flush() < 0) {
         jack_error("Could not write notification ref = %d notify = %d", refnum, notify);
     }
 }
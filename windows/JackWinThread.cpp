@@ -239,6 +239,39 @@ int JackWinThread::DropRealTimeImp(jack_native_thread_t thread)
     }
 }
 
+int JackWinThread::AcquireSelfAffinity(const int* cpus, int count)
+{
+    return AcquireAffinityImp(GetCurrentThread(), cpus, count);
+}
+
+int JackWinThread::AcquireAffinityImp(jack_native_thread_t thread, const int* cpus, int count)
+{
+    DWORD_PTR mask = 0;
+    for (int i = 0; i < count; i++) {
+        if (cpus[i] >= 0 && cpus[i] < int(sizeof(DWORD_PTR) * 8)) {
+            mask |= (DWORD_PTR(1) << cpus[i]);
+        }
+    }
+
+    jack_log("JackWinThread::AcquireAffinityImp mask = %llx", (unsigned long long)mask);
+
+    if (mask == 0) {
+        jack_error("Cannot set CPU affinity: empty CPU set");
+        return -1;
+    } else if (SetThreadAffinityMask(thread, mask) == 0) {
+        jack_error("Cannot set CPU affinity = %d", GetLastError());
+        return -1;
+    } else {
+        return 0;
+    }
+}
+
+int JackWinThread::AcquireSelfDeadline(UInt64 runtime, UInt64 deadline, UInt64 period)
+{
+    jack_log("JackWinThread::AcquireSelfDeadline : deadline scheduling not supported");
+    return -1;
+}
+
 jack_native_thread_t JackWinThread::GetThreadID()
 {
     return fThread;
@@ -68,6 +68,9 @@ class SERVER_EXPORT JackWinThread : public JackMMCSS, public detail::JackThreadI
         int DropRealTime();                     // Used when called from another thread
         int DropSelfRealTime();                 // Used when called from thread itself
 
+        int AcquireSelfAffinity(const int* cpus, int count);    // Used when called from thread itself
+        int AcquireSelfDeadline(UInt64 runtime, UInt64 deadline, UInt64 period);  // Used when called from thread itself, in nanoseconds
+
         jack_native_thread_t GetThreadID();
         bool IsThread();
 
@@ -77,6 +80,7 @@ class SERVER_EXPORT JackWinThread : public JackMMCSS, public detail::JackThreadI
             return JackWinThread::AcquireRealTimeImp(thread, priority);
         }
         static int DropRealTimeImp(jack_native_thread_t thread);
+        static int AcquireAffinityImp(jack_native_thread_t thread, const int* cpus, int count);
         static int StartImp(jack_native_thread_t* thread, int priority, int realtime, void*(*start_routine)(void*), void* arg)
         {
             return JackWinThread::StartImp(thread, priority, realtime, (ThreadCallback) start_routine, arg);